@@ -2,25 +2,282 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include "Common/Crypto/AES.h"
+
+#include <cstring>
+
 #include <mbedtls/aes.h>
 
-#include "Common/Crypto/AES.h"
+#include "Common/Assert.h"
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
 
 namespace Common::AES
 {
-std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode)
+namespace
 {
-  mbedtls_aes_context aes_ctx;
-  std::vector<u8> buffer(size);
+constexpr size_t NUM_ROUNDS = 10;
+
+// CBC decryption doesn't depend on the output of the previous block, so several blocks can be in
+// flight at once to hide the latency of the AES instructions.
+constexpr size_t PARALLEL_BLOCKS = 8;
+
+// Decryption uses the round keys in reverse order, with InvMixColumns applied to all but the first
+// and last one (the "equivalent inverse cipher" of FIPS-197). Both AES-NI and ARMv8 expect this.
+
+#if defined(_M_X86)
+
+template <int Rcon>
+FUNCTION_TARGET_AES __m128i ExpandRoundKey(__m128i key)
+{
+  const __m128i assist = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, Rcon), 0xff);
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, assist);
+}
+
+FUNCTION_TARGET_AES void ExpandKeyHardware(const u8* key, Mode mode, u8* round_keys)
+{
+  __m128i keys[NUM_ROUNDS + 1];
+  keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+  keys[1] = ExpandRoundKey<0x01>(keys[0]);
+  keys[2] = ExpandRoundKey<0x02>(keys[1]);
+  keys[3] = ExpandRoundKey<0x04>(keys[2]);
+  keys[4] = ExpandRoundKey<0x08>(keys[3]);
+  keys[5] = ExpandRoundKey<0x10>(keys[4]);
+  keys[6] = ExpandRoundKey<0x20>(keys[5]);
+  keys[7] = ExpandRoundKey<0x40>(keys[6]);
+  keys[8] = ExpandRoundKey<0x80>(keys[7]);
+  keys[9] = ExpandRoundKey<0x1b>(keys[8]);
+  keys[10] = ExpandRoundKey<0x36>(keys[9]);
+
+  __m128i* out = reinterpret_cast<__m128i*>(round_keys);
+  for (size_t i = 0; i <= NUM_ROUNDS; ++i)
+  {
+    if (mode == Mode::Encrypt)
+      _mm_store_si128(&out[i], keys[i]);
+    else if (i == 0 || i == NUM_ROUNDS)
+      _mm_store_si128(&out[i], keys[NUM_ROUNDS - i]);
+    else
+      _mm_store_si128(&out[i], _mm_aesimc_si128(keys[NUM_ROUNDS - i]));
+  }
+}
+
+FUNCTION_TARGET_AES void EncryptHardware(const u8* round_keys, u8* iv, const u8* src, u8* dst,
+                                         size_t size)
+{
+  const __m128i* keys = reinterpret_cast<const __m128i*>(round_keys);
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+  for (size_t i = 0; i < size; i += BLOCK_SIZE)
+  {
+    block = _mm_xor_si128(block, _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+    block = _mm_xor_si128(block, keys[0]);
+    for (size_t round = 1; round < NUM_ROUNDS; ++round)
+      block = _mm_aesenc_si128(block, keys[round]);
+    block = _mm_aesenclast_si128(block, keys[NUM_ROUNDS]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), block);
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), block);
+}
+
+FUNCTION_TARGET_AES void DecryptHardware(const u8* round_keys, u8* iv, const u8* src, u8* dst,
+                                         size_t size)
+{
+  const __m128i* keys = reinterpret_cast<const __m128i*>(round_keys);
+  __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(iv));
+  size_t i = 0;
+  for (; i + PARALLEL_BLOCKS * BLOCK_SIZE <= size; i += PARALLEL_BLOCKS * BLOCK_SIZE)
+  {
+    __m128i in[PARALLEL_BLOCKS];
+    __m128i blocks[PARALLEL_BLOCKS];
+    for (size_t j = 0; j < PARALLEL_BLOCKS; ++j)
+    {
+      in[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + j * BLOCK_SIZE));
+      blocks[j] = _mm_xor_si128(in[j], keys[0]);
+    }
+    for (size_t round = 1; round < NUM_ROUNDS; ++round)
+    {
+      for (size_t j = 0; j < PARALLEL_BLOCKS; ++j)
+        blocks[j] = _mm_aesdec_si128(blocks[j], keys[round]);
+    }
+    for (size_t j = 0; j < PARALLEL_BLOCKS; ++j)
+    {
+      blocks[j] = _mm_aesdeclast_si128(blocks[j], keys[NUM_ROUNDS]);
+      blocks[j] = _mm_xor_si128(blocks[j], j == 0 ? previous : in[j - 1]);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + j * BLOCK_SIZE), blocks[j]);
+    }
+    previous = in[PARALLEL_BLOCKS - 1];
+  }
+  for (; i < size; i += BLOCK_SIZE)
+  {
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i block = _mm_xor_si128(in, keys[0]);
+    for (size_t round = 1; round < NUM_ROUNDS; ++round)
+      block = _mm_aesdec_si128(block, keys[round]);
+    block = _mm_aesdeclast_si128(block, keys[NUM_ROUNDS]);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(block, previous));
+    previous = in;
+  }
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(iv), previous);
+}
+
+#elif defined(_M_ARM_64)
+
+u32 SubWord(u32 word)
+{
+  // With the same word in every column, ShiftRows does nothing, so AESE with a zero round key is
+  // just SubBytes.
+  const uint8x16_t state = vreinterpretq_u8_u32(vdupq_n_u32(word));
+  return vgetq_lane_u32(vreinterpretq_u32_u8(vaeseq_u8(state, vdupq_n_u8(0))), 0);
+}
 
+void ExpandKeyHardware(const u8* key, Mode mode, u8* round_keys)
+{
+  u32 words[(NUM_ROUNDS + 1) * 4];
+  std::memcpy(words, key, KEY_SIZE);
+  u32 rcon = 1;
+  for (size_t i = 4; i < (NUM_ROUNDS + 1) * 4; ++i)
+  {
+    u32 temp = words[i - 1];
+    if (i % 4 == 0)
+    {
+      // RotWord, on a little endian word
+      temp = SubWord((temp >> 8) | (temp << 24)) ^ rcon;
+      rcon = (rcon << 1) ^ ((rcon & 0x80) ? 0x11b : 0);
+    }
+    words[i] = words[i - 4] ^ temp;
+  }
+
+  for (size_t i = 0; i <= NUM_ROUNDS; ++i)
+  {
+    const size_t source = mode == Mode::Encrypt ? i : NUM_ROUNDS - i;
+    uint8x16_t round_key = vreinterpretq_u8_u32(vld1q_u32(&words[source * 4]));
+    if (mode == Mode::Decrypt && i != 0 && i != NUM_ROUNDS)
+      round_key = vaesimcq_u8(round_key);
+    vst1q_u8(round_keys + i * BLOCK_SIZE, round_key);
+  }
+}
+
+void EncryptHardware(const u8* round_keys, u8* iv, const u8* src, u8* dst, size_t size)
+{
+  uint8x16_t keys[NUM_ROUNDS + 1];
+  for (size_t round = 0; round <= NUM_ROUNDS; ++round)
+    keys[round] = vld1q_u8(round_keys + round * BLOCK_SIZE);
+
+  uint8x16_t block = vld1q_u8(iv);
+  for (size_t i = 0; i < size; i += BLOCK_SIZE)
+  {
+    block = veorq_u8(block, vld1q_u8(src + i));
+    for (size_t round = 0; round < NUM_ROUNDS - 1; ++round)
+      block = vaesmcq_u8(vaeseq_u8(block, keys[round]));
+    block = veorq_u8(vaeseq_u8(block, keys[NUM_ROUNDS - 1]), keys[NUM_ROUNDS]);
+    vst1q_u8(dst + i, block);
+  }
+  vst1q_u8(iv, block);
+}
+
+void DecryptHardware(const u8* round_keys, u8* iv, const u8* src, u8* dst, size_t size)
+{
+  uint8x16_t keys[NUM_ROUNDS + 1];
+  for (size_t round = 0; round <= NUM_ROUNDS; ++round)
+    keys[round] = vld1q_u8(round_keys + round * BLOCK_SIZE);
+
+  uint8x16_t previous = vld1q_u8(iv);
+  size_t i = 0;
+  for (; i + PARALLEL_BLOCKS * BLOCK_SIZE <= size; i += PARALLEL_BLOCKS * BLOCK_SIZE)
+  {
+    uint8x16_t in[PARALLEL_BLOCKS];
+    uint8x16_t blocks[PARALLEL_BLOCKS];
+    for (size_t j = 0; j < PARALLEL_BLOCKS; ++j)
+      blocks[j] = in[j] = vld1q_u8(src + i + j * BLOCK_SIZE);
+    for (size_t round = 0; round < NUM_ROUNDS - 1; ++round)
+    {
+      for (size_t j = 0; j < PARALLEL_BLOCKS; ++j)
+        blocks[j] = vaesimcq_u8(vaesdq_u8(blocks[j], keys[round]));
+    }
+    for (size_t j = 0; j < PARALLEL_BLOCKS; ++j)
+    {
+      blocks[j] = veorq_u8(vaesdq_u8(blocks[j], keys[NUM_ROUNDS - 1]), keys[NUM_ROUNDS]);
+      blocks[j] = veorq_u8(blocks[j], j == 0 ? previous : in[j - 1]);
+      vst1q_u8(dst + i + j * BLOCK_SIZE, blocks[j]);
+    }
+    previous = in[PARALLEL_BLOCKS - 1];
+  }
+  for (; i < size; i += BLOCK_SIZE)
+  {
+    const uint8x16_t in = vld1q_u8(src + i);
+    uint8x16_t block = in;
+    for (size_t round = 0; round < NUM_ROUNDS - 1; ++round)
+      block = vaesimcq_u8(vaesdq_u8(block, keys[round]));
+    block = veorq_u8(vaesdq_u8(block, keys[NUM_ROUNDS - 1]), keys[NUM_ROUNDS]);
+    vst1q_u8(dst + i, veorq_u8(block, previous));
+    previous = in;
+  }
+  vst1q_u8(iv, previous);
+}
+
+#endif
+}  // Anonymous namespace
+
+Context::Context(const u8* key, Mode mode) : m_mode(mode)
+{
+#if defined(_M_X86) || defined(_M_ARM_64)
+  m_use_hardware = cpu_info.bAES;
+#else
+  m_use_hardware = false;
+#endif
+
+  if (m_use_hardware)
+  {
+#if defined(_M_X86) || defined(_M_ARM_64)
+    ExpandKeyHardware(key, mode, m_round_keys.data());
+#endif
+    return;
+  }
+
+  m_mbedtls_context = std::make_unique<mbedtls_aes_context>();
+  mbedtls_aes_init(m_mbedtls_context.get());
   if (mode == Mode::Encrypt)
-    mbedtls_aes_setkey_enc(&aes_ctx, key, 128);
+    mbedtls_aes_setkey_enc(m_mbedtls_context.get(), key, 128);
   else
-    mbedtls_aes_setkey_dec(&aes_ctx, key, 128);
+    mbedtls_aes_setkey_dec(m_mbedtls_context.get(), key, 128);
+}
 
-  mbedtls_aes_crypt_cbc(&aes_ctx, mode == Mode::Encrypt ? MBEDTLS_AES_ENCRYPT : MBEDTLS_AES_DECRYPT,
-                        size, iv, src, buffer.data());
+Context::~Context()
+{
+  if (m_mbedtls_context)
+    mbedtls_aes_free(m_mbedtls_context.get());
+}
+
+void Context::Crypt(u8* iv, const u8* src, u8* dst, size_t size) const
+{
+  DEBUG_ASSERT(size % BLOCK_SIZE == 0);
 
+  if (m_use_hardware)
+  {
+#if defined(_M_X86) || defined(_M_ARM_64)
+    if (m_mode == Mode::Encrypt)
+      EncryptHardware(m_round_keys.data(), iv, src, dst, size);
+    else
+      DecryptHardware(m_round_keys.data(), iv, src, dst, size);
+#endif
+    return;
+  }
+
+  mbedtls_aes_crypt_cbc(m_mbedtls_context.get(),
+                        m_mode == Mode::Encrypt ? MBEDTLS_AES_ENCRYPT : MBEDTLS_AES_DECRYPT, size,
+                        iv, src, dst);
+}
+
+std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode)
+{
+  std::vector<u8> buffer(size);
+  Context(key, mode).Crypt(iv, src, buffer.data(), size);
   return buffer;
 }
 
@@ -4,11 +4,15 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <memory>
 #include <vector>
 
 #include "Common/CommonTypes.h"
 
+struct mbedtls_aes_context;
+
 namespace Common::AES
 {
 enum class Mode
@@ -16,6 +20,33 @@ enum class Mode
   Decrypt,
   Encrypt,
 };
+
+constexpr size_t KEY_SIZE = 16;
+constexpr size_t BLOCK_SIZE = 16;
+
+// AES-128-CBC with a key that is expanded once and then reused for any number of calls. AES-NI or
+// the ARMv8 Crypto Extensions are used when the CPU supports them.
+class Context
+{
+public:
+  Context(const u8* key, Mode mode);
+  ~Context();
+
+  Context(const Context&) = delete;
+  Context& operator=(const Context&) = delete;
+
+  // Processes size bytes, which must be a multiple of BLOCK_SIZE, from src to dst. src and dst may
+  // point to the same buffer. Like mbedtls, iv is updated so that a following call continues where
+  // this one stopped. A context can be used by several threads at once.
+  void Crypt(u8* iv, const u8* src, u8* dst, size_t size) const;
+
+private:
+  Mode m_mode;
+  bool m_use_hardware;
+  alignas(16) std::array<u8, 11 * BLOCK_SIZE> m_round_keys;
+  std::unique_ptr<mbedtls_aes_context> m_mbedtls_context;
+};
+
 std::vector<u8> DecryptEncrypt(const u8* key, u8* iv, const u8* src, size_t size, Mode mode);
 
 // Convenience functions
@@ -0,0 +1,216 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/Crypto/SHA1.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <mbedtls/sha1.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/Intrinsics.h"
+#include "Common/Swap.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
+namespace Common::SHA1
+{
+namespace
+{
+using ProcessBlocksFunction = void (*)(u32* state, const u8* data, size_t num_blocks);
+
+void ProcessBlocksGeneric(u32* state, const u8* data, size_t num_blocks)
+{
+  mbedtls_sha1_context context;
+  mbedtls_sha1_init(&context);
+  std::copy_n(state, 5, context.state);
+  for (size_t i = 0; i < num_blocks; ++i)
+    mbedtls_internal_sha1_process(&context, data + i * 64);
+  std::copy_n(context.state, 5, state);
+  mbedtls_sha1_free(&context);
+}
+
+// Both implementations below work on groups of four rounds. The message schedule is kept in a ring
+// of four vectors, each holding the words for one group.
+
+#if defined(_M_X86)
+
+template <int Function>
+FUNCTION_TARGET_SHA void RoundsSHANI(__m128i* abcd, __m128i* e, __m128i* previous, __m128i* w)
+{
+  for (int group = Function * 5; group < Function * 5 + 5; ++group)
+  {
+    *previous = *abcd;
+    *abcd = _mm_sha1rnds4_epu32(*abcd, *e, Function);
+    if (group < 16)
+    {
+      __m128i temp = _mm_sha1msg1_epu32(w[group % 4], w[(group + 1) % 4]);
+      temp = _mm_xor_si128(temp, w[(group + 2) % 4]);
+      w[group % 4] = _mm_sha1msg2_epu32(temp, w[(group + 3) % 4]);
+    }
+    if (group < 19)
+      *e = _mm_sha1nexte_epu32(*previous, w[(group + 1) % 4]);
+  }
+}
+
+FUNCTION_TARGET_SHA void ProcessBlocksHardware(u32* state, const u8* data, size_t num_blocks)
+{
+  // The SHA instructions want A (and E) in the highest lane and the message words big endian.
+  const __m128i byte_swap = _mm_set_epi64x(0x0001020304050607, 0x08090a0b0c0d0e0f);
+  __m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state));
+  abcd = _mm_shuffle_epi32(abcd, 0x1b);
+  __m128i e0 = _mm_set_epi32(state[4], 0, 0, 0);
+
+  for (; num_blocks > 0; --num_blocks, data += 64)
+  {
+    __m128i w[4];
+    for (size_t i = 0; i < 4; ++i)
+    {
+      const __m128i msg = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+      w[i] = _mm_shuffle_epi8(msg, byte_swap);
+    }
+
+    const __m128i abcd_save = abcd;
+    __m128i e = _mm_add_epi32(e0, w[0]);
+    __m128i previous;
+    RoundsSHANI<0>(&abcd, &e, &previous, w);
+    RoundsSHANI<1>(&abcd, &e, &previous, w);
+    RoundsSHANI<2>(&abcd, &e, &previous, w);
+    RoundsSHANI<3>(&abcd, &e, &previous, w);
+    e0 = _mm_sha1nexte_epu32(previous, e0);
+    abcd = _mm_add_epi32(abcd, abcd_save);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32(abcd, 0x1b));
+  state[4] = _mm_extract_epi32(e0, 3);
+}
+
+bool HasHardwareSupport()
+{
+  return cpu_info.bSHA1 && cpu_info.bSSE4_1;
+}
+
+#elif defined(_M_ARM_64)
+
+void ProcessBlocksHardware(u32* state, const u8* data, size_t num_blocks)
+{
+  constexpr u32 K[4] = {0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6};
+  uint32x4_t abcd = vld1q_u32(state);
+  u32 e = state[4];
+
+  for (; num_blocks > 0; --num_blocks, data += 64)
+  {
+    uint32x4_t w[4];
+    for (size_t i = 0; i < 4; ++i)
+      w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+
+    const uint32x4_t abcd_save = abcd;
+    const u32 e_save = e;
+    for (size_t group = 0; group < 20; ++group)
+    {
+      const uint32x4_t wk = vaddq_u32(w[group % 4], vdupq_n_u32(K[group / 5]));
+      const u32 next_e = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+      if (group < 5)
+        abcd = vsha1cq_u32(abcd, e, wk);
+      else if (group >= 10 && group < 15)
+        abcd = vsha1mq_u32(abcd, e, wk);
+      else
+        abcd = vsha1pq_u32(abcd, e, wk);
+      e = next_e;
+
+      if (group < 16)
+      {
+        const uint32x4_t temp = vsha1su0q_u32(w[group % 4], w[(group + 1) % 4], w[(group + 2) % 4]);
+        w[group % 4] = vsha1su1q_u32(temp, w[(group + 3) % 4]);
+      }
+    }
+    abcd = vaddq_u32(abcd, abcd_save);
+    e += e_save;
+  }
+
+  vst1q_u32(state, abcd);
+  state[4] = e;
+}
+
+bool HasHardwareSupport()
+{
+  return cpu_info.bSHA1;
+}
+
+#endif
+
+ProcessBlocksFunction GetProcessBlocksFunction()
+{
+#if defined(_M_X86) || defined(_M_ARM_64)
+  static const ProcessBlocksFunction function =
+      HasHardwareSupport() ? ProcessBlocksHardware : ProcessBlocksGeneric;
+  return function;
+#else
+  return ProcessBlocksGeneric;
+#endif
+}
+}  // Anonymous namespace
+
+Context::Context()
+    : m_process_blocks(GetProcessBlocksFunction()),
+      m_state{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0}
+{
+}
+
+void Context::Update(const u8* msg, size_t len)
+{
+  m_length += len;
+
+  if (m_buffer_size != 0)
+  {
+    const size_t to_copy = std::min(BLOCK_SIZE - m_buffer_size, len);
+    std::memcpy(m_buffer.data() + m_buffer_size, msg, to_copy);
+    m_buffer_size += to_copy;
+    msg += to_copy;
+    len -= to_copy;
+    if (m_buffer_size < BLOCK_SIZE)
+      return;
+
+    m_process_blocks(m_state.data(), m_buffer.data(), 1);
+    m_buffer_size = 0;
+  }
+
+  const size_t num_blocks = len / BLOCK_SIZE;
+  if (num_blocks != 0)
+    m_process_blocks(m_state.data(), msg, num_blocks);
+
+  m_buffer_size = len % BLOCK_SIZE;
+  std::memcpy(m_buffer.data(), msg + num_blocks * BLOCK_SIZE, m_buffer_size);
+}
+
+Digest Context::Finish()
+{
+  const u64 bit_length = Common::swap64(m_length * 8);
+
+  // A single 1 bit, zeroes up to 8 bytes before the end of a block, then the message length.
+  constexpr u8 padding[BLOCK_SIZE] = {0x80};
+  const size_t padding_size = (m_buffer_size < BLOCK_SIZE - 8 ? BLOCK_SIZE : BLOCK_SIZE * 2) -
+                              8 - m_buffer_size;
+  Update(padding, padding_size);
+  Update(reinterpret_cast<const u8*>(&bit_length), sizeof(bit_length));
+
+  Digest digest;
+  for (size_t i = 0; i < m_state.size(); ++i)
+  {
+    const u32 word = Common::swap32(m_state[i]);
+    std::memcpy(digest.data() + i * sizeof(u32), &word, sizeof(u32));
+  }
+  return digest;
+}
+
+Digest CalculateDigest(const u8* msg, size_t len)
+{
+  Context context;
+  context.Update(msg, len);
+  return context.Finish();
+}
+}  // namespace Common::SHA1
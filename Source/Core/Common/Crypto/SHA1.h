@@ -0,0 +1,38 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+namespace Common::SHA1
+{
+constexpr size_t DIGEST_LEN = 20;
+using Digest = std::array<u8, DIGEST_LEN>;
+
+// Incremental SHA-1 that doesn't allocate. The SHA extensions on x86 or the ARMv8 Crypto
+// Extensions are used when the CPU supports them.
+class Context
+{
+public:
+  Context();
+
+  void Update(const u8* msg, size_t len);
+  Digest Finish();
+
+private:
+  static constexpr size_t BLOCK_SIZE = 64;
+
+  void (*m_process_blocks)(u32* state, const u8* data, size_t num_blocks);
+  std::array<u32, 5> m_state;
+  std::array<u8, BLOCK_SIZE> m_buffer;
+  size_t m_buffer_size = 0;
+  u64 m_length = 0;
+};
+
+Digest CalculateDigest(const u8* msg, size_t len);
+}  // namespace Common::SHA1
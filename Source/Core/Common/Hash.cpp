@@ -6,12 +6,17 @@
 
 #include <algorithm>
 #include <cstring>
+
+#include <zlib.h>
+
 #include "Common/BitUtils.h"
 #include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
 #include "Common/Intrinsics.h"
+#include "Common/Swap.h"
 
 #ifdef _M_ARM_64
+#include <arm_neon.h>
 #ifdef _MSC_VER
 #include <intrin.h>
 #else
@@ -108,6 +113,99 @@ u32 HashEctor(const u8* ptr, size_t length)
   return (crc);
 }
 
+#if defined(_M_X86)
+// Multiplies both halves of x by the matching constant in k and adds the next 16 bytes.
+FUNCTION_TARGET_PCLMUL
+static __m128i FoldCRC32(__m128i x, __m128i k, __m128i next)
+{
+  const __m128i low = _mm_clmulepi64_si128(x, k, 0x00);
+  const __m128i high = _mm_clmulepi64_si128(x, k, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(low, high), next);
+}
+
+// Folds 64 bytes at a time with carry-less multiplication and then reduces the result, as in
+// Intel's "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction". Works on the
+// inverted CRC. len must be a multiple of 16 and at least 64.
+FUNCTION_TARGET_PCLMUL
+static u32 UpdateCRC32PCLMUL(u32 crc, const u8* data, size_t len)
+{
+  const __m128i k1k2 = _mm_set_epi64x(0x01c6e41596, 0x0154442bd4);
+  const __m128i k3k4 = _mm_set_epi64x(0x00ccaa009e, 0x01751997d0);
+  const __m128i k5k0 = _mm_set_epi64x(0, 0x0163cd6124);
+  const __m128i poly = _mm_set_epi64x(0x01f7011641, 0x01db710641);
+  const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  const __m128i* ptr = reinterpret_cast<const __m128i*>(data);
+
+  __m128i x[4];
+  for (size_t i = 0; i < 4; ++i)
+    x[i] = _mm_loadu_si128(ptr + i);
+  x[0] = _mm_xor_si128(x[0], _mm_cvtsi32_si128(static_cast<int>(crc)));
+  ptr += 4;
+  len -= 64;
+
+  for (; len >= 64; ptr += 4, len -= 64)
+  {
+    for (size_t i = 0; i < 4; ++i)
+      x[i] = FoldCRC32(x[i], k1k2, _mm_loadu_si128(ptr + i));
+  }
+
+  // Fold the four lanes into one, then fold in any remaining 16 byte blocks
+  __m128i folded = x[0];
+  for (size_t i = 1; i < 4; ++i)
+    folded = FoldCRC32(folded, k3k4, x[i]);
+  for (; len >= 16; ++ptr, len -= 16)
+    folded = FoldCRC32(folded, k3k4, _mm_loadu_si128(ptr));
+
+  // 128 bits to 64 bits
+  folded = _mm_xor_si128(_mm_srli_si128(folded, 8), _mm_clmulepi64_si128(folded, k3k4, 0x10));
+  const __m128i upper = _mm_srli_si128(folded, 4);
+  folded = _mm_clmulepi64_si128(_mm_and_si128(folded, mask), k5k0, 0x00);
+  folded = _mm_xor_si128(folded, upper);
+
+  // Barrett reduction to 32 bits
+  __m128i temp = _mm_clmulepi64_si128(_mm_and_si128(folded, mask), poly, 0x10);
+  temp = _mm_clmulepi64_si128(_mm_and_si128(temp, mask), poly, 0x00);
+  return static_cast<u32>(_mm_extract_epi32(_mm_xor_si128(folded, temp), 1));
+}
+#endif
+
+u32 UpdateCRC32(u32 crc, const u8* data, size_t len)
+{
+#if defined(_M_X86)
+  if (cpu_info.bPCLMULQDQ && len >= 64)
+  {
+    const size_t simd_len = len & ~size_t(15);
+    crc = ~UpdateCRC32PCLMUL(~crc, data, simd_len);
+    data += simd_len;
+    len -= simd_len;
+  }
+#elif defined(_M_ARM_64)
+  if (cpu_info.bCRC32)
+  {
+    crc = ~crc;
+    for (; len >= sizeof(u64); data += sizeof(u64), len -= sizeof(u64))
+    {
+      u64 value;
+      std::memcpy(&value, data, sizeof(u64));
+      crc = __crc32d(crc, value);
+    }
+    for (; len > 0; ++data, --len)
+      crc = __crc32b(crc, *data);
+    return ~crc;
+  }
+#endif
+
+  // zlib's crc32 takes the length as an unsigned int. (crc32_z isn't available on Android.)
+  while (len > 0)
+  {
+    const unsigned int chunk_len = static_cast<unsigned int>(std::min<size_t>(len, 0x40000000));
+    crc = static_cast<u32>(crc32(crc, data, chunk_len));
+    data += chunk_len;
+    len -= chunk_len;
+  }
+  return crc;
+}
+
 #if _ARCH_64
 
 //-----------------------------------------------------------------------------
@@ -505,29 +603,424 @@ static u64 GetMurmurHash3(const u8* src, u32 len, u32 samples)
 }
 #endif
 
-u64 GetHash64(const u8* src, u32 len, u32 samples)
+//-----------------------------------------------------------------------------
+// XXH3 from xxHash (64-bit, default secret, no seed). Long inputs are split into 64 byte stripes,
+// which are accumulated into eight 64-bit lanes with vector instructions where possible. When
+// samples is nonzero, only that many evenly spaced stripes are accumulated, so the result only
+// matches the reference implementation for full hashes.
+
+namespace
 {
-  return ptrHashFunction(src, len, samples);
+constexpr u32 XXH3_STRIPE_LEN = 64;
+constexpr u32 XXH3_SECRET_SIZE = 192;
+constexpr u32 XXH3_STRIPES_PER_BLOCK = (XXH3_SECRET_SIZE - XXH3_STRIPE_LEN) / 8;
+constexpr u32 XXH3_MIDSIZE_MAX = 240;
+
+constexpr u32 XXH_PRIME32_1 = 0x9E3779B1;
+constexpr u32 XXH_PRIME32_2 = 0x85EBCA77;
+constexpr u32 XXH_PRIME32_3 = 0xC2B2AE3D;
+constexpr u64 XXH_PRIME64_1 = 0x9E3779B185EBCA87;
+constexpr u64 XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4F;
+constexpr u64 XXH_PRIME64_3 = 0x165667B19E3779F9;
+constexpr u64 XXH_PRIME64_4 = 0x85EBCA77C2B2AE63;
+constexpr u64 XXH_PRIME64_5 = 0x27D4EB2F165667C5;
+
+alignas(64) constexpr u8 XXH3_SECRET[XXH3_SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+u32 Read32(const u8* p)
+{
+  u32 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
 }
 
-// sets the hash function used for the texture cache
-void SetHash64Function()
+u64 Read64(const u8* p)
 {
-#if defined(_M_X86_64) || defined(_M_X86)
-  if (cpu_info.bSSE4_2)  // sse crc32 version
+  u64 value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+// Multiplies to 128 bits and folds the upper half into the lower half.
+u64 Mul128Fold64(u64 lhs, u64 rhs)
+{
+#if defined(_MSC_VER) && defined(_M_X86_64)
+  u64 high;
+  const u64 low = _umul128(lhs, rhs, &high);
+  return low ^ high;
+#elif defined(_MSC_VER) && defined(_M_ARM_64)
+  return (lhs * rhs) ^ __umulh(lhs, rhs);
+#elif defined(__SIZEOF_INT128__)
+  const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+  return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#else
+  const u64 lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+  const u64 hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+  const u64 lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+  const u64 hi_hi = (lhs >> 32) * (rhs >> 32);
+  const u64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+  const u64 high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+  const u64 low = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+  return low ^ high;
+#endif
+}
+
+u64 XXH64Avalanche(u64 h)
+{
+  h ^= h >> 33;
+  h *= XXH_PRIME64_2;
+  h ^= h >> 29;
+  h *= XXH_PRIME64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+u64 XXH3Avalanche(u64 h)
+{
+  h ^= h >> 37;
+  h *= 0x165667919E3779F9;
+  h ^= h >> 32;
+  return h;
+}
+
+u64 XXH3Len0To16(const u8* src, u32 len)
+{
+  const u8* secret = XXH3_SECRET;
+  if (len > 8)
+  {
+    const u64 input_lo = Read64(src) ^ Read64(secret + 24) ^ Read64(secret + 32);
+    const u64 input_hi = Read64(src + len - 8) ^ Read64(secret + 40) ^ Read64(secret + 48);
+    return XXH3Avalanche(len + Common::swap64(input_lo) + input_hi +
+                         Mul128Fold64(input_lo, input_hi));
+  }
+  if (len >= 4)
+  {
+    const u64 input = Read32(src + len - 4) + (u64{Read32(src)} << 32);
+    u64 h = input ^ Read64(secret + 8) ^ Read64(secret + 16);
+    h ^= Common::RotateLeft(h, 49) ^ Common::RotateLeft(h, 24);
+    h *= 0x9FB21C651E98DF25;
+    h ^= (h >> 35) + len;
+    h *= 0x9FB21C651E98DF25;
+    return h ^ (h >> 28);
+  }
+  if (len > 0)
+  {
+    const u32 combined = (u32{src[0]} << 16) | (u32{src[len >> 1]} << 24) | src[len - 1] |
+                         (len << 8);
+    return XXH64Avalanche(combined ^ (Read32(secret) ^ Read32(secret + 4)));
+  }
+  return XXH64Avalanche(Read64(secret + 56) ^ Read64(secret + 64));
+}
+
+u64 XXH3Mix16(const u8* src, const u8* secret)
+{
+  return Mul128Fold64(Read64(src) ^ Read64(secret), Read64(src + 8) ^ Read64(secret + 8));
+}
+
+u64 XXH3Len17To128(const u8* src, u32 len)
+{
+  const u8* secret = XXH3_SECRET;
+  u64 acc = len * XXH_PRIME64_1;
+  for (u32 i = 0; i <= (len - 1) / 32; i++)
+  {
+    acc += XXH3Mix16(src + 16 * i, secret + 32 * i);
+    acc += XXH3Mix16(src + len - 16 * (i + 1), secret + 32 * i + 16);
+  }
+  return XXH3Avalanche(acc);
+}
+
+u64 XXH3Len129To240(const u8* src, u32 len)
+{
+  const u8* secret = XXH3_SECRET;
+  u64 acc = len * XXH_PRIME64_1;
+  for (u32 i = 0; i < 8; i++)
+    acc += XXH3Mix16(src + 16 * i, secret + 16 * i);
+  acc = XXH3Avalanche(acc);
+
+  u64 acc_end = XXH3Mix16(src + len - 16, secret + 136 - 17);
+  for (u32 i = 8; i < len / 16; i++)
+    acc_end += XXH3Mix16(src + 16 * i, secret + 16 * (i - 8) + 3);
+  return XXH3Avalanche(acc + acc_end);
+}
+
+// Accumulates nb_stripes stripes that are stride bytes apart, each with the secret advanced by
+// another 8 bytes.
+using XXH3AccumulateFunction = void (*)(u64* acc, const u8* src, const u8* secret,
+                                        u32 nb_stripes, size_t stride);
+using XXH3ScrambleFunction = void (*)(u64* acc, const u8* secret);
+
+[[maybe_unused]] void XXH3AccumulateGeneric(u64* acc, const u8* src, const u8* secret,
+                                            u32 nb_stripes, size_t stride)
+{
+  for (u32 n = 0; n < nb_stripes; n++)
+  {
+    const u8* stripe = src + n * stride;
+    const u8* key = secret + n * 8;
+    for (u32 i = 0; i < 8; i++)
+    {
+      const u64 data = Read64(stripe + i * 8);
+      const u64 data_key = data ^ Read64(key + i * 8);
+      acc[i ^ 1] += data;
+      acc[i] += (data_key & 0xFFFFFFFF) * (data_key >> 32);
+    }
+  }
+}
+
+[[maybe_unused]] void XXH3ScrambleGeneric(u64* acc, const u8* secret)
+{
+  for (u32 i = 0; i < 8; i++)
+  {
+    u64 a = acc[i];
+    a ^= a >> 47;
+    a ^= Read64(secret + i * 8);
+    acc[i] = a * XXH_PRIME32_1;
+  }
+}
+
+#if defined(_M_X86)
+
+void XXH3AccumulateSSE2(u64* acc, const u8* src, const u8* secret, u32 nb_stripes, size_t stride)
+{
+  __m128i a[4];
+  for (int i = 0; i < 4; i++)
+    a[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(acc) + i);
+
+  for (u32 n = 0; n < nb_stripes; n++)
+  {
+    const __m128i* stripe = reinterpret_cast<const __m128i*>(src + n * stride);
+    const __m128i* key = reinterpret_cast<const __m128i*>(secret + n * 8);
+    for (int i = 0; i < 4; i++)
+    {
+      const __m128i data = _mm_loadu_si128(stripe + i);
+      const __m128i data_key = _mm_xor_si128(data, _mm_loadu_si128(key + i));
+      const __m128i product =
+          _mm_mul_epu32(data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+      a[i] = _mm_add_epi64(a[i], _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+      a[i] = _mm_add_epi64(a[i], product);
+    }
+  }
+
+  for (int i = 0; i < 4; i++)
+    _mm_store_si128(reinterpret_cast<__m128i*>(acc) + i, a[i]);
+}
+
+void XXH3ScrambleSSE2(u64* acc, const u8* secret)
+{
+  const __m128i prime = _mm_set1_epi32(static_cast<int>(XXH_PRIME32_1));
+  for (int i = 0; i < 4; i++)
+  {
+    __m128i a = _mm_load_si128(reinterpret_cast<const __m128i*>(acc) + i);
+    a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+    a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+    const __m128i product_lo = _mm_mul_epu32(a, prime);
+    const __m128i product_hi =
+        _mm_mul_epu32(_mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+    a = _mm_add_epi64(product_lo, _mm_slli_epi64(product_hi, 32));
+    _mm_store_si128(reinterpret_cast<__m128i*>(acc) + i, a);
+  }
+}
+
+FUNCTION_TARGET_AVX2
+void XXH3AccumulateAVX2(u64* acc, const u8* src, const u8* secret, u32 nb_stripes, size_t stride)
+{
+  __m256i a[2];
+  for (int i = 0; i < 2; i++)
+    a[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc) + i);
+
+  for (u32 n = 0; n < nb_stripes; n++)
   {
-    ptrHashFunction = &GetCRC32;
+    const __m256i* stripe = reinterpret_cast<const __m256i*>(src + n * stride);
+    const __m256i* key = reinterpret_cast<const __m256i*>(secret + n * 8);
+    for (int i = 0; i < 2; i++)
+    {
+      const __m256i data = _mm256_loadu_si256(stripe + i);
+      const __m256i data_key = _mm256_xor_si256(data, _mm256_loadu_si256(key + i));
+      const __m256i product =
+          _mm256_mul_epu32(data_key, _mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+      a[i] = _mm256_add_epi64(a[i], _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+      a[i] = _mm256_add_epi64(a[i], product);
+    }
+  }
+
+  for (int i = 0; i < 2; i++)
+    _mm256_store_si256(reinterpret_cast<__m256i*>(acc) + i, a[i]);
+}
+
+FUNCTION_TARGET_AVX2
+void XXH3ScrambleAVX2(u64* acc, const u8* secret)
+{
+  const __m256i prime = _mm256_set1_epi32(static_cast<int>(XXH_PRIME32_1));
+  for (int i = 0; i < 2; i++)
+  {
+    __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc) + i);
+    a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+    a = _mm256_xor_si256(a, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+    const __m256i product_lo = _mm256_mul_epu32(a, prime);
+    const __m256i product_hi =
+        _mm256_mul_epu32(_mm256_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+    a = _mm256_add_epi64(product_lo, _mm256_slli_epi64(product_hi, 32));
+    _mm256_store_si256(reinterpret_cast<__m256i*>(acc) + i, a);
   }
-  else
+}
+
 #elif defined(_M_ARM_64)
-  if (cpu_info.bCRC32)
+
+void XXH3AccumulateNEON(u64* acc, const u8* src, const u8* secret, u32 nb_stripes, size_t stride)
+{
+  uint64x2_t a[4];
+  for (int i = 0; i < 4; i++)
+    a[i] = vld1q_u64(acc + i * 2);
+
+  for (u32 n = 0; n < nb_stripes; n++)
+  {
+    const u8* stripe = src + n * stride;
+    const u8* key = secret + n * 8;
+    for (int i = 0; i < 4; i++)
+    {
+      const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(stripe + i * 16));
+      const uint64x2_t data_key = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(key + i * 16)));
+      a[i] = vaddq_u64(a[i], vextq_u64(data, data, 1));
+      a[i] = vmlal_u32(a[i], vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+    }
+  }
+
+  for (int i = 0; i < 4; i++)
+    vst1q_u64(acc + i * 2, a[i]);
+}
+
+void XXH3ScrambleNEON(u64* acc, const u8* secret)
+{
+  const uint32x2_t prime = vdup_n_u32(XXH_PRIME32_1);
+  for (int i = 0; i < 4; i++)
   {
-    ptrHashFunction = &GetCRC32;
+    uint64x2_t a = vld1q_u64(acc + i * 2);
+    a = veorq_u64(a, vshrq_n_u64(a, 47));
+    a = veorq_u64(a, vreinterpretq_u64_u8(vld1q_u8(secret + i * 16)));
+    const uint64x2_t product_hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(a, 32), prime), 32);
+    vst1q_u64(acc + i * 2, vmlal_u32(product_hi, vmovn_u64(a), prime));
   }
-  else
+}
+
 #endif
+
+template <XXH3AccumulateFunction Accumulate, XXH3ScrambleFunction Scramble>
+u64 XXH3HashLong(const u8* src, u32 len, size_t stride)
+{
+  const u8* secret = XXH3_SECRET;
+  alignas(32) u64 acc[8] = {XXH_PRIME32_3, XXH_PRIME64_1, XXH_PRIME64_2, XXH_PRIME64_3,
+                            XXH_PRIME64_4, XXH_PRIME32_2, XXH_PRIME64_5, XXH_PRIME32_1};
+
+  // The last stripe is always accumulated separately, even if it overlaps the previous one.
+  const u32 nb_stripes = static_cast<u32>((len - 1) / stride);
+  const u32 nb_blocks = nb_stripes / XXH3_STRIPES_PER_BLOCK;
+  const size_t block_len = stride * XXH3_STRIPES_PER_BLOCK;
+  for (u32 n = 0; n < nb_blocks; n++)
+  {
+    Accumulate(acc, src + n * block_len, secret, XXH3_STRIPES_PER_BLOCK, stride);
+    Scramble(acc, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+  }
+  Accumulate(acc, src + nb_blocks * block_len, secret,
+             nb_stripes - nb_blocks * XXH3_STRIPES_PER_BLOCK, stride);
+  Accumulate(acc, src + len - XXH3_STRIPE_LEN, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - 7, 1,
+             stride);
+
+  u64 result = len * XXH_PRIME64_1;
+  for (u32 i = 0; i < 4; i++)
   {
+    result += Mul128Fold64(acc[i * 2] ^ Read64(secret + 11 + i * 16),
+                           acc[i * 2 + 1] ^ Read64(secret + 11 + i * 16 + 8));
+  }
+  return XXH3Avalanche(result);
+}
+
+template <XXH3AccumulateFunction Accumulate, XXH3ScrambleFunction Scramble>
+u64 GetXXH3(const u8* src, u32 len, u32 samples)
+{
+  if (len <= 16)
+    return XXH3Len0To16(src, len);
+  if (len <= 128)
+    return XXH3Len17To128(src, len);
+  if (len <= XXH3_MIDSIZE_MAX)
+    return XXH3Len129To240(src, len);
+
+  // The other functions sample 8 bytes at a time, so this hashes about as much data.
+  size_t stride = XXH3_STRIPE_LEN;
+  const u32 total_stripes = len / XXH3_STRIPE_LEN;
+  const u32 sampled_stripes = std::max(samples / (XXH3_STRIPE_LEN / 8), 1u);
+  if (samples != 0 && sampled_stripes < total_stripes)
+    stride *= total_stripes / sampled_stripes;
+  return XXH3HashLong<Accumulate, Scramble>(src, len, stride);
+}
+}  // namespace
+
+u64 GetHash64(const u8* src, u32 len, u32 samples)
+{
+  return ptrHashFunction(src, len, samples);
+}
+
+// sets the hash function used for the texture cache
+void SetHash64Function(HashFunction function)
+{
+  if (function == HashFunction::Default)
+  {
+    // XXH3 is faster than CRC32 with AVX2, but not with SSE2 alone.
+#if defined(_M_X86)
+    function = cpu_info.bSSE4_2 && !cpu_info.bAVX2 ? HashFunction::CRC32 : HashFunction::XXH3;
+#elif defined(_M_ARM_64)
+    function = cpu_info.bCRC32 ? HashFunction::CRC32 : HashFunction::XXH3;
+#else
+    function = HashFunction::XXH3;
+#endif
+  }
+
+  switch (function)
+  {
+  case HashFunction::XXH3:
+#if defined(_M_X86)
+    if (cpu_info.bAVX2)
+      ptrHashFunction = &GetXXH3<XXH3AccumulateAVX2, XXH3ScrambleAVX2>;
+    else
+      ptrHashFunction = &GetXXH3<XXH3AccumulateSSE2, XXH3ScrambleSSE2>;
+#elif defined(_M_ARM_64)
+    ptrHashFunction = &GetXXH3<XXH3AccumulateNEON, XXH3ScrambleNEON>;
+#else
+    ptrHashFunction = &GetXXH3<XXH3AccumulateGeneric, XXH3ScrambleGeneric>;
+#endif
+    break;
+
+  case HashFunction::CRC32:
+#if defined(_M_X86_64) || defined(_M_X86)
+    if (cpu_info.bSSE4_2)  // sse crc32 version
+    {
+      ptrHashFunction = &GetCRC32;
+      break;
+    }
+#elif defined(_M_ARM_64)
+    if (cpu_info.bCRC32)
+    {
+      ptrHashFunction = &GetCRC32;
+      break;
+    }
+#endif
+    [[fallthrough]];
+
+  case HashFunction::MurmurHash3:
+  default:
     ptrHashFunction = &GetMurmurHash3;
+    break;
   }
 }
 }  // namespace Common
@@ -10,9 +10,26 @@
 
 namespace Common
 {
+// Functions that GetHash64 can use. Switching to another one changes every hash it returns.
+enum class HashFunction : int
+{
+  // The fastest of the others on the host CPU.
+  Default,
+  // Only available with SSE 4.2 on x86 and the CRC32 extension on ARM64. Falls back to
+  // MurmurHash3 on other CPUs.
+  CRC32,
+  MurmurHash3,
+  // The 64-bit XXH3 from xxHash, vectorized with SSE2, AVX2 or NEON.
+  XXH3,
+};
+
 u32 HashFletcher(const u8* data_u8, size_t length);  // FAST. Length & 1 == 0.
 u32 HashAdler32(const u8* data, size_t len);         // Fairly accurate, slightly slower
 u32 HashEctor(const u8* ptr, size_t length);         // JUNK. DO NOT USE FOR NEW THINGS
+// The CRC-32 that zlib and Redump use. Pass 0 as crc to start, or the result of the previous call
+// to continue. Uses PCLMULQDQ on x86 and the CRC32 instructions on ARM64 when available.
+u32 UpdateCRC32(u32 crc, const u8* data, size_t len);
+// When samples is nonzero, only roughly that many evenly spaced parts of the data are hashed.
 u64 GetHash64(const u8* src, u32 len, u32 samples);
-void SetHash64Function();
+void SetHash64Function(HashFunction function = HashFunction::Default);
 }  // namespace Common
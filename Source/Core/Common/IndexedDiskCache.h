@@ -0,0 +1,340 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
+#include "Common/MappedFile.h"
+#include "Common/Version.h"
+
+// On disk format:
+// header{
+// u32 'ICAC';
+// u32 format_version;
+// u16 sizeof(key_type);
+// u16 sizeof(value_type);
+// char scm_rev[40];
+//}
+
+// entry{
+// u32 value_size;
+// u32 checksum;  // Adler-32 of key and value
+// key_type   key;
+// value_type[value_size]   value;
+//}
+
+// Key-value store with the same append-only file layout idea as LinearDiskCache, but with an
+// index of the newest entry for every key, so that values can be looked up at random.
+//
+// The file is memory mapped, so opening a cache only reads the entry headers, and values are
+// read in place when they are looked up. Values are checked against their checksum before they
+// are returned. Superseded entries and corrupted tails are dropped when the file is compacted,
+// which happens automatically on open once most of the file is stale.
+//
+// Values appended since the cache was opened are known to Contains, but can only be looked up
+// after the cache has been opened again.
+
+// K and V are some POD type
+// K : the key type
+// V : value array type, which must be byte sized as values are read from the file in place
+template <typename K, typename V>
+class IndexedDiskCache
+{
+public:
+  static_assert(std::is_trivially_copyable_v<K>, "K must be a trivially copyable type");
+  static_assert(sizeof(V) == 1 && std::is_trivially_copyable_v<V>, "V must be a byte type");
+
+  IndexedDiskCache() = default;
+  ~IndexedDiskCache() { Close(); }
+
+  IndexedDiskCache(const IndexedDiskCache&) = delete;
+  IndexedDiskCache& operator=(const IndexedDiskCache&) = delete;
+
+  // Opens or creates the cache and indexes its entries. Returns the number of keys.
+  u32 Open(const std::string& filename)
+  {
+    Close();
+
+    u64 valid_size = MapAndIndex(filename);
+    if (valid_size != 0 && m_stale_size > valid_size / 2)
+    {
+      CompactMapped(filename);
+      valid_size = MapAndIndex(filename);
+    }
+
+    if (valid_size == 0)
+    {
+      // Missing, or from another version, so start over.
+      Close();
+      File::IOFile file(filename, "wb");
+      const Header header;
+      if (!file.WriteArray(&header, 1))
+        return 0;
+      file.Close();
+      valid_size = MapAndIndex(filename);
+    }
+    else if (valid_size != m_mapped_file.GetSize())
+    {
+      // Cut off an entry that wasn't completely written, so that new entries follow the last
+      // complete one. A mapped file can't be truncated on every OS, so it's mapped again after.
+      m_mapped_file.Close();
+      if (!File::IOFile(filename, "r+b").Resize(valid_size))
+      {
+        Close();
+        return 0;
+      }
+      valid_size = MapAndIndex(filename);
+    }
+
+    m_file.Open(filename, "ab");
+    return static_cast<u32>(m_index.size());
+  }
+
+  // Opens the cache and passes the value of every key to reader, in the order in which they
+  // were appended. Entries with a bad checksum are skipped. Returns the number of read entries.
+  u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
+  {
+    Open(filename);
+
+    u32 num_read = 0;
+    for (const auto& [offset, key] : GetEntriesInFileOrder())
+    {
+      u32 value_size;
+      const V* value = Lookup(*key, &value_size);
+      if (!value)
+        continue;
+
+      reader.Read(*key, value, value_size);
+      num_read++;
+    }
+    return num_read;
+  }
+
+  bool Contains(const K& key) const { return m_index.find(key) != m_index.end(); }
+
+  // Returns the newest value of key, which stays valid until the cache is closed. Returns nullptr
+  // if the key is unknown, was appended since the cache was opened or fails its checksum.
+  const V* Lookup(const K& key, u32* value_size) const
+  {
+    const auto iter = m_index.find(key);
+    if (iter == m_index.end())
+      return nullptr;
+
+    const IndexEntry& entry = iter->second;
+    const u64 entry_size = sizeof(EntryHeader) + sizeof(K) + entry.value_size;
+    if (entry.offset + entry_size > m_mapped_file.GetSize())
+      return nullptr;
+
+    const u8* data = m_mapped_file.GetData() + entry.offset;
+    EntryHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    const u32 checksum = Common::HashAdler32(data + sizeof(header), sizeof(K) + entry.value_size);
+    if (header.checksum != checksum)
+      return nullptr;
+
+    *value_size = entry.value_size;
+    return reinterpret_cast<const V*>(data + sizeof(header) + sizeof(K));
+  }
+
+  // Appends a key-value pair to the store. An existing value of the key is superseded.
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    if (!m_file.IsOpen())
+      return;
+
+    std::vector<u8> buffer(sizeof(EntryHeader) + sizeof(K) + value_size);
+    std::memcpy(buffer.data() + sizeof(EntryHeader), &key, sizeof(K));
+    std::memcpy(buffer.data() + sizeof(EntryHeader) + sizeof(K), value, value_size);
+    const u32 checksum =
+        Common::HashAdler32(buffer.data() + sizeof(EntryHeader), sizeof(K) + value_size);
+    const EntryHeader header = {value_size, checksum};
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    if (!m_file.WriteBytes(buffer.data(), buffer.size()))
+      return;
+
+    AddToIndex(key, IndexEntry{m_file_size, value_size});
+    m_file_size += buffer.size();
+  }
+
+  void Sync() { m_file.Flush(); }
+
+  void Close()
+  {
+    if (m_file.IsOpen())
+      m_file.Close();
+    m_mapped_file.Close();
+    m_index.clear();
+    m_stale_size = 0;
+    m_file_size = 0;
+  }
+
+  u32 GetNumEntries() const { return static_cast<u32>(m_index.size()); }
+
+  // The number of bytes used by entries which were superseded by a newer value of their key.
+  u64 GetStaleSize() const { return m_stale_size; }
+
+  // Rewrites a cache file which isn't open with only the newest valid entry of every key.
+  static bool Compact(const std::string& filename)
+  {
+    IndexedDiskCache cache;
+    return cache.MapAndIndex(filename) != 0 && cache.CompactMapped(filename);
+  }
+
+private:
+  struct Header
+  {
+    Header()
+    {
+      // Null-terminator is intentionally not copied.
+      std::memcpy(&id, "ICAC", sizeof(u32));
+      std::memcpy(ver, Common::scm_rev_git_str.c_str(),
+                  std::min(Common::scm_rev_git_str.size(), sizeof(ver)));
+    }
+
+    u32 id;
+    u32 format_version = 1;
+    u16 key_t_size = sizeof(K);
+    u16 value_t_size = sizeof(V);
+    char ver[40] = {};
+  };
+
+  struct EntryHeader
+  {
+    u32 value_size;
+    u32 checksum;
+  };
+
+  struct IndexEntry
+  {
+    u64 offset;
+    u32 value_size;
+  };
+
+  struct KeyHash
+  {
+    std::size_t operator()(const K& key) const
+    {
+      return std::hash<std::string_view>{}(
+          std::string_view(reinterpret_cast<const char*>(&key), sizeof(K)));
+    }
+  };
+
+  struct KeyEqual
+  {
+    bool operator()(const K& lhs, const K& rhs) const
+    {
+      return std::memcmp(&lhs, &rhs, sizeof(K)) == 0;
+    }
+  };
+
+  void AddToIndex(const K& key, const IndexEntry& entry)
+  {
+    const auto [iter, inserted] = m_index.emplace(key, entry);
+    if (inserted)
+      return;
+
+    m_stale_size += sizeof(EntryHeader) + sizeof(K) + iter->second.value_size;
+    iter->second = entry;
+  }
+
+  // Returns the size of the file up to the end of the last complete entry, or 0 if the file
+  // can't be opened or has a bad header.
+  u64 MapAndIndex(const std::string& filename)
+  {
+    m_mapped_file.Close();
+    m_index.clear();
+    m_stale_size = 0;
+    m_file_size = 0;
+
+    if (!File::Exists(filename) || !m_mapped_file.Open(filename))
+      return 0;
+
+    const u8* data = m_mapped_file.GetData();
+    const u64 size = m_mapped_file.GetSize();
+    const Header expected_header;
+    if (size < sizeof(Header) || std::memcmp(data, &expected_header, sizeof(Header)) != 0)
+      return 0;
+
+    u64 offset = sizeof(Header);
+    while (size - offset >= sizeof(EntryHeader) + sizeof(K))
+    {
+      EntryHeader header;
+      std::memcpy(&header, data + offset, sizeof(header));
+      const u64 entry_size = sizeof(EntryHeader) + sizeof(K) + header.value_size;
+      if (entry_size > size - offset)
+        break;
+
+      K key;
+      std::memcpy(&key, data + offset + sizeof(EntryHeader), sizeof(K));
+      AddToIndex(key, IndexEntry{offset, header.value_size});
+      offset += entry_size;
+    }
+
+    m_file_size = offset;
+    return offset;
+  }
+
+  std::vector<std::pair<u64, const K*>> GetEntriesInFileOrder() const
+  {
+    std::vector<std::pair<u64, const K*>> entries;
+    entries.reserve(m_index.size());
+    for (const auto& it : m_index)
+      entries.emplace_back(it.second.offset, &it.first);
+    std::sort(entries.begin(), entries.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    return entries;
+  }
+
+  // Writes the valid indexed entries of the mapped file to a new file which then replaces it.
+  // The cache is left closed.
+  bool CompactMapped(const std::string& filename)
+  {
+    const std::string temp_filename = filename + ".compact";
+    bool success;
+    {
+      File::IOFile file(temp_filename, "wb");
+      const Header header;
+      success = file.WriteArray(&header, 1);
+      for (const auto& [offset, key] : GetEntriesInFileOrder())
+      {
+        u32 value_size;
+        if (!success || !Lookup(*key, &value_size))
+          continue;
+
+        const u64 entry_size = sizeof(EntryHeader) + sizeof(K) + value_size;
+        success = file.WriteBytes(m_mapped_file.GetData() + offset, entry_size);
+      }
+    }
+
+    m_mapped_file.Close();
+    m_index.clear();
+    if (!success || !File::Rename(temp_filename, filename))
+    {
+      File::Delete(temp_filename);
+      return false;
+    }
+    return true;
+  }
+
+  File::IOFile m_file;
+  File::MappedFile m_mapped_file;
+  std::unordered_map<K, IndexEntry, KeyHash, KeyEqual> m_index;
+  u64 m_stale_size = 0;
+  u64 m_file_size = 0;
+};
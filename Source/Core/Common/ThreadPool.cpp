@@ -0,0 +1,104 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Common/ThreadPool.h"
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+ThreadPool::~ThreadPool()
+{
+  Stop();
+}
+
+void ThreadPool::Start(u32 num_threads, const std::string& name)
+{
+  Stop();
+
+  m_quit = false;
+  m_generation = 0;
+  m_workers.reserve(num_threads);
+  for (u32 i = 0; i < num_threads; ++i)
+    m_workers.emplace_back(&ThreadPool::WorkerLoop, this, name);
+}
+
+void ThreadPool::Stop()
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_quit = true;
+  }
+  m_work_cv.notify_all();
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+}
+
+void ThreadPool::ParallelFor(u32 count, const std::function<void(u32)>& func)
+{
+  if (m_workers.empty() || count <= 1)
+  {
+    for (u32 i = 0; i < count; ++i)
+      func(i);
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_func = &func;
+    m_count = count;
+    m_next_task.store(0, std::memory_order_relaxed);
+    m_busy_workers = GetNumThreads();
+    ++m_generation;
+  }
+  m_work_cv.notify_all();
+
+  RunTasks(func, count);
+
+  // Every worker has to check in, even if there was nothing left for it to do, so that func
+  // stays alive for as long as anything might call it.
+  std::unique_lock lk(m_mutex);
+  m_done_cv.wait(lk, [this] { return m_busy_workers == 0; });
+  m_func = nullptr;
+}
+
+void ThreadPool::RunTasks(const std::function<void(u32)>& func, u32 count)
+{
+  for (u32 i = m_next_task.fetch_add(1, std::memory_order_relaxed); i < count;
+       i = m_next_task.fetch_add(1, std::memory_order_relaxed))
+  {
+    func(i);
+  }
+}
+
+void ThreadPool::WorkerLoop(std::string name)
+{
+  Common::SetCurrentThreadName(name.c_str());
+
+  u64 generation = 0;
+  while (true)
+  {
+    const std::function<void(u32)>* func;
+    u32 count;
+    {
+      std::unique_lock lk(m_mutex);
+      m_work_cv.wait(lk, [&] { return m_quit || m_generation != generation; });
+      if (m_quit)
+        return;
+
+      generation = m_generation;
+      func = m_func;
+      count = m_count;
+    }
+
+    RunTasks(*func, count);
+
+    std::lock_guard lk(m_mutex);
+    if (--m_busy_workers == 0)
+      m_done_cv.notify_one();
+  }
+}
+}  // namespace Common
@@ -0,0 +1,58 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace Common
+{
+// A fixed set of worker threads for splitting data-parallel work into independent tasks.
+// ParallelFor must only be called from one thread at a time.
+class ThreadPool
+{
+public:
+  ThreadPool() = default;
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Stops any running workers and starts num_threads new ones.
+  void Start(u32 num_threads, const std::string& name);
+  void Stop();
+
+  // Number of worker threads, not counting the thread calling ParallelFor.
+  u32 GetNumThreads() const { return static_cast<u32>(m_workers.size()); }
+
+  // Calls func(i) for every i in [0, count), spread over the workers and the calling thread.
+  // Returns once every call has returned. Without workers, everything runs on the calling thread.
+  void ParallelFor(u32 count, const std::function<void(u32)>& func);
+
+private:
+  void WorkerLoop(std::string name);
+  void RunTasks(const std::function<void(u32)>& func, u32 count);
+
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+  const std::function<void(u32)>* m_func = nullptr;
+  u32 m_count = 0;
+  u64 m_generation = 0;
+  u32 m_busy_workers = 0;
+  bool m_quit = false;
+
+  std::atomic<u32> m_next_task{0};
+};
+}  // namespace Common
@@ -7,6 +7,7 @@
 #include <string>
 
 #include "Common/Config/Config.h"
+#include "Common/Hash.h"
 #include "VideoCommon/VideoConfig.h"
 
 namespace Config
@@ -88,8 +89,18 @@ const Info<ShaderCompilationMode> GFX_SHADER_COMPILATION_MODE{
 const Info<int> GFX_SHADER_COMPILER_THREADS{{System::GFX, "Settings", "ShaderCompilerThreads"}, 1};
 const Info<int> GFX_SHADER_PRECOMPILER_THREADS{
     {System::GFX, "Settings", "ShaderPrecompilerThreads"}, 1};
+const Info<int> GFX_VERTEX_LOADER_THREADS{{System::GFX, "Settings", "VertexLoaderThreads"}, 0};
+const Info<int> GFX_TEXTURE_DECODER_THREADS{
+    {System::GFX, "Settings", "TextureDecoderThreads"}, 0};
 const Info<bool> GFX_SAVE_TEXTURE_CACHE_TO_STATE{
     {System::GFX, "Settings", "SaveTextureCacheToState"}, true};
+const Info<bool> GFX_TEXTURE_DISK_CACHE{{System::GFX, "Settings", "TextureDiskCache"}, false};
+const Info<bool> GFX_COMPRESS_TEXTURE_DISK_CACHE{
+    {System::GFX, "Settings", "CompressTextureDiskCache"}, false};
+const Info<bool> GFX_TEXTURE_WRITE_TRACKING{
+    {System::GFX, "Settings", "TextureWriteTracking"}, false};
+const Info<Common::HashFunction> GFX_TEXTURE_HASH_FUNCTION{
+    {System::GFX, "Settings", "TextureHashFunction"}, Common::HashFunction::Default};
 
 const Info<bool> GFX_SW_ZCOMPLOC{{System::GFX, "Settings", "SWZComploc"}, true};
 const Info<bool> GFX_SW_ZFREEZE{{System::GFX, "Settings", "SWZFreeze"}, true};
@@ -99,6 +110,7 @@ const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES{{System::GFX, "Settings", "SWDumpTe
                                              false};
 const Info<int> GFX_SW_DRAW_START{{System::GFX, "Settings", "SWDrawStart"}, 0};
 const Info<int> GFX_SW_DRAW_END{{System::GFX, "Settings", "SWDrawEnd"}, 100000};
+const Info<int> GFX_SW_RASTERIZER_THREADS{{System::GFX, "Settings", "SWRasterizerThreads"}, 0};
 
 const Info<bool> GFX_PREFER_GLES{{System::GFX, "Settings", "PreferGLES"}, false};
 
@@ -13,6 +13,11 @@ enum class ShaderCompilationMode : int;
 enum class StereoMode : int;
 enum class FreelookControlType : int;
 
+namespace Common
+{
+enum class HashFunction : int;
+}
+
 namespace Config
 {
 // Configuration Information
@@ -71,7 +76,13 @@ extern const Info<bool> GFX_WAIT_FOR_SHADERS_BEFORE_STARTING;
 extern const Info<ShaderCompilationMode> GFX_SHADER_COMPILATION_MODE;
 extern const Info<int> GFX_SHADER_COMPILER_THREADS;
 extern const Info<int> GFX_SHADER_PRECOMPILER_THREADS;
+extern const Info<int> GFX_VERTEX_LOADER_THREADS;
+extern const Info<int> GFX_TEXTURE_DECODER_THREADS;
 extern const Info<bool> GFX_SAVE_TEXTURE_CACHE_TO_STATE;
+extern const Info<bool> GFX_TEXTURE_DISK_CACHE;
+extern const Info<bool> GFX_COMPRESS_TEXTURE_DISK_CACHE;
+extern const Info<bool> GFX_TEXTURE_WRITE_TRACKING;
+extern const Info<Common::HashFunction> GFX_TEXTURE_HASH_FUNCTION;
 
 extern const Info<bool> GFX_SW_ZCOMPLOC;
 extern const Info<bool> GFX_SW_ZFREEZE;
@@ -80,6 +91,7 @@ extern const Info<bool> GFX_SW_DUMP_TEV_STAGES;
 extern const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
 extern const Info<int> GFX_SW_DRAW_START;
 extern const Info<int> GFX_SW_DRAW_END;
+extern const Info<int> GFX_SW_RASTERIZER_THREADS;
 
 extern const Info<bool> GFX_PREFER_GLES;
 
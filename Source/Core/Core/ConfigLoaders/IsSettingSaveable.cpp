@@ -47,7 +47,7 @@ bool IsSettingSaveable(const Config::Location& config_location)
     }
   }
 
-  static constexpr std::array<const Config::Location*, 17> s_setting_saveable = {
+  static constexpr std::array<const Config::Location*, 20> s_setting_saveable = {
       // Main.Core
 
       &Config::MAIN_DEFAULT_ISO.GetLocation(),
@@ -63,6 +63,9 @@ bool IsSettingSaveable(const Config::Location& config_location)
       &Config::MAIN_GFX_BACKEND.GetLocation(),
       &Config::MAIN_ENABLE_SAVESTATES.GetLocation(),
       &Config::MAIN_FALLBACK_REGION.GetLocation(),
+      &Config::MAIN_JIT_PERSISTENT_CACHE.GetLocation(),
+      &Config::MAIN_JIT_TIER_UP_THRESHOLD.GetLocation(),
+      &Config::MAIN_MAP_DISC_INTO_MEMORY.GetLocation(),
 
       // Main.Interface
 
@@ -377,6 +377,7 @@ void FifoPlayer::WriteMemory(const MemoryUpdate& memUpdate)
     mem = &Memory::m_pRAM[memUpdate.address & Memory::GetRamMask()];
 
   std::copy(memUpdate.data.begin(), memUpdate.data.end(), mem);
+  Memory::MarkWritten(memUpdate.address, memUpdate.data.size());
 }
 
 void FifoPlayer::WriteFifo(const u8* data, u32 start, u32 end)
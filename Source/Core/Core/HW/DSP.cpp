@@ -592,6 +592,10 @@ static void Do_ARAM_DMA()
               Common::swap64(Memory::Read_U64(s_arDMA.MMAddr));
         }
 
+        // On the Wii, ARAM is MEM2.
+        if (s_ARAM.wii_mode)
+          Memory::MarkWritten(0x10000000 | (s_arDMA.ARAddr & s_ARAM.mask), sizeof(u64));
+
         s_arDMA.MMAddr += 8;
         s_arDMA.ARAddr += 8;
         s_arDMA.Cnt.count -= 8;
@@ -630,6 +634,8 @@ void WriteARAM(u8 value, u32 address)
 {
   // TODO: verify this on Wii
   s_ARAM.ptr[address & s_ARAM.mask] = value;
+  if (s_ARAM.wii_mode)
+    Memory::MarkWritten(0x10000000 | (address & s_ARAM.mask), sizeof(u8));
 }
 
 u8* GetARAMPtr()
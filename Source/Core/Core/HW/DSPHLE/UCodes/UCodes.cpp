@@ -50,6 +50,7 @@ void HLEMemory_Write_U8(u32 address, u8 value)
     Memory::m_pEXRAM[address & Memory::GetExRamMask()] = value;
   else
     Memory::m_pRAM[address & Memory::GetRamMask()] = value;
+  Memory::MarkWritten(address, sizeof(u8));
 }
 
 u16 HLEMemory_Read_U16LE(u32 address)
@@ -75,6 +76,7 @@ void HLEMemory_Write_U16LE(u32 address, u16 value)
     std::memcpy(&Memory::m_pEXRAM[address & Memory::GetExRamMask()], &value, sizeof(u16));
   else
     std::memcpy(&Memory::m_pRAM[address & Memory::GetRamMask()], &value, sizeof(u16));
+  Memory::MarkWritten(address, sizeof(u16));
 }
 
 void HLEMemory_Write_U16(u32 address, u16 value)
@@ -105,6 +107,7 @@ void HLEMemory_Write_U32LE(u32 address, u32 value)
     std::memcpy(&Memory::m_pEXRAM[address & Memory::GetExRamMask()], &value, sizeof(u32));
   else
     std::memcpy(&Memory::m_pRAM[address & Memory::GetRamMask()], &value, sizeof(u32));
+  Memory::MarkWritten(address, sizeof(u32));
 }
 
 void HLEMemory_Write_U32(u32 address, u32 value)
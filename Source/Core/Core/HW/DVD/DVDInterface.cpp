@@ -1299,14 +1299,16 @@ void SetDriveError(DriveError error)
 }
 
 void FinishExecutingCommand(ReplyType reply_type, DIInterruptType interrupt_type, s64 cycles_late,
-                            const std::vector<u8>& data)
+                            u32 read_length, const std::vector<u8>& data)
 {
-  // The data parameter contains the requested data iff this was called from DVDThread, and is
-  // empty otherwise. DVDThread is the only source of ReplyType::NoReply and ReplyType::DTK.
+  // The read_length parameter is the number of bytes that were read iff this was called from
+  // DVDThread, and is 0 otherwise. The data parameter contains the requested data for DTK reads,
+  // but may be empty for reads that DVDThread copied straight to emulated RAM.
+  // DVDThread is the only source of ReplyType::NoReply and ReplyType::DTK.
 
   u32 transfer_size = 0;
   if (reply_type == ReplyType::NoReply)
-    transfer_size = static_cast<u32>(data.size());
+    transfer_size = read_length;
   else if (reply_type == ReplyType::Interrupt || reply_type == ReplyType::IOS)
     transfer_size = s_DILENGTH;
 
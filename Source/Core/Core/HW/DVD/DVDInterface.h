@@ -143,7 +143,7 @@ void SetDriveError(DriveError error);
 
 // Used by DVDThread
 void FinishExecutingCommand(ReplyType reply_type, DIInterruptType interrupt_type, s64 cycles_late,
-                            const std::vector<u8>& data = std::vector<u8>());
+                            u32 read_length = 0, const std::vector<u8>& data = std::vector<u8>());
 
 // Used by IOS HLE
 void SetInterruptEnabled(DIInterruptType interrupt, bool enabled);
@@ -4,6 +4,9 @@
 
 #include "Core/HW/DVD/DVDThread.h"
 
+#include <algorithm>
+#include <cstring>
+#include <deque>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -13,6 +16,7 @@
 #include <vector>
 
 #include "Common/ChunkFile.h"
+#include "Common/Config/Config.h"
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
@@ -22,16 +26,19 @@
 #include "Common/Thread.h"
 #include "Common/Timer.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/CoreTiming.h"
 #include "Core/HW/DVD/DVDInterface.h"
 #include "Core/HW/DVD/FileMonitor.h"
+#include "Core/HW/DVD/ReadPredictor.h"
 #include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/IOS/ES/Formats.h"
 
 #include "DiscIO/Enums.h"
+#include "DiscIO/Filesystem.h"
 #include "DiscIO/Volume.h"
 
 namespace DVDThread
@@ -62,11 +69,43 @@ struct ReadRequest
 
 using ReadResult = std::pair<ReadRequest, std::vector<u8>>;
 
+// Reads to emulated RAM from a disc image that is already in memory (like a memory mapped ISO)
+// aren't copied into the result buffer. Instead, direct_data points into the image, and FinishRead
+// copies the data straight to emulated RAM.
+struct PendingReadResult
+{
+  ReadResult result;
+  const u8* direct_data = nullptr;
+};
+
+struct PredictedRead
+{
+  DiscIO::Partition partition;
+  ReadPredictor::Read read;
+};
+
+struct PrefetchedRead
+{
+  DiscIO::Partition partition;
+  u64 offset;
+  std::vector<u8> data;
+};
+
 static void StartDVDThread();
 static void StopDVDThread();
 
 static void DVDThread();
 static void WaitUntilIdle();
+static void MovePendingResultToMap(PendingReadResult pending_result);
+static void MovePendingResultsToMap();
+static void TouchPages(const u8* data, u64 length);
+
+static const PrefetchedRead* FindPrefetchedRead(const DiscIO::Partition& partition, u64 offset,
+                                                u64 length);
+static bool ReadFromPrefetchBuffer(const ReadRequest& request, u8* buffer);
+static void PredictReads(const ReadRequest& request);
+static void Prefetch(const PredictedRead& predicted_read);
+static void ClearPrefetchBuffer();
 
 static void StartReadInternal(bool copy_to_ram, u32 output_address, u64 dvd_offset, u32 length,
                               const DiscIO::Partition& partition,
@@ -83,11 +122,22 @@ static Common::Event s_result_queue_expanded;     // Is set by DVD thread
 static Common::Flag s_dvd_thread_exiting(false);  // Is set by CPU thread
 
 static Common::SPSCQueue<ReadRequest, false> s_request_queue;
-static Common::SPSCQueue<ReadResult, false> s_result_queue;
+static Common::SPSCQueue<PendingReadResult, false> s_result_queue;
 static std::map<u64, ReadResult> s_result_map;
 
 static std::unique_ptr<DiscIO::Volume> s_disc;
 
+// Reads that the emulated software is expected to make are done ahead of time while the DVD
+// thread has nothing else to do, so that slow storage or decompression doesn't delay the reads
+// that it actually makes. The data doesn't reach the emulated software any earlier, so this has
+// no effect on emulation. Only accessed by the DVD thread, or while it's idle.
+constexpr u64 MAX_PREFETCHED_BYTES = 0x800000;
+constexpr size_t MAX_QUEUED_PREDICTIONS = 8;
+static ReadPredictor s_read_predictor;
+static std::deque<PredictedRead> s_predicted_reads;
+static std::deque<PrefetchedRead> s_prefetched_reads;
+static u64 s_prefetched_bytes = 0;
+
 void Start()
 {
   s_finish_read = CoreTiming::RegisterEvent("FinishReadDVDThread", FinishRead);
@@ -101,6 +151,8 @@ void Start()
   // much, because this will never get exposed to the emulated game.
   s_next_id = 0;
 
+  ClearPrefetchBuffer();
+
   StartDVDThread();
 }
 
@@ -114,7 +166,9 @@ static void StartDVDThread()
 void Stop()
 {
   StopDVDThread();
+  MovePendingResultsToMap();
   s_disc.reset();
+  ClearPrefetchBuffer();
 }
 
 static void StopDVDThread()
@@ -140,9 +194,7 @@ void DoState(PointerWrap& p)
   // Move all results from s_result_queue to s_result_map because
   // PointerWrap::Do supports std::map but not Common::SPSCQueue.
   // This won't affect the behavior of FinishRead.
-  ReadResult result;
-  while (s_result_queue.Pop(result))
-    s_result_map.emplace(result.first.id, std::move(result));
+  MovePendingResultsToMap();
 
   // Both queues are now empty, so we don't need to savestate them.
   p.Do(s_result_map);
@@ -177,7 +229,15 @@ void DoState(PointerWrap& p)
 void SetDisc(std::unique_ptr<DiscIO::Volume> disc)
 {
   WaitUntilIdle();
+  MovePendingResultsToMap();
   s_disc = std::move(disc);
+  // Only the emulated disc is mapped into memory. Other users of disc images, like the game list
+  // or the verifier, keep using regular reads. Mapping is opt-in, since a mapped file that can't
+  // be read anymore (e.g. on a removed drive) crashes instead of failing the read (see
+  // BlobReader::MapIntoMemory).
+  if (s_disc && Config::Get(Config::MAIN_MAP_DISC_INTO_MEMORY))
+    s_disc->MapIntoMemory();
+  ClearPrefetchBuffer();
 }
 
 bool HasDisc()
@@ -307,30 +367,32 @@ static void FinishRead(u64 id, s64 cycles_late)
   // Instead, we add them to a map that only is used by the CPU thread.
   // When this function is called again later, it will check the map for
   // the wanted ReadResult before it starts searching through the queue.
-  ReadResult result;
+  PendingReadResult pending_result;
   auto it = s_result_map.find(id);
   if (it != s_result_map.end())
   {
-    result = std::move(it->second);
+    pending_result.result = std::move(it->second);
     s_result_map.erase(it);
   }
   else
   {
     while (true)
     {
-      while (!s_result_queue.Pop(result))
+      while (!s_result_queue.Pop(pending_result))
         s_result_queue_expanded.Wait();
 
-      if (result.first.id == id)
+      if (pending_result.result.first.id == id)
         break;
       else
-        s_result_map.emplace(result.first.id, std::move(result));
+        MovePendingResultToMap(std::move(pending_result));
     }
   }
   // We have now obtained the right ReadResult.
 
-  const ReadRequest& request = result.first;
-  const std::vector<u8>& buffer = result.second;
+  const ReadRequest& request = pending_result.result.first;
+  const std::vector<u8>& buffer = pending_result.result.second;
+  const u8* direct_data = pending_result.direct_data;
+  const bool read_succeeded = direct_data || buffer.size() == request.length;
 
   DEBUG_LOG_FMT(DVDINTERFACE,
                 "Disc has been read. Real time: {} us. "
@@ -342,7 +404,7 @@ static void FinishRead(u64 id, s64 cycles_late)
                     (SystemTimers::GetTicksPerSecond() / 1000000));
 
   DVDInterface::DIInterruptType interrupt;
-  if (buffer.size() != request.length)
+  if (!read_succeeded)
   {
     PanicAlertFmtT("The disc could not be read (at {0:#x} - {1:#x}).", request.dvd_offset,
                    request.dvd_offset + request.length);
@@ -353,13 +415,50 @@ static void FinishRead(u64 id, s64 cycles_late)
   else
   {
     if (request.copy_to_ram)
-      Memory::CopyToEmu(request.output_address, buffer.data(), request.length);
+    {
+      Memory::CopyToEmu(request.output_address, direct_data ? direct_data : buffer.data(),
+                        request.length);
+    }
 
     interrupt = DVDInterface::DIInterruptType::TCINT;
   }
 
   // Notify the emulated software that the command has been executed
-  DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late, buffer);
+  DVDInterface::FinishExecutingCommand(request.reply_type, interrupt, cycles_late,
+                                       read_succeeded ? request.length : 0, buffer);
+}
+
+static void MovePendingResultToMap(PendingReadResult pending_result)
+{
+  ReadResult& result = pending_result.result;
+  if (pending_result.direct_data)
+  {
+    result.second.assign(pending_result.direct_data,
+                         pending_result.direct_data + result.first.length);
+  }
+
+  s_result_map.emplace(result.first.id, std::move(result));
+}
+
+// Results in s_result_map don't point into s_disc, so they can be savestated
+// and stay valid when s_disc changes.
+static void MovePendingResultsToMap()
+{
+  PendingReadResult pending_result;
+  while (s_result_queue.Pop(pending_result))
+    MovePendingResultToMap(std::move(pending_result));
+}
+
+// Reads a byte from every page so that the OS loads the data from disk on the DVD thread
+// rather than when FinishRead copies it on the CPU thread.
+static void TouchPages(const u8* data, u64 length)
+{
+  constexpr u64 MIN_PAGE_SIZE = 0x1000;
+  const volatile u8* bytes = data;
+  for (u64 i = 0; i < length; i += MIN_PAGE_SIZE)
+    static_cast<void>(bytes[i]);
+  if (length != 0)
+    static_cast<void>(bytes[length - 1]);
 }
 
 static void DVDThread()
@@ -378,18 +477,131 @@ static void DVDThread()
     {
       FileMonitor::Log(*s_disc, request.partition, request.dvd_offset);
 
-      std::vector<u8> buffer(request.length);
-      if (!s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
-        buffer.resize(0);
+      PendingReadResult pending_result;
+      if (request.copy_to_ram)
+      {
+        pending_result.direct_data =
+            s_disc->GetDirectPointer(request.dvd_offset, request.length, request.partition);
+      }
+
+      std::vector<u8>& buffer = pending_result.result.second;
+      if (pending_result.direct_data)
+      {
+        TouchPages(pending_result.direct_data, request.length);
+      }
+      else
+      {
+        buffer.resize(request.length);
+        if (!ReadFromPrefetchBuffer(request, buffer.data()) &&
+            !s_disc->Read(request.dvd_offset, request.length, buffer.data(), request.partition))
+        {
+          buffer.resize(0);
+        }
+      }
 
       request.realtime_done_us = Common::Timer::GetTimeUs();
 
-      s_result_queue.Push(ReadResult(std::move(request), std::move(buffer)));
+      PredictReads(request);
+
+      pending_result.result.first = std::move(request);
+      s_result_queue.Push(std::move(pending_result));
       s_result_queue_expanded.Set();
 
       if (s_dvd_thread_exiting.IsSet())
         return;
     }
+
+    // Requests that arrive in the meantime only have to wait for the current prefetch.
+    while (!s_predicted_reads.empty() && s_request_queue.Empty() &&
+           !s_dvd_thread_exiting.IsSet())
+    {
+      const PredictedRead predicted_read = s_predicted_reads.front();
+      s_predicted_reads.pop_front();
+      Prefetch(predicted_read);
+    }
   }
 }
+
+static const PrefetchedRead* FindPrefetchedRead(const DiscIO::Partition& partition, u64 offset,
+                                                u64 length)
+{
+  const auto it = std::find_if(
+      s_prefetched_reads.begin(), s_prefetched_reads.end(), [&](const PrefetchedRead& read) {
+        return read.partition == partition && read.offset <= offset &&
+               offset + length <= read.offset + read.data.size();
+      });
+  return it != s_prefetched_reads.end() ? &*it : nullptr;
+}
+
+static bool ReadFromPrefetchBuffer(const ReadRequest& request, u8* buffer)
+{
+  const PrefetchedRead* prefetched_read =
+      FindPrefetchedRead(request.partition, request.dvd_offset, request.length);
+  if (!prefetched_read)
+    return false;
+
+  DEBUG_LOG_FMT(DVDINTERFACE, "Prefetched {:#x} - {:#x}", request.dvd_offset,
+                request.dvd_offset + request.length);
+  std::memcpy(buffer, prefetched_read->data.data() + (request.dvd_offset - prefetched_read->offset),
+              request.length);
+  return true;
+}
+
+static void PredictReads(const ReadRequest& request)
+{
+  const DiscIO::FileSystem* file_system = s_disc->GetFileSystem(request.partition);
+  if (!file_system)
+    return;
+
+  const std::unique_ptr<DiscIO::FileInfo> file_info = file_system->FindFileInfo(request.dvd_offset);
+  if (!file_info)
+    return;
+
+  const u64 file_start = file_info->GetOffset();
+  const std::vector<ReadPredictor::Read> reads =
+      s_read_predictor.RecordRead(request.partition, file_start, file_start + file_info->GetSize(),
+                                  request.dvd_offset, request.length, MAX_PREFETCHED_BYTES / 2);
+
+  // The newest predictions go first, as the reads of the other files may have moved on.
+  for (auto it = reads.rbegin(); it != reads.rend(); ++it)
+    s_predicted_reads.push_front({request.partition, *it});
+  if (s_predicted_reads.size() > MAX_QUEUED_PREDICTIONS)
+    s_predicted_reads.resize(MAX_QUEUED_PREDICTIONS);
+}
+
+static void Prefetch(const PredictedRead& predicted_read)
+{
+  const ReadPredictor::Read& read = predicted_read.read;
+
+  // Data that can be accessed directly doesn't need a copy, only to be loaded from disk by the OS
+  if (const u8* direct_data =
+          s_disc->GetDirectPointer(read.offset, read.length, predicted_read.partition))
+  {
+    TouchPages(direct_data, read.length);
+    return;
+  }
+
+  if (FindPrefetchedRead(predicted_read.partition, read.offset, read.length))
+    return;
+
+  std::vector<u8> data(read.length);
+  if (!s_disc->Read(read.offset, read.length, data.data(), predicted_read.partition))
+    return;
+
+  s_prefetched_bytes += data.size();
+  s_prefetched_reads.push_back({predicted_read.partition, read.offset, std::move(data)});
+  while (s_prefetched_bytes > MAX_PREFETCHED_BYTES)
+  {
+    s_prefetched_bytes -= s_prefetched_reads.front().data.size();
+    s_prefetched_reads.pop_front();
+  }
+}
+
+static void ClearPrefetchBuffer()
+{
+  s_read_predictor.Clear();
+  s_predicted_reads.clear();
+  s_prefetched_reads.clear();
+  s_prefetched_bytes = 0;
+}
 }  // namespace DVDThread
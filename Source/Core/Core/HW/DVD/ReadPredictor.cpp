@@ -0,0 +1,85 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/HW/DVD/ReadPredictor.h"
+
+#include <algorithm>
+
+namespace DVDThread
+{
+// Games rarely stream from more than a few files at once, like music, a movie and level data.
+constexpr size_t MAX_FILES = 16;
+constexpr size_t MAX_PREDICTED_READS = 4;
+
+ReadPredictor::FileState& ReadPredictor::GetFileState(const DiscIO::Partition& partition,
+                                                      u64 file_start)
+{
+  const auto it = std::find_if(m_files.begin(), m_files.end(), [&](const FileState& file) {
+    return file.partition == partition && file.file_start == file_start;
+  });
+  if (it != m_files.end())
+    return *it;
+
+  const FileState new_file = {partition, file_start, 0, 0, 0, 0, 0};
+  if (m_files.size() < MAX_FILES)
+    return m_files.emplace_back(new_file);
+
+  // Forget the file that was read least recently.
+  const auto oldest = std::min_element(
+      m_files.begin(), m_files.end(),
+      [](const FileState& a, const FileState& b) { return a.last_used < b.last_used; });
+  *oldest = new_file;
+  return *oldest;
+}
+
+std::vector<ReadPredictor::Read> ReadPredictor::RecordRead(const DiscIO::Partition& partition,
+                                                           u64 file_start, u64 file_end,
+                                                           u64 offset, u32 length, u64 max_bytes)
+{
+  std::vector<Read> predicted_reads;
+  if (length == 0)
+    return predicted_reads;
+
+  FileState& file = GetFileState(partition, file_start);
+  file.last_used = ++m_reads;
+
+  // A read either starts where the previous one ended, or as far after the previous one as that
+  // one was after the one before it.
+  const bool first_read = file.last_length == 0;
+  const s64 step = static_cast<s64>(offset - file.last_offset);
+  const bool sequential = !first_read && step == file.last_length;
+  const bool strided = !first_read && step != 0 && step == file.stride;
+  file.matches = sequential || strided ? file.matches + 1 : 0;
+  file.stride = first_read ? 0 : step;
+  file.last_offset = offset;
+  file.last_length = length;
+
+  if (file.matches == 0)
+    return predicted_reads;
+
+  const s64 next_step = sequential ? length : step;
+  u64 bytes = 0;
+  for (size_t i = 1; i <= MAX_PREDICTED_READS; ++i)
+  {
+    const u64 next_offset = offset + static_cast<u64>(next_step * static_cast<s64>(i));
+    if (next_offset < file_start || next_offset >= file_end)
+      break;
+
+    const u32 next_length = static_cast<u32>(std::min<u64>(length, file_end - next_offset));
+    if (bytes + next_length > max_bytes)
+      break;
+
+    predicted_reads.push_back({next_offset, next_length});
+    bytes += next_length;
+  }
+
+  return predicted_reads;
+}
+
+void ReadPredictor::Clear()
+{
+  m_files.clear();
+  m_reads = 0;
+}
+}  // namespace DVDThread
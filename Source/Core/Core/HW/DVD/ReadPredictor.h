@@ -0,0 +1,51 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Volume.h"
+
+namespace DVDThread
+{
+// Learns the sequential and strided access patterns of the files that the emulated software
+// reads, so that the reads which are likely to follow can be done ahead of time.
+class ReadPredictor
+{
+public:
+  struct Read
+  {
+    u64 offset;
+    u32 length;
+  };
+
+  // Records a read of the file that spans [file_start, file_end) and returns the reads expected
+  // to follow it, nearest first. The predicted reads lie within the file and add up to at most
+  // max_bytes. Nothing is predicted until a read of the file continues where the previous one
+  // ended, or repeats the distance between the previous two.
+  std::vector<Read> RecordRead(const DiscIO::Partition& partition, u64 file_start, u64 file_end,
+                               u64 offset, u32 length, u64 max_bytes);
+
+  void Clear();
+
+private:
+  struct FileState
+  {
+    DiscIO::Partition partition;
+    u64 file_start;
+    u64 last_offset;
+    u32 last_length;
+    s64 stride;
+    u32 matches;
+    u64 last_used;
+  };
+
+  FileState& GetFileState(const DiscIO::Partition& partition, u64 file_start);
+
+  std::vector<FileState> m_files;
+  u64 m_reads = 0;
+};
+}  // namespace DVDThread
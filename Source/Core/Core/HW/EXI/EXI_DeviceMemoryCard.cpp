@@ -538,6 +538,7 @@ IEXIDevice* CEXIMemoryCard::FindDevice(TEXIDevices device_type, int custom_index
 void CEXIMemoryCard::DMARead(u32 addr, u32 size)
 {
   m_memory_card->Read(m_address, size, Memory::GetPointer(addr));
+  Memory::MarkWritten(addr, size);
 
   if ((m_address + size) % Memcard::BLOCK_SIZE == 0)
   {
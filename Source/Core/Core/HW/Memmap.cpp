@@ -11,15 +11,26 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstring>
+#include <limits>
 #include <memory>
+#include <mutex>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
 
 #include "Common/ChunkFile.h"
+#include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
+#include "Core/Config/GraphicsSettings.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/AudioInterface.h"
@@ -182,6 +193,7 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 physical_address;
 };
 
 // Dolphin allocates memory to represent four regions:
@@ -228,6 +240,27 @@ static std::array<PhysicalMemoryRegion, 4> s_physical_regions;
 
 static std::vector<LogicalMemoryView> logical_mapped_entries;
 
+// Writes are tracked in pages of this size, which is a multiple of the host page size on every
+// supported platform, and divides the size of every view of RAM in the fastmem arena.
+constexpr u32 WRITE_TRACKING_PAGE_SHIFT = 14;
+constexpr u32 WRITE_TRACKING_PAGE_SIZE = 1 << WRITE_TRACKING_PAGE_SHIFT;
+
+// Write stamp of pages that aren't write-protected. Writes to them can't be seen, so they count as
+// written at any time.
+constexpr u64 UNTRACKED_PAGE = std::numeric_limits<u64>::max();
+
+static bool s_write_tracking_enabled = false;
+// One stamp per page of MEM1, followed by the pages of MEM2. A tracked page holds the value of
+// s_write_stamp from when it was last written, or from when tracking started.
+static std::unique_ptr<std::atomic<u64>[]> s_page_write_stamps;
+static u32 s_write_tracking_page_count;
+static std::atomic<u64> s_write_stamp;
+// Guards changes to the protection of pages, and the views of the fastmem arena.
+static std::mutex s_write_tracking_mutex;
+
+static void StopTrackingAllPages();
+static void ResetWriteTracking();
+
 void Init()
 {
   const auto get_mem1_size = [] {
@@ -307,6 +340,15 @@ void Init()
   else
     mmio_mapping = InitMMIO();
 
+  s_write_tracking_enabled = Config::Get(Config::GFX_TEXTURE_WRITE_TRACKING);
+  if (s_write_tracking_enabled)
+  {
+    s_write_tracking_page_count =
+        (GetRamSize() + (wii ? GetExRamSize() : 0)) >> WRITE_TRACKING_PAGE_SHIFT;
+    s_page_write_stamps = std::make_unique<std::atomic<u64>[]>(s_write_tracking_page_count);
+    s_write_stamp = 1;
+  }
+
   Clear();
 
   INFO_LOG_FMT(MEMMAP, "Memory system initialized. RAM at {}", fmt::ptr(m_pRAM));
@@ -345,6 +387,7 @@ bool InitFastmemArena()
 #endif
 
   is_fastmem_arena_initialized = true;
+  ResetWriteTracking();
   return true;
 }
 
@@ -353,6 +396,10 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   if (!is_fastmem_arena_initialized)
     return;
 
+  // The new views aren't write-protected.
+  std::lock_guard lock(s_write_tracking_mutex);
+  StopTrackingAllPages();
+
   for (auto& entry : logical_mapped_entries)
   {
     g_arena.ReleaseView(entry.mapped_pointer, entry.mapped_size);
@@ -390,7 +437,7 @@ void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                           intersection_start, mapped_size, logical_address);
             exit(0);
           }
-          logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+          logical_mapped_entries.push_back({mapped_pointer, mapped_size, intersection_start});
         }
       }
     }
@@ -409,6 +456,9 @@ void DoState(PointerWrap& p)
   if (wii)
     p.DoArray(m_pEXRAM, GetExRamSize());
   p.DoMarker("Memory EXRAM");
+
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    ResetWriteTracking();
 }
 
 void Shutdown()
@@ -426,6 +476,8 @@ void Shutdown()
   }
   g_arena.ReleaseSHMSegment();
   mmio_mapping.reset();
+  s_page_write_stamps.reset();
+  s_write_tracking_enabled = false;
   INFO_LOG_FMT(MEMMAP, "Memory system shut down.");
 }
 
@@ -434,6 +486,8 @@ void ShutdownFastmemArena()
   if (!is_fastmem_arena_initialized)
     return;
 
+  std::lock_guard lock(s_write_tracking_mutex);
+
   for (const PhysicalMemoryRegion& region : s_physical_regions)
   {
     if (!region.active)
@@ -465,6 +519,7 @@ void Clear()
     memset(m_pFakeVMEM, 0, GetFakeVMemSize());
   if (m_pEXRAM)
     memset(m_pEXRAM, 0, GetExRamSize());
+  ResetWriteTracking();
 }
 
 static inline u8* GetPointerForRange(u32 address, size_t size)
@@ -507,6 +562,7 @@ void CopyToEmu(u32 address, const void* data, size_t size)
     return;
   }
   memcpy(pointer, data, size);
+  MarkWritten(address, size);
 }
 
 void Memset(u32 address, u8 value, size_t size)
@@ -521,6 +577,7 @@ void Memset(u32 address, u8 value, size_t size)
     return;
   }
   memset(pointer, value, size);
+  MarkWritten(address, size);
 }
 
 std::string GetString(u32 em_address, size_t size)
@@ -581,34 +638,250 @@ u64 Read_U64(u32 address)
 void Write_U8(u8 value, u32 address)
 {
   *GetPointer(address) = value;
+  MarkWritten(address, sizeof(u8));
 }
 
 void Write_U16(u16 value, u32 address)
 {
   u16 swapped_value = Common::swap16(value);
   std::memcpy(GetPointer(address), &swapped_value, sizeof(u16));
+  MarkWritten(address, sizeof(u16));
 }
 
 void Write_U32(u32 value, u32 address)
 {
   u32 swapped_value = Common::swap32(value);
   std::memcpy(GetPointer(address), &swapped_value, sizeof(u32));
+  MarkWritten(address, sizeof(u32));
 }
 
 void Write_U64(u64 value, u32 address)
 {
   u64 swapped_value = Common::swap64(value);
   std::memcpy(GetPointer(address), &swapped_value, sizeof(u64));
+  MarkWritten(address, sizeof(u64));
 }
 
 void Write_U32_Swap(u32 value, u32 address)
 {
   std::memcpy(GetPointer(address), &value, sizeof(u32));
+  MarkWritten(address, sizeof(u32));
 }
 
 void Write_U64_Swap(u64 value, u32 address)
 {
   std::memcpy(GetPointer(address), &value, sizeof(u64));
+  MarkWritten(address, sizeof(u64));
+}
+
+// Returns the write tracking page of a physical address in RAM, or false for any other address.
+static bool GetWriteTrackingPage(u32 address, u32* page)
+{
+  if (address < GetRamSize())
+  {
+    *page = address >> WRITE_TRACKING_PAGE_SHIFT;
+    return true;
+  }
+
+  if (m_pEXRAM && (address >> 28) == 0x1 && (address & 0x0fffffff) < GetExRamSize())
+  {
+    *page = (GetRamSize() + (address & 0x0fffffff)) >> WRITE_TRACKING_PAGE_SHIFT;
+    return true;
+  }
+
+  return false;
+}
+
+// Returns the first and the last page of a range. Like the CPU, this treats the mirrors of MEM1 as
+// MEM1 itself.
+static bool GetWriteTrackingPages(u32 address, size_t size, u32* first_page, u32* last_page)
+{
+  if (size == 0 || size >= GetExRamSizeReal())
+    return false;
+
+  address &= 0x3FFFFFFF;
+  if ((address & 0xF8000000) == 0)
+    address &= GetRamMask();
+  return GetWriteTrackingPage(address, first_page) &&
+         GetWriteTrackingPage(address + u32(size) - 1, last_page) && *first_page <= *last_page;
+}
+
+static u32 GetWriteTrackingPageAddress(u32 page)
+{
+  const u32 offset = page << WRITE_TRACKING_PAGE_SHIFT;
+  if (offset < GetRamSize())
+    return offset;
+  return 0x10000000 | (offset - GetRamSize());
+}
+
+static void SetHostMemoryWritable(void* pointer, size_t size, bool writable)
+{
+#ifdef _WIN32
+  DWORD old_protection;
+  if (!VirtualProtect(pointer, size, writable ? PAGE_READWRITE : PAGE_READONLY, &old_protection))
+    ERROR_LOG_FMT(MEMMAP, "VirtualProtect failed: {}", GetLastErrorString());
+#else
+  if (mprotect(pointer, size, writable ? PROT_READ | PROT_WRITE : PROT_READ) != 0)
+    ERROR_LOG_FMT(MEMMAP, "mprotect failed: {}", LastStrerrorString());
+#endif
+}
+
+// Changes the protection of a run of pages in every view of the fastmem arena which maps them.
+// Only the arena has to be protected, everything else accesses RAM through m_pRAM and m_pEXRAM.
+static void SetPagesWritable(u32 first_page, u32 last_page, bool writable)
+{
+  if (!is_fastmem_arena_initialized)
+    return;
+
+  const u32 start = GetWriteTrackingPageAddress(first_page);
+  const u32 end = GetWriteTrackingPageAddress(last_page) + WRITE_TRACKING_PAGE_SIZE;
+  SetHostMemoryWritable(physical_base + start, end - start, writable);
+
+  for (const LogicalMemoryView& view : logical_mapped_entries)
+  {
+    const u32 intersection_start = std::max(view.physical_address, start);
+    const u32 intersection_end = std::min(view.physical_address + view.mapped_size, end);
+    if (intersection_start < intersection_end)
+    {
+      SetHostMemoryWritable(static_cast<u8*>(view.mapped_pointer) + intersection_start -
+                                view.physical_address,
+                            intersection_end - intersection_start, writable);
+    }
+  }
+}
+
+// Has to be called with s_write_tracking_mutex held.
+static void StopTrackingAllPages()
+{
+  if (!s_write_tracking_enabled)
+    return;
+
+  const u32 mem1_pages = GetRamSize() >> WRITE_TRACKING_PAGE_SHIFT;
+  if (mem1_pages != 0)
+    SetPagesWritable(0, mem1_pages - 1, true);
+  if (s_write_tracking_page_count > mem1_pages)
+    SetPagesWritable(mem1_pages, s_write_tracking_page_count - 1, true);
+
+  for (u32 page = 0; page < s_write_tracking_page_count; ++page)
+    s_page_write_stamps[page] = UNTRACKED_PAGE;
+}
+
+// Stops tracking every page, for when RAM was changed without being able to tell where.
+static void ResetWriteTracking()
+{
+  std::lock_guard lock(s_write_tracking_mutex);
+  StopTrackingAllPages();
+}
+
+bool IsWriteTrackingEnabled()
+{
+  return s_write_tracking_enabled;
+}
+
+u64 TrackWrites(u32 address, size_t size)
+{
+  u32 first_page, last_page;
+  if (!s_write_tracking_enabled || !GetWriteTrackingPages(address, size, &first_page, &last_page))
+    return 0;
+
+  std::lock_guard lock(s_write_tracking_mutex);
+  const u64 current_stamp = s_write_stamp.load();
+  u32 page = first_page;
+  while (page <= last_page)
+  {
+    if (s_page_write_stamps[page].load() != UNTRACKED_PAGE)
+    {
+      ++page;
+      continue;
+    }
+
+    // Protect runs of untracked pages with as few calls as possible.
+    u32 run_end = page;
+    while (run_end < last_page && s_page_write_stamps[run_end + 1].load() == UNTRACKED_PAGE)
+      ++run_end;
+
+    SetPagesWritable(page, run_end, false);
+    for (; page <= run_end; ++page)
+      s_page_write_stamps[page] = current_stamp;
+  }
+
+  // Anything written from now on gets a stamp at least as new as the returned one.
+  return ++s_write_stamp;
+}
+
+bool WasWrittenSince(u32 address, size_t size, u64 stamp)
+{
+  u32 first_page, last_page;
+  if (stamp == 0 || !s_write_tracking_enabled ||
+      !GetWriteTrackingPages(address, size, &first_page, &last_page))
+    return true;
+
+  for (u32 page = first_page; page <= last_page; ++page)
+  {
+    if (s_page_write_stamps[page].load() >= stamp)
+      return true;
+  }
+  return false;
+}
+
+void MarkWritten(u32 address, size_t size)
+{
+  u32 first_page, last_page;
+  if (!s_write_tracking_enabled || !GetWriteTrackingPages(address, size, &first_page, &last_page))
+    return;
+
+  // The stamp has to be read after the data was written, so that a stamp which was handed out
+  // before the data was visible can't be newer than the stamp of the page.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const u64 stamp = s_write_stamp.load();
+  for (u32 page = first_page; page <= last_page; ++page)
+  {
+    std::atomic<u64>& page_stamp = s_page_write_stamps[page];
+    u64 expected = page_stamp.load();
+    while (expected < stamp && !page_stamp.compare_exchange_weak(expected, stamp))
+    {
+    }
+  }
+}
+
+bool HandleWriteTrackingFault(uintptr_t fault_address)
+{
+  if (!s_write_tracking_enabled || !is_fastmem_arena_initialized)
+    return false;
+
+  u32 address;
+  const uintptr_t physical_offset = fault_address - reinterpret_cast<uintptr_t>(physical_base);
+  const uintptr_t logical_offset = fault_address - reinterpret_cast<uintptr_t>(logical_base);
+  if (physical_offset < 0x100000000)
+  {
+    address = static_cast<u32>(physical_offset);
+  }
+  else if (logical_base && logical_offset < 0x100000000)
+  {
+    address = static_cast<u32>(logical_offset);
+    const u32 bat_result = PowerPC::dbat_table[address >> PowerPC::BAT_INDEX_SHIFT];
+    if (!(bat_result & PowerPC::BAT_PHYSICAL_BIT))
+      return false;
+    address = (bat_result & PowerPC::BAT_RESULT_MASK) | (address & (PowerPC::BAT_PAGE_SIZE - 1));
+  }
+  else
+  {
+    return false;
+  }
+
+  u32 page;
+  if (!GetWriteTrackingPage(address, &page))
+    return false;
+
+  // RAM in the arena can only fault because of write tracking. If the page isn't tracked anymore,
+  // another thread got here first and the store only has to be retried.
+  std::lock_guard lock(s_write_tracking_mutex);
+  if (s_page_write_stamps[page].load() != UNTRACKED_PAGE)
+  {
+    SetPagesWritable(page, page, true);
+    s_page_write_stamps[page] = UNTRACKED_PAGE;
+  }
+  return true;
 }
 
 }  // namespace Memory
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -89,6 +91,20 @@ void Write_U64(u64 var, u32 address);
 void Write_U32_Swap(u32 var, u32 address);
 void Write_U64_Swap(u64 var, u32 address);
 
+// Write tracking lets users of guest memory, like the texture cache, find out whether a range of
+// RAM was written to since they last looked at it, instead of hashing it again. Tracked pages are
+// write-protected in the fastmem arena, so CPU stores through it fault once per page. All other
+// writers of RAM have to call MarkWritten after writing. Addresses are physical, as for GetPointer.
+bool IsWriteTrackingEnabled();
+// Starts tracking writes to the range, and returns a stamp for WasWrittenSince. Returns 0 if the
+// range can't be tracked, which WasWrittenSince always treats as written.
+u64 TrackWrites(u32 address, size_t size);
+bool WasWrittenSince(u32 address, size_t size, u64 stamp);
+void MarkWritten(u32 address, size_t size);
+// Called for faults on host addresses in the fastmem arena. Returns true if the fault was caused by
+// a store to a tracked page, which is then made writable again so that the store can be retried.
+bool HandleWriteTrackingFault(uintptr_t fault_address);
+
 // Templated functions for byteswapped copies.
 template <typename T>
 void CopyFromEmuSwapped(T* data, u32 address, size_t size)
@@ -112,5 +128,7 @@ void CopyToEmuSwapped(u32 address, const T* data, size_t size)
 
   for (size_t i = 0; i < size / sizeof(T); i++)
     dest[i] = Common::FromBigEndian(data[i]);
+
+  MarkWritten(address, size);
 }
 }  // namespace Memory
@@ -654,8 +654,12 @@ std::optional<IPCReply> Kernel::HandleIPCCommand(const Request& request)
     ret = device->Close(request.fd);
     break;
   case IPC_CMD_READ:
-    ret = device->Read(ReadWriteRequest{request.address});
+  {
+    const ReadWriteRequest read_request{request.address};
+    ret = device->Read(read_request);
+    Memory::MarkWritten(read_request.buffer, read_request.size);
     break;
+  }
   case IPC_CMD_WRITE:
     ret = device->Write(ReadWriteRequest{request.address});
     break;
@@ -663,11 +667,21 @@ std::optional<IPCReply> Kernel::HandleIPCCommand(const Request& request)
     ret = device->Seek(SeekRequest{request.address});
     break;
   case IPC_CMD_IOCTL:
-    ret = device->IOCtl(IOCtlRequest{request.address});
+  {
+    const IOCtlRequest ioctl_request{request.address};
+    ret = device->IOCtl(ioctl_request);
+    Memory::MarkWritten(ioctl_request.buffer_out, ioctl_request.buffer_out_size);
     break;
+  }
   case IPC_CMD_IOCTLV:
-    ret = device->IOCtlV(IOCtlVRequest{request.address});
+  {
+    // Devices write their output straight to guest memory, which write tracking can't see.
+    const IOCtlVRequest ioctlv_request{request.address};
+    ret = device->IOCtlV(ioctlv_request);
+    for (const IOCtlVRequest::IOVector& vector : ioctlv_request.io_vectors)
+      Memory::MarkWritten(vector.address, vector.size);
     break;
+  }
   default:
     ASSERT_MSG(IOS, false, "Unexpected command: %x", request.command);
     ret = IPCReply{IPC_EINVAL, 978_tbticks};
@@ -76,13 +76,13 @@ u8* CachedInterpreter::GetCodePtr()
   return reinterpret_cast<u8*>(m_code.data() + m_code.size());
 }
 
-void CachedInterpreter::ExecuteOneBlock()
+bool CachedInterpreter::ExecuteOneBlock()
 {
   const u8* normal_entry = m_block_cache.Dispatch();
   if (!normal_entry)
   {
     Jit(PC);
-    return;
+    return false;
   }
 
   const Instruction* code = reinterpret_cast<const Instruction*>(normal_entry);
@@ -97,7 +97,7 @@ void CachedInterpreter::ExecuteOneBlock()
 
     case Instruction::Type::Conditional:
       if (code->conditional_callback(code->data))
-        return;
+        return true;
       break;
 
     default:
@@ -105,6 +105,8 @@ void CachedInterpreter::ExecuteOneBlock()
       break;
     }
   }
+
+  return true;
 }
 
 void CachedInterpreter::Run()
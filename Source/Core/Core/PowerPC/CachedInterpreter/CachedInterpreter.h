@@ -28,6 +28,9 @@ public:
 
   void Jit(u32 address) override;
 
+  // Runs the block at PC. If the block has to be built first, only builds it and returns false.
+  bool ExecuteOneBlock();
+
   JitBaseBlockCache* GetBlockCache() override { return &m_block_cache; }
   const char* GetName() const override { return "Cached Interpreter"; }
   const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
@@ -36,7 +39,6 @@ private:
   struct Instruction;
 
   u8* GetCodePtr();
-  void ExecuteOneBlock();
 
   bool HandleFunctionHooking(u32 address);
 
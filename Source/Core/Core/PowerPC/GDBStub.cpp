@@ -620,6 +620,7 @@ static void gdb_write_mem()
   if (!dst)
     return gdb_reply("E00");
   hex2mem(dst, cmd_bfr + i + 1, len);
+  Memory::MarkWritten(addr, len);
   gdb_reply("OK");
 }
 
@@ -372,6 +372,7 @@ void Jit64::Init()
   // it'll crash because the farcode functions get cleared on JIT clears.
   m_far_code.Init();
   Clear();
+  InitInterpreterTier();
 
   code_block.m_stats = &js.st;
   code_block.m_gpa = &js.gpa;
@@ -392,6 +393,8 @@ void Jit64::ClearCache()
   Clear();
   UpdateMemoryOptions();
   ResetFreeMemoryRanges();
+  m_branch_profiles.clear();
+  analyzer.ClearHotBranches();
 }
 
 void Jit64::ResetFreeMemoryRanges()
@@ -405,6 +408,7 @@ void Jit64::ResetFreeMemoryRanges()
 
 void Jit64::Shutdown()
 {
+  ShutdownInterpreterTier();
   FreeStack();
   FreeCodeSpace();
 
@@ -745,10 +749,19 @@ void Jit64::Trace()
 
 void Jit64::Jit(u32 em_address)
 {
-  Jit(em_address, true);
+  blocks.CompilePersistentCacheBlocks(em_address);
+  if (ExecuteInInterpreterTier(em_address))
+    return;
+
+  Jit(em_address, true, false);
 }
 
-void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
+void Jit64::Precompile(u32 em_address)
+{
+  Jit(em_address, true, true);
+}
+
+void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure, bool precompile)
 {
   if (m_cleanup_after_stackfault)
   {
@@ -799,6 +812,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
         analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+        analyzer.ClearOption(PPCAnalyst::PPCAnalyzer::OPTION_HOT_BRANCH_FOLLOW);
       }
       Trace();
     }
@@ -811,6 +825,10 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
 
   if (code_block.m_memory_exception)
   {
+    // Nothing is executing this address yet, so there is no exception to raise.
+    if (precompile)
+      return;
+
     // Address of instruction could not be translated
     NPC = nextPC;
     PowerPC::ppcState.Exceptions |= EXCEPTION_ISI;
@@ -855,7 +873,7 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     // Clear the entire JIT cache and retry.
     WARN_LOG_FMT(POWERPC, "flushing code caches, please report if this happens a lot");
     ClearCache();
-    Jit(em_address, false);
+    Jit(em_address, false, precompile);
     return;
   }
 
@@ -1241,6 +1259,7 @@ void Jit64::EnableOptimization()
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CROR_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_CARRY_MERGE);
   analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_BRANCH_FOLLOW);
+  analyzer.SetOption(PPCAnalyst::PPCAnalyzer::OPTION_HOT_BRANCH_FOLLOW);
 }
 
 void Jit64::IntializeSpeculativeConstants()
@@ -18,6 +18,8 @@
 // ----------
 #pragma once
 
+#include <unordered_map>
+
 #include <rangeset/rangesizeset.h>
 
 #include "Common/CommonTypes.h"
@@ -58,7 +60,8 @@ public:
   // Jit!
 
   void Jit(u32 em_address) override;
-  void Jit(u32 em_address, bool clear_cache_and_retry_on_failure);
+  void Jit(u32 em_address, bool clear_cache_and_retry_on_failure, bool precompile);
+  void Precompile(u32 em_address) override;
   bool DoJit(u32 em_address, JitBlock* b, u32 nextPC);
 
   // Finds a free memory region and sets the near and far code emitters to point at that region.
@@ -110,6 +113,12 @@ public:
   void DoMergedBranchCondition();
   void DoMergedBranchImmediate(s64 val);
 
+  // Counts how often a conditional branch leaves the block, so that branches which are usually
+  // taken can be followed (and stop being followed if they turn out not to be).
+  void WriteBranchExitCounter(const PPCAnalyst::CodeOp& op);
+  // Counts how often a followed branch stays on the followed path.
+  void WriteBranchFollowCounter(const PPCAnalyst::CodeOp& op);
+
   // Reads a given bit of a given CR register part.
   void GetCRFieldBit(int field, int bit, Gen::X64Reg out, bool negate = false);
   // Clobbers RDX.
@@ -254,6 +263,21 @@ private:
 
   void ResetFreeMemoryRanges();
 
+  struct BranchProfile
+  {
+    // Exits where the branch was taken while it wasn't followed
+    u32 taken_exits = 0;
+    // Exits where the branch wasn't taken while it was followed
+    u32 side_exits = 0;
+    // Runs where the branch was taken while it was followed
+    u64 followed_runs = 0;
+    bool is_blacklisted = false;
+  };
+
+  BranchProfile* GetBranchProfile(const PPCAnalyst::CodeOp& op);
+
+  static void OnHotBranchExit(Jit64& jit, u32 branch_address);
+
   JitBlockCache blocks{*this};
   TrampolineCache trampolines{*this};
 
@@ -268,6 +292,10 @@ private:
 
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_near;
   HyoutaUtilities::RangeSizeSet<u8*> m_free_ranges_far;
+
+  // Indexed by the address translation bits of MSR and the branch address, like the blocks.
+  // Emitted code points into the profiles, so they are only freed when the whole cache is cleared.
+  std::unordered_map<u64, BranchProfile> m_branch_profiles;
 };
 
 void LogGeneratedX86(size_t size, const PPCAnalyst::CodeBuffer& code_buffer, const u8* normalEntry,
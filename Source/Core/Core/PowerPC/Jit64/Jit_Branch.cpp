@@ -5,6 +5,7 @@
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/x64Emitter.h"
+#include "Core/ConfigManager.h"
 #include "Core/CoreTiming.h"
 #include "Core/PowerPC/Gekko.h"
 #include "Core/PowerPC/Jit64/Jit.h"
@@ -26,6 +27,93 @@
 
 using namespace Gen;
 
+// Number of exits after which a conditional branch starts being followed, and after which a
+// followed branch is checked for how often it leaves through its side exit.
+constexpr u32 HOT_BRANCH_THRESHOLD = 1024;
+
+// A followed branch is blacklisted if more than one in this many runs leave through the side exit.
+constexpr u64 SIDE_EXIT_RATIO = 8;
+
+static u64 GetBranchProfileKey(u32 msr, u32 address)
+{
+  return u64{msr & JitBaseBlockCache::JIT_CACHE_MSR_MASK} << 32 | address;
+}
+
+Jit64::BranchProfile* Jit64::GetBranchProfile(const PPCAnalyst::CodeOp& op)
+{
+  const UGeckoInstruction inst = op.inst;
+  if (!analyzer.HasOption(PPCAnalyst::PPCAnalyzer::OPTION_HOT_BRANCH_FOLLOW) ||
+      !SConfig::GetInstance().bJITFollowBranch || inst.OPCD != 16 || inst.LK ||
+      op.branchIsIdleLoop ||
+      ((inst.BO & BO_DONT_DECREMENT_FLAG) && (inst.BO & BO_DONT_CHECK_CONDITION)))
+  {
+    return nullptr;
+  }
+
+  BranchProfile& profile = m_branch_profiles[GetBranchProfileKey(MSR.Hex, op.address)];
+  if (profile.is_blacklisted)
+    return nullptr;
+
+  return &profile;
+}
+
+void Jit64::WriteBranchExitCounter(const PPCAnalyst::CodeOp& op)
+{
+  BranchProfile* profile = GetBranchProfile(op);
+  if (!profile)
+    return;
+
+  u32* counter = op.branchIsFollowed ? &profile->side_exits : &profile->taken_exits;
+  MOV(64, R(RSCRATCH), ImmPtr(counter));
+  ADD(32, MatR(RSCRATCH), Imm8(1));
+  CMP(32, MatR(RSCRATCH), Imm32(HOT_BRANCH_THRESHOLD));
+  FixupBranch not_hot = J_CC(CC_NE);
+  ABI_PushRegistersAndAdjustStack({}, 0);
+  ABI_CallFunctionPC(OnHotBranchExit, this, op.address);
+  ABI_PopRegistersAndAdjustStack({}, 0);
+  SetJumpTarget(not_hot);
+}
+
+void Jit64::WriteBranchFollowCounter(const PPCAnalyst::CodeOp& op)
+{
+  if (!op.branchIsFollowed)
+    return;
+
+  BranchProfile* profile = GetBranchProfile(op);
+  if (!profile)
+    return;
+
+  MOV(64, R(RSCRATCH), ImmPtr(&profile->followed_runs));
+  ADD(64, MatR(RSCRATCH), Imm8(1));
+}
+
+void Jit64::OnHotBranchExit(Jit64& jit, u32 branch_address)
+{
+  // The exit belongs to a block which was compiled for the current address translation bits.
+  const u32 msr = MSR.Hex;
+  BranchProfile& profile = jit.m_branch_profiles[GetBranchProfileKey(msr, branch_address)];
+
+  if (profile.side_exits != 0)
+  {
+    // A followed branch which often leaves through its side exit isn't as biased as it looked,
+    // so it goes back to being a regular branch for good. Otherwise, start counting anew.
+    const u64 runs = profile.side_exits + profile.followed_runs;
+    if (profile.side_exits * SIDE_EXIT_RATIO <= runs)
+    {
+      profile.side_exits = 0;
+      profile.followed_runs = 0;
+      return;
+    }
+    profile.is_blacklisted = true;
+  }
+
+  jit.analyzer.SetHotBranch(msr, branch_address, !profile.is_blacklisted);
+
+  // Recompile every block containing the branch. The block which is currently running is among
+  // them, so they are only replaced once the dispatcher gets to them.
+  jit.blocks.RequestRecompilation(branch_address, msr);
+}
+
 void Jit64::sc(UGeckoInstruction inst)
 {
   INSTRUCTION_START
@@ -131,6 +219,30 @@ void Jit64::bcx(UGeckoInstruction inst)
   if (inst.LK)
     MOV(32, PPCSTATE_LR, Imm32(js.compilerPC + 4));
 
+  // If the branch was followed, the block continues at the branch target and
+  // the path where the branch isn't taken becomes the exit.
+  if (js.op->branchIsFollowed)
+  {
+    SwitchToFarCode();
+    if ((inst.BO & BO_DONT_CHECK_CONDITION) == 0)
+      SetJumpTarget(pConditionDontBranch);
+    if ((inst.BO & BO_DONT_DECREMENT_FLAG) == 0)
+      SetJumpTarget(pCTRDontBranch);
+
+    {
+      RCForkGuard gpr_guard = gpr.Fork();
+      RCForkGuard fpr_guard = fpr.Fork();
+      gpr.Flush();
+      fpr.Flush();
+      WriteBranchExitCounter(*js.op);
+      WriteExit(js.compilerPC + 4);
+    }
+
+    SwitchToNearCode();
+    WriteBranchFollowCounter(*js.op);
+    return;
+  }
+
   // If this is not the last instruction of a block
   // and an unconditional branch, we will skip the rest process.
   // Because PPCAnalyst::Flatten() merged the blocks.
@@ -159,6 +271,7 @@ void Jit64::bcx(UGeckoInstruction inst)
     }
     else
     {
+      WriteBranchExitCounter(*js.op);
       WriteExit(js.op->branchTo, inst.LK, js.compilerPC + 4);
     }
   }
@@ -4,6 +4,8 @@
 
 #include "Core/PowerPC/Jit64Common/EmuCodeBlock.h"
 
+#include <array>
+#include <cstddef>
 #include <functional>
 #include <limits>
 
@@ -36,6 +38,9 @@ OpArg SwapImmediate(int access_size, const OpArg& reg_value)
   return Imm8(reg_value.Imm8());
 }
 
+// log2(sizeof(PowerPC::SoftTLBEntry))
+constexpr u32 SOFT_TLB_ENTRY_SHIFT = 4;
+
 OpArg FixImmediate(int access_size, OpArg arg)
 {
   if (arg.IsImm())
@@ -121,6 +126,60 @@ FixupBranch EmuCodeBlock::CheckIfSafeAddress(const OpArg& reg_value, X64Reg reg_
   return J_CC(CC_Z, m_far_code.Enabled());
 }
 
+FixupBranch EmuCodeBlock::SoftTLBAccess(X64Reg reg_addr, int access_size, bool write,
+                                        BitSet32 registers_in_use, BitSet32 reserved,
+                                        const std::function<void(const OpArg&)>& access)
+{
+  static_assert(sizeof(PowerPC::SoftTLBEntry) == 1 << SOFT_TLB_ENTRY_SHIFT);
+
+  reserved[reg_addr] = true;
+  std::array<X64Reg, 2> scratch;
+  size_t num_scratch = 0;
+  for (X64Reg reg : {RSCRATCH, RSCRATCH_EXTRA, RSCRATCH2, R8})
+  {
+    if (!reserved[reg] && num_scratch < scratch.size())
+      scratch[num_scratch++] = reg;
+  }
+  const X64Reg entry = scratch[0];
+  const X64Reg tmp = scratch[1];
+
+  const bool save_entry = registers_in_use[entry];
+  const bool save_tmp = registers_in_use[tmp];
+  if (save_entry)
+    PUSH(entry);
+  if (save_tmp)
+    PUSH(tmp);
+
+  // The entry is picked by the page of the first byte, but the tag is compared with the page of the
+  // last byte, so that accesses crossing a page boundary always miss.
+  const PowerPC::SoftTLB& tlb = write ? PowerPC::soft_tlb_write : PowerPC::soft_tlb_read;
+  MOV(32, R(tmp), R(reg_addr));
+  SHR(32, R(tmp), Imm8(PowerPC::SOFT_TLB_PAGE_SHIFT - SOFT_TLB_ENTRY_SHIFT));
+  AND(32, R(tmp), Imm32((PowerPC::SOFT_TLB_SIZE - 1) << SOFT_TLB_ENTRY_SHIFT));
+  MOV(64, R(entry), ImmPtr(tlb.data()));
+  ADD(64, R(entry), R(tmp));
+  LEA(32, tmp, MDisp(reg_addr, access_size / 8 - 1));
+  AND(32, R(tmp), Imm32(~PowerPC::SOFT_TLB_PAGE_MASK));
+  CMP(32, R(tmp), MDisp(entry, offsetof(PowerPC::SoftTLBEntry, tag)));
+  FixupBranch miss = J_CC(CC_NE);
+
+  MOV(64, R(entry), MDisp(entry, offsetof(PowerPC::SoftTLBEntry, host_base)));
+  ADD(64, R(entry), R(reg_addr));
+  access(MatR(entry));
+
+  const auto restore = [&] {
+    if (save_tmp)
+      POP(tmp);
+    if (save_entry)
+      POP(entry);
+  };
+  restore();
+  FixupBranch hit = J(true);
+  SetJumpTarget(miss);
+  restore();
+  return hit;
+}
+
 void EmuCodeBlock::UnsafeLoadRegToReg(X64Reg reg_addr, X64Reg reg_value, int accessSize, s32 offset,
                                       bool signExtend)
 {
@@ -139,6 +198,12 @@ void EmuCodeBlock::UnsafeLoadRegToRegNoSwap(X64Reg reg_addr, X64Reg reg_value, i
 
 void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int accessSize, s32 offset,
                                        bool swap, MovInfo* info)
+{
+  WriteRegToAddress(reg_value, MComplex(RMEM, reg_addr, SCALE_1, offset), accessSize, swap, info);
+}
+
+void EmuCodeBlock::WriteRegToAddress(OpArg reg_value, const OpArg& dest, int accessSize, bool swap,
+                                     MovInfo* info)
 {
   if (info)
   {
@@ -146,7 +211,6 @@ void EmuCodeBlock::UnsafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acc
     info->nonAtomicSwapStore = false;
   }
 
-  OpArg dest = MComplex(RMEM, reg_addr, SCALE_1, offset);
   if (reg_value.IsImm())
   {
     if (swap)
@@ -386,6 +450,19 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     SetJumpTarget(slow);
   }
 
+  FixupBranch soft_tlb_hit;
+  // Asm routines are shared by all blocks and aren't regenerated when watchpoints are added.
+  const bool soft_tlb = dr_set && m_jit.jo.soft_tlb && !(flags & SAFE_LOADSTORE_NO_UPDATE_PC);
+  if (soft_tlb)
+  {
+    BitSet32 reserved;
+    reserved[reg_value] = true;
+    soft_tlb_hit = SoftTLBAccess(reg_addr, accessSize, false, registersInUse, reserved,
+                                 [&](const OpArg& src) {
+                                   LoadAndSwap(accessSize, reg_value, src, signExtend);
+                                 });
+  }
+
   // Helps external systems know which instruction triggered the read.
   // Invalid for calls from Jit64AsmCommon routines
   if (!(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
@@ -423,6 +500,9 @@ void EmuCodeBlock::SafeLoadToReg(X64Reg reg_value, const Gen::OpArg& opAddress,
     MOVZX(64, accessSize, reg_value, R(ABI_RETURN));
   }
 
+  if (soft_tlb)
+    SetJumpTarget(soft_tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
@@ -554,6 +634,20 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
     SetJumpTarget(slow);
   }
 
+  FixupBranch soft_tlb_hit;
+  const bool soft_tlb =
+      dr_set && m_jit.jo.soft_tlb_writes && !(flags & SAFE_LOADSTORE_NO_UPDATE_PC);
+  if (soft_tlb)
+  {
+    BitSet32 reserved;
+    if (reg_value.IsSimpleReg())
+      reserved[reg_value.GetSimpleReg()] = true;
+    soft_tlb_hit = SoftTLBAccess(reg_addr, accessSize, true, registersInUse, reserved,
+                                 [&](const OpArg& dest) {
+                                   WriteRegToAddress(reg_value, dest, accessSize, swap, nullptr);
+                                 });
+  }
+
   // PC is used by memory watchpoints (if enabled) or to print accurate PC locations in debug logs
   // Invalid for calls from Jit64AsmCommon routines
   if (!(flags & SAFE_LOADSTORE_NO_UPDATE_PC))
@@ -595,6 +689,9 @@ void EmuCodeBlock::SafeWriteRegToReg(OpArg reg_value, X64Reg reg_addr, int acces
 
   MemoryExceptionCheck();
 
+  if (soft_tlb)
+    SetJumpTarget(soft_tlb_hit);
+
   if (fast_check_address)
   {
     if (m_far_code.Enabled())
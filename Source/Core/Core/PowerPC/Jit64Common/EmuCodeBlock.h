@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <functional>
 #include <unordered_map>
 
 #include "Common/BitSet.h"
@@ -52,6 +53,12 @@ public:
 
   Gen::FixupBranch CheckIfSafeAddress(const Gen::OpArg& reg_value, Gen::X64Reg reg_addr,
                                       BitSet32 registers_in_use);
+  // Looks reg_addr up in the software TLB. On a hit, access is called with the host address of
+  // the data and the returned branch is taken, so it should be bound after the slow path. Misses
+  // fall through with all registers preserved. Registers in reserved aren't used as scratch.
+  Gen::FixupBranch SoftTLBAccess(Gen::X64Reg reg_addr, int access_size, bool write,
+                                 BitSet32 registers_in_use, BitSet32 reserved,
+                                 const std::function<void(const Gen::OpArg&)>& access);
   void UnsafeLoadRegToReg(Gen::X64Reg reg_addr, Gen::X64Reg reg_value, int accessSize,
                           s32 offset = 0, bool signExtend = false);
   void UnsafeLoadRegToRegNoSwap(Gen::X64Reg reg_addr, Gen::X64Reg reg_value, int accessSize,
@@ -129,6 +136,9 @@ public:
 
 protected:
   Jit64& m_jit;
+  void WriteRegToAddress(Gen::OpArg reg_value, const Gen::OpArg& dest, int accessSize, bool swap,
+                         Gen::MovInfo* info);
+
   ConstantPool m_const_pool;
   FarCodeCache m_far_code;
 
@@ -69,6 +69,8 @@ void JitArm64::Init()
 
   AllocStack();
   GenerateAsm();
+
+  InitInterpreterTier();
 }
 
 bool JitArm64::HandleFault(uintptr_t access_address, SContext* ctx)
@@ -137,6 +139,7 @@ void JitArm64::ClearCache()
 
 void JitArm64::Shutdown()
 {
+  ShutdownInterpreterTier();
   Memory::ShutdownFastmemArena();
   FreeCodeSpace();
   blocks.Shutdown();
@@ -584,7 +587,21 @@ void JitArm64::SingleStep()
   pExecAddr();
 }
 
-void JitArm64::Jit(u32)
+void JitArm64::Jit(u32 em_address)
+{
+  blocks.CompilePersistentCacheBlocks(em_address);
+  if (ExecuteInInterpreterTier(em_address))
+    return;
+
+  Jit(em_address, false);
+}
+
+void JitArm64::Precompile(u32 em_address)
+{
+  Jit(em_address, true);
+}
+
+void JitArm64::Jit(u32 em_address, bool precompile)
 {
   if (m_cleanup_after_stackfault)
   {
@@ -603,7 +620,6 @@ void JitArm64::Jit(u32)
   const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
 
   std::size_t block_size = m_code_buffer.size();
-  const u32 em_address = PowerPC::ppcState.pc;
 
   if (SConfig::GetInstance().bEnableDebugging)
   {
@@ -618,6 +634,10 @@ void JitArm64::Jit(u32)
 
   if (code_block.m_memory_exception)
   {
+    // Nothing is executing this address yet, so there is no exception to raise.
+    if (precompile)
+      return;
+
     // Address of instruction could not be translated
     NPC = nextPC;
     PowerPC::ppcState.Exceptions |= EXCEPTION_ISI;
@@ -40,7 +40,9 @@ public:
   void Run() override;
   void SingleStep() override;
 
-  void Jit(u32) override;
+  void Jit(u32 em_address) override;
+  void Jit(u32 em_address, bool precompile);
+  void Precompile(u32 em_address) override;
 
   const char* GetName() const override { return "JITARM64"; }
 
@@ -177,11 +179,12 @@ protected:
     BitSet32 gprs;
     BitSet32 fprs;
     u32 flags;
+    bool soft_tlb;
 
     bool operator<(const SlowmemHandler& rhs) const
     {
-      return std::tie(dest_reg, addr_reg, gprs, fprs, flags) <
-             std::tie(rhs.dest_reg, rhs.addr_reg, rhs.gprs, rhs.fprs, rhs.flags);
+      return std::tie(dest_reg, addr_reg, gprs, fprs, flags, soft_tlb) <
+             std::tie(rhs.dest_reg, rhs.addr_reg, rhs.gprs, rhs.fprs, rhs.flags, rhs.soft_tlb);
     }
   };
 
@@ -225,6 +228,9 @@ protected:
   void SafeLoadToReg(u32 dest, s32 addr, s32 offsetReg, u32 flags, s32 offset, bool update);
   void SafeStoreFromReg(s32 dest, u32 value, s32 regOffset, u32 flags, s32 offset);
 
+  // Calls PowerPC::ppcState.SetSR with the index in W0 and the value in W1
+  void CallSetSR();
+
   void DoJit(u32 em_address, JitBlock* b, u32 nextPC);
 
   void DoDownCount();
@@ -2,6 +2,7 @@
 // Licensed under GPLv2+
 // Refer to the license.txt file included.
 
+#include <array>
 #include <cinttypes>
 #include <cstddef>
 #include <string>
@@ -10,6 +11,7 @@
 #include "Common/CommonFuncs.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/MathUtil.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 
@@ -21,6 +23,9 @@
 
 using namespace Arm64Gen;
 
+// log2(sizeof(PowerPC::SoftTLBEntry))
+constexpr u32 SOFT_TLB_ENTRY_SHIFT = 4;
+
 void JitArm64::DoBacktrace(uintptr_t access_address, SContext* ctx)
 {
   for (int i = 0; i < 30; i += 2)
@@ -56,36 +61,36 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
   bool in_far_code = false;
   const u8* fastmem_start = GetCodePtr();
 
-  if (fastmem)
-  {
+  // Emits the access itself, with the host address being base + addr.
+  const auto emit_access = [&](ARM64Reg base) {
     if (flags & BackPatchInfo::FLAG_STORE && flags & BackPatchInfo::FLAG_MASK_FLOAT)
     {
       if (flags & BackPatchInfo::FLAG_SIZE_F32)
       {
         m_float_emit.REV32(8, ARM64Reg::D0, RS);
-        m_float_emit.STR(32, ARM64Reg::D0, MEM_REG, addr);
+        m_float_emit.STR(32, ARM64Reg::D0, base, addr);
       }
       else if (flags & BackPatchInfo::FLAG_SIZE_F32X2)
       {
         m_float_emit.REV32(8, ARM64Reg::D0, RS);
-        m_float_emit.STR(64, ARM64Reg::Q0, MEM_REG, addr);
+        m_float_emit.STR(64, ARM64Reg::Q0, base, addr);
       }
       else
       {
         m_float_emit.REV64(8, ARM64Reg::Q0, RS);
-        m_float_emit.STR(64, ARM64Reg::Q0, MEM_REG, addr);
+        m_float_emit.STR(64, ARM64Reg::Q0, base, addr);
       }
     }
     else if (flags & BackPatchInfo::FLAG_LOAD && flags & BackPatchInfo::FLAG_MASK_FLOAT)
     {
       if (flags & BackPatchInfo::FLAG_SIZE_F32)
       {
-        m_float_emit.LDR(32, EncodeRegToDouble(RS), MEM_REG, addr);
+        m_float_emit.LDR(32, EncodeRegToDouble(RS), base, addr);
         m_float_emit.REV32(8, EncodeRegToDouble(RS), EncodeRegToDouble(RS));
       }
       else
       {
-        m_float_emit.LDR(64, EncodeRegToDouble(RS), MEM_REG, addr);
+        m_float_emit.LDR(64, EncodeRegToDouble(RS), base, addr);
         m_float_emit.REV64(8, EncodeRegToDouble(RS), EncodeRegToDouble(RS));
       }
     }
@@ -98,27 +103,27 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
         REV16(temp, RS);
 
       if (flags & BackPatchInfo::FLAG_SIZE_32)
-        STR(temp, MEM_REG, addr);
+        STR(temp, base, addr);
       else if (flags & BackPatchInfo::FLAG_SIZE_16)
-        STRH(temp, MEM_REG, addr);
+        STRH(temp, base, addr);
       else
-        STRB(RS, MEM_REG, addr);
+        STRB(RS, base, addr);
     }
     else if (flags & BackPatchInfo::FLAG_ZERO_256)
     {
       // This literally only stores 32bytes of zeros to the target address
-      ADD(addr, addr, MEM_REG);
+      ADD(addr, addr, base);
       STP(IndexType::Signed, ARM64Reg::ZR, ARM64Reg::ZR, addr, 0);
       STP(IndexType::Signed, ARM64Reg::ZR, ARM64Reg::ZR, addr, 16);
     }
     else
     {
       if (flags & BackPatchInfo::FLAG_SIZE_32)
-        LDR(RS, MEM_REG, addr);
+        LDR(RS, base, addr);
       else if (flags & BackPatchInfo::FLAG_SIZE_16)
-        LDRH(RS, MEM_REG, addr);
+        LDRH(RS, base, addr);
       else if (flags & BackPatchInfo::FLAG_SIZE_8)
-        LDRB(RS, MEM_REG, addr);
+        LDRB(RS, base, addr);
 
       if (!(flags & BackPatchInfo::FLAG_REVERSE))
       {
@@ -131,11 +136,34 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
       if (flags & BackPatchInfo::FLAG_EXTEND)
         SXTH(RS, RS);
     }
-  }
+  };
+
+  if (fastmem)
+    emit_access(MEM_REG);
   const u8* fastmem_end = GetCodePtr();
 
   if (!fastmem || do_farcode)
   {
+    // The slow path calls into C++, which clobbers every caller saved register that isn't pushed,
+    // so any of those which doesn't hold an input can be used by the software TLB lookup.
+    std::array<ARM64Reg, 3> scratch;
+    size_t num_scratch = 0;
+    for (int i = 0; i <= 17 && num_scratch < scratch.size(); ++i)
+    {
+      const ARM64Reg reg = ARM64Reg::W0 + i;
+      if (gprs_to_push[i] || reg == EncodeRegTo32(addr) || (IsGPR(RS) && reg == EncodeRegTo32(RS)))
+        continue;
+      // W0 is the temporary register of integer stores
+      if (reg == ARM64Reg::W0 && flags & BackPatchInfo::FLAG_STORE)
+        continue;
+      scratch[num_scratch++] = reg;
+    }
+
+    const bool soft_tlb_enabled =
+        flags & BackPatchInfo::FLAG_STORE ? jo.soft_tlb_writes : jo.soft_tlb;
+    const bool soft_tlb = MSR.DR && soft_tlb_enabled && num_scratch == scratch.size() &&
+                          !(flags & BackPatchInfo::FLAG_ZERO_256);
+
     if (fastmem && do_farcode)
     {
       SlowmemHandler handler;
@@ -144,6 +172,7 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
       handler.gprs = gprs_to_push;
       handler.fprs = fprs_to_push;
       handler.flags = flags;
+      handler.soft_tlb = soft_tlb;
 
       FastmemArea* fastmem_area = &m_fault_to_handler[fastmem_start];
       auto handler_loc_iter = m_handler_to_loc.find(handler);
@@ -166,6 +195,36 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
       }
     }
 
+    FixupBranch soft_tlb_hit;
+    if (soft_tlb)
+    {
+      static_assert(sizeof(PowerPC::SoftTLBEntry) == 1 << SOFT_TLB_ENTRY_SHIFT);
+
+      const ARM64Reg entry = EncodeRegTo64(scratch[0]);
+      const ARM64Reg tag = scratch[1];
+      const ARM64Reg tmp = scratch[2];
+      const ARM64Reg addr32 = EncodeRegTo32(addr);
+      const PowerPC::SoftTLB& tlb = flags & BackPatchInfo::FLAG_STORE ? PowerPC::soft_tlb_write :
+                                                                        PowerPC::soft_tlb_read;
+
+      // The entry is picked by the page of the first byte, but the tag is compared with the page of
+      // the last byte, so that accesses crossing a page boundary always miss.
+      UBFX(tmp, addr32, PowerPC::SOFT_TLB_PAGE_SHIFT, IntLog2(PowerPC::SOFT_TLB_SIZE));
+      MOVP2R(entry, tlb.data());
+      ADD(entry, entry, EncodeRegTo64(tmp),
+          ArithOption(EncodeRegTo64(tmp), ShiftType::LSL, SOFT_TLB_ENTRY_SHIFT));
+      LDR(IndexType::Unsigned, tag, entry, offsetof(PowerPC::SoftTLBEntry, tag));
+      ADDI2R(tmp, addr32, BackPatchInfo::GetFlagSize(flags) / 8 - 1);
+      ANDI2R(tmp, tmp, ~PowerPC::SOFT_TLB_PAGE_MASK);
+      CMP(tmp, tag);
+      FixupBranch miss = B(CC_NEQ);
+
+      LDR(IndexType::Unsigned, entry, entry, offsetof(PowerPC::SoftTLBEntry, host_base));
+      emit_access(entry);
+      soft_tlb_hit = B();
+      SetJumpTarget(miss);
+    }
+
     ABI_PushRegisters(gprs_to_push);
     m_float_emit.ABI_PushRegisters(fprs_to_push, ARM64Reg::X30);
 
@@ -253,6 +312,9 @@ void JitArm64::EmitBackpatchRoutine(u32 flags, bool fastmem, bool do_farcode, AR
 
     m_float_emit.ABI_PopRegisters(fprs_to_push, ARM64Reg::X30);
     ABI_PopRegisters(gprs_to_push);
+
+    if (soft_tlb)
+      SetJumpTarget(soft_tlb_hit);
   }
 
   if (in_far_code)
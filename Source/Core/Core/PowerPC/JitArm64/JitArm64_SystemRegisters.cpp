@@ -114,13 +114,24 @@ void JitArm64::mfsr(UGeckoInstruction inst)
   LDR(IndexType::Unsigned, gpr.R(inst.RD), PPC_REG, PPCSTATE_OFF_SR(inst.SR));
 }
 
+// Segment register writes go through SetSR so that the software TLB gets invalidated.
+static void SetSR(u32 index, u32 value)
+{
+  PowerPC::ppcState.SetSR(index, value);
+}
+
 void JitArm64::mtsr(UGeckoInstruction inst)
 {
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
 
-  gpr.BindToRegister(inst.RS, true);
-  STR(IndexType::Unsigned, gpr.R(inst.RS), PPC_REG, PPCSTATE_OFF_SR(inst.SR));
+  gpr.Lock(ARM64Reg::W0, ARM64Reg::W1);
+
+  MOVI2R(ARM64Reg::W0, inst.SR);
+  MOV(ARM64Reg::W1, gpr.R(inst.RS));
+  CallSetSR();
+
+  gpr.Unlock(ARM64Reg::W0, ARM64Reg::W1);
 }
 
 void JitArm64::mfsrin(UGeckoInstruction inst)
@@ -147,18 +158,28 @@ void JitArm64::mtsrin(UGeckoInstruction inst)
   INSTRUCTION_START
   JITDISABLE(bJITSystemRegistersOff);
 
-  u32 b = inst.RB, d = inst.RD;
-  gpr.BindToRegister(d, d == b);
+  gpr.Lock(ARM64Reg::W0, ARM64Reg::W1);
 
-  ARM64Reg index = gpr.GetReg();
-  ARM64Reg index64 = EncodeRegTo64(index);
-  ARM64Reg RB = gpr.R(b);
+  UBFM(ARM64Reg::W0, gpr.R(inst.RB), 28, 31);
+  MOV(ARM64Reg::W1, gpr.R(inst.RS));
+  CallSetSR();
 
-  UBFM(index, RB, 28, 31);
-  ADD(index64, PPC_REG, index64, ArithOption(index64, ShiftType::LSL, 2));
-  STR(IndexType::Unsigned, gpr.R(d), index64, PPCSTATE_OFF_SR(0));
+  gpr.Unlock(ARM64Reg::W0, ARM64Reg::W1);
+}
 
-  gpr.Unlock(index);
+void JitArm64::CallSetSR()
+{
+  BitSet32 gprs_to_push = gpr.GetCallerSavedUsed();
+  BitSet32 fprs_to_push = fpr.GetCallerSavedUsed();
+
+  ABI_PushRegisters(gprs_to_push);
+  m_float_emit.ABI_PushRegisters(fprs_to_push, ARM64Reg::X30);
+
+  MOVP2R(ARM64Reg::X8, &SetSR);
+  BLR(ARM64Reg::X8);
+
+  m_float_emit.ABI_PopRegisters(fprs_to_push, ARM64Reg::X30);
+  ABI_PopRegisters(gprs_to_push);
 }
 
 void JitArm64::twx(UGeckoInstruction inst)
@@ -155,9 +155,15 @@ void JitArm64::GenerateAsm()
   MOVP2R(ARM64Reg::X8, reinterpret_cast<void*>(&JitTrampoline));
   BLR(ARM64Reg::X8);
   LDR(IndexType::Unsigned, DISPATCHER_PC, PPC_REG, PPCSTATE_OFF(pc));
+
+  // The block may have been run by the interpreter tier instead of being compiled.
+  LDR(IndexType::Unsigned, ARM64Reg::W0, PPC_REG, PPCSTATE_OFF(downcount));
+  CMP(ARM64Reg::W0, 0);
+  FixupBranch interpreter_tier_bail = B(CC_LE);
   B(dispatcher_no_check);
 
   SetJumpTarget(bail);
+  SetJumpTarget(interpreter_tier_bail);
   do_timing = GetCodePtr();
   // Write the current PC out to PPCSTATE
   static_assert(PPCSTATE_OFF(pc) <= 252);
@@ -4,9 +4,14 @@
 
 #include "Core/PowerPC/JitCommon/JitBase.h"
 
+#include <algorithm>
+
 #include "Common/CommonTypes.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/HW/CPU.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/PPCAnalyst.h"
 #include "Core/PowerPC/PowerPC.h"
 
@@ -47,4 +52,58 @@ void JitBase::UpdateMemoryOptions()
   bool any_watchpoints = PowerPC::memchecks.HasAny();
   jo.fastmem = SConfig::GetInstance().bFastmem && jo.fastmem_arena && (MSR.DR || !any_watchpoints);
   jo.memcheck = SConfig::GetInstance().bMMU || any_watchpoints;
+  // Watchpoints are checked by the MMU code, so accesses must not bypass it.
+  jo.soft_tlb = SConfig::GetInstance().bMMU && !any_watchpoints;
+  // The software TLB points at RAM directly rather than at the write-protected fastmem views, so
+  // with write tracking, stores have to go through the MMU code to be marked as written.
+  jo.soft_tlb_writes = jo.soft_tlb && !Memory::IsWriteTrackingEnabled();
+}
+
+void JitBase::InitInterpreterTier()
+{
+  m_tier_up_threshold =
+      static_cast<u32>(std::max(Config::Get(Config::MAIN_JIT_TIER_UP_THRESHOLD), 0));
+  if (m_tier_up_threshold == 0 || SConfig::GetInstance().bEnableDebugging)
+    return;
+
+  m_interpreter_tier = std::make_unique<CachedInterpreter>();
+  m_interpreter_tier->Init();
+  GetBlockCache()->SetSecondaryCache(m_interpreter_tier->GetBlockCache());
+}
+
+void JitBase::ShutdownInterpreterTier()
+{
+  if (m_interpreter_tier)
+  {
+    GetBlockCache()->SetSecondaryCache(nullptr);
+    m_interpreter_tier->Shutdown();
+    m_interpreter_tier.reset();
+  }
+  m_interpreter_tier_run_counts.clear();
+}
+
+bool JitBase::ExecuteInInterpreterTier(u32 em_address)
+{
+  // Blocks which are compiled ahead of time (rather than because the CPU is about to run them)
+  // can't be executed here.
+  if (!m_interpreter_tier || em_address != PC)
+    return false;
+
+  const u64 key = u64{MSR.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK} << 32 | em_address;
+  u32& run_count = m_interpreter_tier_run_counts[key];
+  if (run_count >= m_tier_up_threshold)
+  {
+    m_interpreter_tier_run_counts.erase(key);
+    return false;
+  }
+
+  // Building the interpreter block doesn't count as a run
+  if (m_interpreter_tier->ExecuteOneBlock())
+    ++run_count;
+  return true;
+}
+
+void JitBase::ClearInterpreterTierRunCounts()
+{
+  m_interpreter_tier_run_counts.clear();
 }
@@ -6,6 +6,8 @@
 
 #include <cstddef>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "Common/BitSet.h"
@@ -40,6 +42,8 @@
 #define JITDISABLE(setting)                                                                        \
   FALLBACK_IF(SConfig::GetInstance().bJITOff || SConfig::GetInstance().setting)
 
+class CachedInterpreter;
+
 class JitBase : public CPUCoreBase
 {
 protected:
@@ -64,6 +68,10 @@ protected:
     bool fastmem;
     bool fastmem_arena;
     bool memcheck;
+    // Look loads and stores up in the software TLB before calling into the MMU code.
+    bool soft_tlb;
+    // Stores that hit the software TLB are done inline too.
+    bool soft_tlb_writes;
     bool profile_blocks;
   };
   struct JitState
@@ -116,6 +124,19 @@ protected:
 
   void UpdateMemoryOptions();
 
+  // Tiered execution: when enabled, blocks run in a cached interpreter until they have been
+  // executed often enough to be worth compiling.
+  void InitInterpreterTier();
+  void ShutdownInterpreterTier();
+  // Executes the block at em_address in the interpreter tier if it isn't hot yet.
+  // Returns false if the block should be compiled instead.
+  bool ExecuteInInterpreterTier(u32 em_address);
+
+  std::unique_ptr<CachedInterpreter> m_interpreter_tier;
+  // (MSR bits << 32 | effective address) -> number of runs in the interpreter tier
+  std::unordered_map<u64, u32> m_interpreter_tier_run_counts;
+  u32 m_tier_up_threshold = 0;
+
 public:
   JitBase();
   ~JitBase() override;
@@ -124,6 +145,14 @@ public:
   virtual JitBaseBlockCache* GetBlockCache() = 0;
 
   virtual void Jit(u32 em_address) = 0;
+  // Compiles the block at em_address without running it. Unlike Jit, this leaves the CPU state
+  // alone if the block can't be compiled, since no exception can happen at an address the CPU
+  // isn't executing.
+  virtual void Precompile(u32 em_address) {}
+
+  // Called by the block cache when it's cleared, so that counts of blocks which never became hot
+  // don't pile up.
+  void ClearInterpreterTierRunCounts();
 
   virtual const CommonAsmRoutinesBase* GetAsmRoutines() = 0;
 
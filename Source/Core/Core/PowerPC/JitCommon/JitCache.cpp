@@ -13,12 +13,12 @@
 #include <array>
 #include <cstring>
 #include <functional>
-#include <map>
 #include <set>
 #include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/JitRegister.h"
+#include "Core/Config/MainSettings.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -34,8 +34,8 @@ using namespace Gen;
 
 bool JitBlock::OverlapsPhysicalRange(u32 address, u32 length) const
 {
-  return physical_addresses.lower_bound(address) !=
-         physical_addresses.lower_bound(address + length);
+  return std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address) !=
+         std::lower_bound(physical_addresses.begin(), physical_addresses.end(), address + length);
 }
 
 JitBaseBlockCache::JitBaseBlockCache(JitBase& jit) : m_jit{jit}
@@ -48,12 +48,15 @@ void JitBaseBlockCache::Init()
 {
   JitRegister::Init(SConfig::GetInstance().m_perfDir);
 
+  m_persistent_cache_enabled = Config::Get(Config::MAIN_JIT_PERSISTENT_CACHE);
+
   Clear();
 }
 
 void JitBaseBlockCache::Shutdown()
 {
   JitRegister::Shutdown();
+  m_persistent_cache.Close();
 }
 
 // This clears the JIT cache. It's called from JitCache.cpp when the JIT cache
@@ -65,17 +68,24 @@ void JitBaseBlockCache::Clear()
 #endif
   m_jit.js.fifoWriteAddresses.clear();
   m_jit.js.pairedQuantizeAddresses.clear();
-  for (auto& e : block_map)
+  m_jit.ClearInterpreterTierRunCounts();
+  for (JitBlock& block : block_storage)
   {
-    DestroyBlock(e.second);
+    if (block.is_allocated)
+      DestroyBlock(block);
   }
-  block_map.clear();
+  block_storage.clear();
+  free_blocks.clear();
   links_to.clear();
-  block_range_map.clear();
+  for (auto& page : block_range_map)
+    page.reset();
 
   valid_block.ClearAll();
 
   fast_block_map.fill(nullptr);
+
+  if (m_secondary_cache)
+    m_secondary_cache->Clear();
 }
 
 void JitBaseBlockCache::Reset()
@@ -91,48 +101,82 @@ JitBlock** JitBaseBlockCache::GetFastBlockMap()
 
 void JitBaseBlockCache::RunOnBlocks(std::function<void(const JitBlock&)> f)
 {
-  for (const auto& e : block_map)
-    f(e.second);
+  for (const JitBlock& block : block_storage)
+  {
+    if (block.is_allocated)
+      f(block);
+  }
 }
 
 JitBlock* JitBaseBlockCache::AllocateBlock(u32 em_address)
 {
   u32 physicalAddress = PowerPC::JitCache_TranslateAddress(em_address).address;
-  JitBlock& b = block_map.emplace(physicalAddress, JitBlock())->second;
-  b.effectiveAddress = em_address;
-  b.physicalAddress = physicalAddress;
-  b.msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
-  b.linkData.clear();
-  b.fast_block_map_index = 0;
-  return &b;
+
+  JitBlock* b;
+  if (free_blocks.empty())
+  {
+    b = &block_storage.emplace_back();
+  }
+  else
+  {
+    // Recycle a freed block, keeping the capacity of its vectors.
+    b = free_blocks.back();
+    free_blocks.pop_back();
+    static_cast<JitBlockData&>(*b) = {};
+    b->linkData.clear();
+    b->physical_addresses.clear();
+    b->profile_data = {};
+    b->needs_recompile = false;
+  }
+
+  b->effectiveAddress = em_address;
+  b->physicalAddress = physicalAddress;
+  b->msrBits = MSR.Hex & JIT_CACHE_MSR_MASK;
+  b->fast_block_map_index = 0;
+  b->is_allocated = true;
+  return b;
+}
+
+void JitBaseBlockCache::FreeBlock(JitBlock& block)
+{
+  block.is_allocated = false;
+  free_blocks.push_back(&block);
 }
 
 void JitBaseBlockCache::FinalizeBlock(JitBlock& block, bool block_link,
-                                      const std::set<u32>& physical_addresses)
+                                      const std::map<u32, u32>& physical_addresses)
 {
   size_t index = FastLookupIndexForAddress(block.effectiveAddress);
   fast_block_map[index] = &block;
   block.fast_block_map_index = index;
 
-  block.physical_addresses = physical_addresses;
+  block.physical_addresses.clear();
+  for (const auto& [physical_address, effective_address] : physical_addresses)
+    block.physical_addresses.push_back(physical_address);
 
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  for (u32 addr : physical_addresses)
-  {
-    valid_block.Set(addr / 32);
-    block_range_map[addr & range_mask].insert(&block);
-  }
+  // The block range map is also used to look up blocks by their start address, so make sure the
+  // entry point is always part of the block's range.
+  const auto start = std::lower_bound(block.physical_addresses.begin(),
+                                      block.physical_addresses.end(), block.physicalAddress);
+  if (start == block.physical_addresses.end() || *start != block.physicalAddress)
+    block.physical_addresses.insert(start, block.physicalAddress);
+
+  AddToBlockRangeMap(block);
 
   if (block_link)
   {
     for (const auto& e : block.linkData)
     {
-      links_to[e.exitAddress].insert(&block);
+      auto& sources = links_to[e.exitAddress];
+      if (std::find(sources.begin(), sources.end(), &block) == sources.end())
+        sources.push_back(&block);
     }
 
     LinkBlock(block);
   }
 
+  m_persistent_cache.RecordBlock(block, physical_addresses);
+
   Common::Symbol* symbol = nullptr;
   if (JitRegister::IsEnabled() &&
       (symbol = g_symbolDB.GetSymbolFromAddr(block.effectiveAddress)) != nullptr)
@@ -160,12 +204,17 @@ JitBlock* JitBaseBlockCache::GetBlockFromStartAddress(u32 addr, u32 msr)
     translated_addr = translated.address;
   }
 
-  auto iter = block_map.equal_range(translated_addr);
-  for (; iter.first != iter.second; iter.first++)
+  const BlockRangeBucket* bucket = FindBlockRangeBucket(translated_addr);
+  if (!bucket)
+    return nullptr;
+
+  for (JitBlock* b : *bucket)
   {
-    JitBlock& b = iter.first->second;
-    if (b.effectiveAddress == addr && b.msrBits == (msr & JIT_CACHE_MSR_MASK))
-      return &b;
+    if (b->physicalAddress == translated_addr && b->effectiveAddress == addr &&
+        b->msrBits == (msr & JIT_CACHE_MSR_MASK))
+    {
+      return b;
+    }
   }
 
   return nullptr;
@@ -186,6 +235,9 @@ const u8* JitBaseBlockCache::Dispatch()
 
 void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
 {
+  if (m_secondary_cache)
+    m_secondary_cache->InvalidateICache(address, length, forced);
+
   auto translated = PowerPC::JitCache_TranslateAddress(address);
   if (!translated.valid)
     return;
@@ -223,53 +275,102 @@ void JitBaseBlockCache::InvalidateICache(u32 address, u32 length, bool forced)
 
 void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 {
-  // Iterate over all macro blocks which overlap the given range.
-  u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
-  auto start = block_range_map.lower_bound(address & range_mask);
-  auto end = block_range_map.lower_bound(address + length);
-  while (start != end)
+  std::vector<JitBlock*> erased_blocks;
+
+  // Iterate over all macro blocks which overlap the given range, skipping unallocated pages.
+  const u64 end = std::min(u64{address} + length, u64{1} << 32);
+  u64 range_address = address & ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  while (range_address < end)
   {
-    // Iterate over all blocks in the macro block.
-    auto iter = start->second.begin();
-    while (iter != start->second.end())
+    const u32 page_index = static_cast<u32>(range_address >> BLOCK_RANGE_PAGE_SHIFT);
+    BlockRangePage* page = block_range_map[page_index].get();
+    if (!page)
+    {
+      range_address = u64{page_index + 1} << BLOCK_RANGE_PAGE_SHIFT;
+      continue;
+    }
+
+    // Collect all blocks in the macro block which overlap the range, then remove them from every
+    // macro block they occupy.
+    BlockRangeBucket& bucket =
+        (*page)[(range_address / BLOCK_RANGE_MAP_ELEMENTS) % BLOCK_RANGE_PAGE_ELEMENTS];
+    for (JitBlock* block : bucket)
     {
-      JitBlock* block = *iter;
       if (block->OverlapsPhysicalRange(address, length))
-      {
-        // If the block overlaps, also remove all other occupied slots in the other macro blocks.
-        // This will leak empty macro blocks, but they may be reused or cleared later on.
-        for (u32 addr : block->physical_addresses)
-          if ((addr & range_mask) != start->first)
-            block_range_map[addr & range_mask].erase(block);
-
-        // And remove the block.
-        DestroyBlock(*block);
-        auto block_map_iter = block_map.equal_range(block->physicalAddress);
-        while (block_map_iter.first != block_map_iter.second)
-        {
-          if (&block_map_iter.first->second == block)
-          {
-            block_map.erase(block_map_iter.first);
-            break;
-          }
-          block_map_iter.first++;
-        }
-        iter = start->second.erase(iter);
-      }
-      else
-      {
-        iter++;
-      }
+        erased_blocks.push_back(block);
     }
 
-    // If the macro block is empty, drop it.
-    if (start->second.empty())
-      start = block_range_map.erase(start);
-    else
-      start++;
+    for (JitBlock* block : erased_blocks)
+    {
+      RemoveFromBlockRangeMap(*block);
+      DestroyBlock(*block);
+      FreeBlock(*block);
+    }
+    erased_blocks.clear();
+
+    range_address += BLOCK_RANGE_MAP_ELEMENTS;
+  }
+}
+
+void JitBaseBlockCache::RequestRecompilation(u32 address, u32 msr)
+{
+  u32 translated_addr = address;
+  if (UReg_MSR(msr).IR)
+  {
+    auto translated = PowerPC::JitCache_TranslateAddress(address);
+    if (!translated.valid)
+      return;
+    translated_addr = translated.address;
+  }
+
+  const BlockRangeBucket* bucket = FindBlockRangeBucket(translated_addr);
+  if (!bucket)
+    return;
+
+  for (JitBlock* block : *bucket)
+  {
+    if (block->msrBits != (msr & JIT_CACHE_MSR_MASK) ||
+        !block->OverlapsPhysicalRange(translated_addr, 4))
+    {
+      continue;
+    }
+
+    // Send every entry into the block through the dispatcher, which does the recompilation.
+    block->needs_recompile = true;
+    if (fast_block_map[block->fast_block_map_index] == block)
+      fast_block_map[block->fast_block_map_index] = nullptr;
+    UnlinkBlock(*block);
   }
 }
 
+void JitBaseBlockCache::CompilePersistentCacheBlocks(u32 em_address)
+{
+  if (!m_persistent_cache_enabled || m_compiling_persistent_cache_blocks ||
+      SConfig::GetInstance().bEnableDebugging)
+  {
+    return;
+  }
+
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id != m_persistent_cache.GetGameID())
+    m_persistent_cache.Open(game_id);
+  if (!m_persistent_cache.IsOpen())
+    return;
+
+  const auto translated = PowerPC::JitCache_TranslateAddress(em_address);
+  if (!translated.valid)
+    return;
+
+  const u32 msr_bits = MSR.Hex & JIT_CACHE_MSR_MASK;
+  m_compiling_persistent_cache_blocks = true;
+  for (u32 address : m_persistent_cache.TakeBlocksToCompile(translated.address, msr_bits))
+  {
+    if (address != em_address && !GetBlockFromStartAddress(address, msr_bits))
+      m_jit.Precompile(address);
+  }
+  m_compiling_persistent_cache_blocks = false;
+}
+
 void JitBaseBlockCache::WriteDestroyBlock(const JitBlock& block)
 {
 }
@@ -287,7 +388,7 @@ void JitBaseBlockCache::LinkBlockExits(JitBlock& block)
     if (!e.linkStatus)
     {
       JitBlock* destinationBlock = GetBlockFromStartAddress(e.exitAddress, block.msrBits);
-      if (destinationBlock)
+      if (destinationBlock && !destinationBlock->needs_recompile)
       {
         WriteLinkBlock(e, destinationBlock);
         e.linkStatus = true;
@@ -351,8 +452,14 @@ void JitBaseBlockCache::DestroyBlock(JitBlock& block)
     auto it = links_to.find(e.exitAddress);
     if (it == links_to.end())
       continue;
-    it->second.erase(&block);
-    if (it->second.empty())
+    auto& sources = it->second;
+    const auto source = std::find(sources.begin(), sources.end(), &block);
+    if (source != sources.end())
+    {
+      *source = sources.back();
+      sources.pop_back();
+    }
+    if (sources.empty())
       links_to.erase(it);
   }
 
@@ -367,6 +474,15 @@ JitBlock* JitBaseBlockCache::MoveBlockIntoFastCache(u32 addr, u32 msr)
   if (!block)
     return nullptr;
 
+  if (block->needs_recompile)
+  {
+    // The dispatcher runs in between blocks, so the old block can be replaced now.
+    RemoveFromBlockRangeMap(*block);
+    DestroyBlock(*block);
+    FreeBlock(*block);
+    return nullptr;
+  }
+
   // Drop old fast block map entry
   if (fast_block_map[block->fast_block_map_index] == block)
     fast_block_map[block->fast_block_map_index] = nullptr;
@@ -383,3 +499,61 @@ size_t JitBaseBlockCache::FastLookupIndexForAddress(u32 address)
 {
   return (address >> 2) & FAST_BLOCK_MAP_MASK;
 }
+
+JitBaseBlockCache::BlockRangeBucket& JitBaseBlockCache::GetBlockRangeBucket(u32 address)
+{
+  auto& page = block_range_map[address >> BLOCK_RANGE_PAGE_SHIFT];
+  if (!page)
+    page = std::make_unique<BlockRangePage>();
+  return (*page)[(address / BLOCK_RANGE_MAP_ELEMENTS) % BLOCK_RANGE_PAGE_ELEMENTS];
+}
+
+JitBaseBlockCache::BlockRangeBucket* JitBaseBlockCache::FindBlockRangeBucket(u32 address)
+{
+  BlockRangePage* page = block_range_map[address >> BLOCK_RANGE_PAGE_SHIFT].get();
+  if (!page)
+    return nullptr;
+  return &(*page)[(address / BLOCK_RANGE_MAP_ELEMENTS) % BLOCK_RANGE_PAGE_ELEMENTS];
+}
+
+void JitBaseBlockCache::AddToBlockRangeMap(JitBlock& block)
+{
+  // physical_addresses is sorted, so all addresses of a macro block are adjacent.
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  BlockRangeBucket* previous_bucket = nullptr;
+  u32 previous_range = 0;
+  for (u32 addr : block.physical_addresses)
+  {
+    valid_block.Set(addr / 32);
+    if (previous_bucket && (addr & range_mask) == previous_range)
+      continue;
+
+    previous_range = addr & range_mask;
+    previous_bucket = &GetBlockRangeBucket(previous_range);
+    previous_bucket->push_back(&block);
+  }
+}
+
+void JitBaseBlockCache::RemoveFromBlockRangeMap(const JitBlock& block)
+{
+  const u32 range_mask = ~(BLOCK_RANGE_MAP_ELEMENTS - 1);
+  BlockRangeBucket* previous_bucket = nullptr;
+  u32 previous_range = 0;
+  for (u32 addr : block.physical_addresses)
+  {
+    if (previous_bucket && (addr & range_mask) == previous_range)
+      continue;
+
+    previous_range = addr & range_mask;
+    previous_bucket = FindBlockRangeBucket(previous_range);
+    if (!previous_bucket)
+      continue;
+
+    const auto it = std::find(previous_bucket->begin(), previous_bucket->end(), &block);
+    if (it != previous_bucket->end())
+    {
+      *it = previous_bucket->back();
+      previous_bucket->pop_back();
+    }
+  }
+}
@@ -7,16 +7,16 @@
 #include <array>
 #include <bitset>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
-#include <set>
 #include <type_traits>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Core/PowerPC/JitCommon/JitPersistentCache.h"
 
 class JitBase;
 
@@ -79,8 +79,8 @@ struct JitBlock : public JitBlockData
   };
   std::vector<LinkData> linkData;
 
-  // This set stores all physical addresses of all occupied instructions.
-  std::set<u32> physical_addresses;
+  // This sorted vector stores all physical addresses of all occupied instructions.
+  std::vector<u32> physical_addresses;
 
   // Block profiling data, structure is inlined in Jit.cpp
   struct ProfileData
@@ -91,6 +91,11 @@ struct JitBlock : public JitBlockData
     u64 ticStart;
     u64 ticStop;
   } profile_data = {};
+
+  // Whether this block is owned by the block cache, as opposed to waiting in its free list.
+  bool is_allocated = false;
+  // Whether this block is replaced by a new compilation the next time it's looked up.
+  bool needs_recompile = false;
 };
 
 typedef void (*CompiledCode)();
@@ -148,7 +153,8 @@ public:
   void RunOnBlocks(std::function<void(const JitBlock&)> f);
 
   JitBlock* AllocateBlock(u32 em_address);
-  void FinalizeBlock(JitBlock& block, bool block_link, const std::set<u32>& physical_addresses);
+  void FinalizeBlock(JitBlock& block, bool block_link,
+                     const std::map<u32, u32>& physical_addresses);
 
   // Look for the block in the slow but accurate way.
   // This function shall be used if FastLookupIndexForAddress() failed.
@@ -164,6 +170,19 @@ public:
   void InvalidateICache(u32 address, u32 length, bool forced);
   void ErasePhysicalRange(u32 address, u32 length);
 
+  // Makes the blocks with the given MSR bits which contain the instruction at address get compiled
+  // again by the next dispatch to them. Unlike InvalidateICache, this may be called from within
+  // one of those blocks, as they are only destroyed once the dispatcher looks them up.
+  void RequestRecompilation(u32 address, u32 msr);
+
+  // Sets a block cache which holds other code for the same guest memory (e.g. the cache of the
+  // interpreter tier), so that it's cleared and invalidated along with this one.
+  void SetSecondaryCache(JitBaseBlockCache* cache) { m_secondary_cache = cache; }
+
+  // Compiles the blocks of the persistent cache which are ready to be built, before the JIT
+  // compiles the block at em_address. Does nothing if the persistent cache is disabled.
+  void CompilePersistentCacheBlocks(u32 em_address);
+
 protected:
   virtual void DestroyBlock(JitBlock& block);
 
@@ -182,19 +201,35 @@ private:
   // Fast but risky block lookup based on fast_block_map.
   size_t FastLookupIndexForAddress(u32 address);
 
+  void FreeBlock(JitBlock& block);
+
+  void AddToBlockRangeMap(JitBlock& block);
+  void RemoveFromBlockRangeMap(const JitBlock& block);
+
   // links_to hold all exit points of all valid blocks in a reverse way.
   // It is used to query all blocks which links to an address.
-  std::unordered_map<u32, std::unordered_set<JitBlock*>> links_to;  // destination_PC -> number
+  std::unordered_map<u32, std::vector<JitBlock*>> links_to;  // destination_PC -> blocks
 
-  // Map indexed by the physical address of the entry point.
-  // This is used to query the block based on the current PC in a slow way.
-  std::multimap<u32, JitBlock> block_map;  // start_addr -> block
+  // Storage of all blocks. A deque never moves its elements, so pointers to blocks stay valid
+  // until they are freed. Freed blocks are kept in free_blocks and reused by AllocateBlock.
+  std::deque<JitBlock> block_storage;
+  std::vector<JitBlock*> free_blocks;
 
   // Range of overlapping code indexed by a masked physical address.
-  // This is used for invalidation of memory regions. The range is grouped
-  // in macro blocks of each 0x100 bytes.
+  // This is used for invalidation of memory regions and for looking up blocks by their
+  // physical start address. The range is grouped in macro blocks of each 0x100 bytes.
+  // The macro blocks are stored in flat pages of 1 MiB each, which are only allocated once a
+  // block is placed in them.
   static constexpr u32 BLOCK_RANGE_MAP_ELEMENTS = 0x100;
-  std::map<u32, std::unordered_set<JitBlock*>> block_range_map;
+  static constexpr u32 BLOCK_RANGE_PAGE_SHIFT = 20;
+  static constexpr u32 BLOCK_RANGE_PAGE_ELEMENTS =
+      (1 << BLOCK_RANGE_PAGE_SHIFT) / BLOCK_RANGE_MAP_ELEMENTS;
+  static constexpr u32 BLOCK_RANGE_PAGE_COUNT = 1 << (32 - BLOCK_RANGE_PAGE_SHIFT);
+  using BlockRangeBucket = std::vector<JitBlock*>;
+  using BlockRangePage = std::array<BlockRangeBucket, BLOCK_RANGE_PAGE_ELEMENTS>;
+  BlockRangeBucket& GetBlockRangeBucket(u32 address);
+  BlockRangeBucket* FindBlockRangeBucket(u32 address);
+  std::array<std::unique_ptr<BlockRangePage>, BLOCK_RANGE_PAGE_COUNT> block_range_map;
 
   // This bitsets shows which cachelines overlap with any blocks.
   // It is used to provide a fast way to query if no icache invalidation is needed.
@@ -203,4 +238,11 @@ private:
   // This array is indexed with the masked PC and likely holds the correct block id.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
   std::array<JitBlock*, FAST_BLOCK_MAP_ELEMENTS> fast_block_map;  // start_addr & mask -> number
+
+  JitBaseBlockCache* m_secondary_cache = nullptr;
+
+  // Blocks compiled in previous sessions of the running game.
+  JitPersistentCache m_persistent_cache;
+  bool m_persistent_cache_enabled = false;
+  bool m_compiling_persistent_cache_blocks = false;
 };
@@ -0,0 +1,250 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "Core/PowerPC/JitCommon/JitPersistentCache.h"
+
+#include <algorithm>
+#include <tuple>
+
+#include <xxhash.h>
+
+#include "Common/CommonPaths.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "Common/Swap.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/MMU.h"
+
+namespace
+{
+constexpr char JIT_CACHE_DIR[] = "JitBlocks" DIR_SEP;
+
+// Same checks as Memory::GetPointer, minus the panic alert.
+bool IsRAMAddress(u32 address)
+{
+  address &= 0x3FFFFFFF;
+  if (address < Memory::GetRamSizeReal())
+    return true;
+
+  return Memory::m_pEXRAM && (address >> 28) == 0x1 &&
+         (address & 0x0fffffff) < Memory::GetExRamSizeReal();
+}
+
+template <typename Run>
+u64 HashRuns(const std::vector<Run>& runs, u32 num_instructions)
+{
+  std::vector<u32> instructions;
+  instructions.reserve(num_instructions);
+  for (const Run& run : runs)
+  {
+    for (u32 i = 0; i < run.num_instructions; ++i)
+      instructions.push_back(Common::swap32(Memory::GetPointer(run.physical_address + i * 4)));
+  }
+
+  // Not GetHash64, whose function depends on the host CPU and the graphics settings. The keys
+  // have to stay the same across sessions.
+  return XXH64(instructions.data(), instructions.size() * sizeof(u32), 0);
+}
+}  // namespace
+
+bool JitPersistentCache::Key::operator<(const Key& other) const
+{
+  return std::tie(effective_address, physical_address, msr_bits, num_instructions, hash) <
+         std::tie(other.effective_address, other.physical_address, other.msr_bits,
+                  other.num_instructions, other.hash);
+}
+
+class JitPersistentCache::Reader final : public LinearDiskCacheReader<Key, u32>
+{
+public:
+  explicit Reader(JitPersistentCache& cache) : m_cache(cache) {}
+
+  void Read(const Key& key, const u32* value, u32 value_size) override
+  {
+    if (value_size % 3 != 0)
+      return;
+
+    std::vector<Run> runs;
+    runs.reserve(value_size / 3);
+    for (u32 i = 0; i < value_size; i += 3)
+      runs.push_back({value[i], value[i + 1], value[i + 2]});
+
+    m_cache.AddEntry(key, std::move(runs));
+  }
+
+private:
+  JitPersistentCache& m_cache;
+};
+
+JitPersistentCache::JitPersistentCache() = default;
+
+JitPersistentCache::~JitPersistentCache()
+{
+  Close();
+}
+
+void JitPersistentCache::Open(const std::string& game_id)
+{
+  Close();
+  m_game_id = game_id;
+  if (game_id.empty())
+    return;
+
+  const std::string dir = File::GetUserPath(D_CACHE_IDX) + JIT_CACHE_DIR;
+  if (!File::IsDirectory(dir))
+    File::CreateFullPath(dir);
+
+  const std::string filename = dir + game_id + ".cache";
+  Reader reader(*this);
+  const u32 count = m_disk_cache.OpenAndRead(filename, reader);
+  m_is_open = true;
+
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} cached JIT blocks from {}", count, filename);
+}
+
+void JitPersistentCache::Close()
+{
+  if (m_is_open)
+  {
+    m_disk_cache.Sync();
+    m_disk_cache.Close();
+  }
+
+  m_is_open = false;
+  m_game_id.clear();
+  m_known_keys.clear();
+  m_pending_entries.clear();
+  m_scanned_msr_bits = 0;
+}
+
+void JitPersistentCache::AddEntry(const Key& key, std::vector<Run> runs)
+{
+  u32 num_instructions = 0;
+  for (const Run& run : runs)
+  {
+    const u32 end = run.physical_address + run.num_instructions * 4 - 1;
+    if (run.num_instructions == 0 || !IsRAMAddress(run.physical_address) || !IsRAMAddress(end) ||
+        (run.physical_address & ~PAGE_MASK) != (end & ~PAGE_MASK))
+    {
+      return;
+    }
+    num_instructions += run.num_instructions;
+  }
+  if (num_instructions != key.num_instructions || !m_known_keys.insert(key).second)
+    return;
+
+  m_pending_entries[key.physical_address >> PAGE_SHIFT].push_back({key, std::move(runs)});
+}
+
+bool JitPersistentCache::IsValid(const Entry& entry)
+{
+  const PowerPC::TranslateResult translated =
+      PowerPC::JitCache_TranslateAddress(entry.key.effective_address);
+  if (!translated.valid || translated.address != entry.key.physical_address)
+    return false;
+
+  // Followed branches can pull in code from other pages, whose mappings may differ from when the
+  // block was recorded. Runs don't cross pages, so checking the start of each run is enough.
+  for (const Run& run : entry.runs)
+  {
+    const PowerPC::TranslateResult run_translated =
+        PowerPC::JitCache_TranslateAddress(run.effective_address);
+    if (!run_translated.valid || run_translated.address != run.physical_address)
+      return false;
+  }
+
+  return HashRuns(entry.runs, entry.key.num_instructions) == entry.key.hash;
+}
+
+void JitPersistentCache::RecordBlock(const JitBlock& block,
+                                     const std::map<u32, u32>& physical_addresses)
+{
+  if (!m_is_open || physical_addresses.empty())
+    return;
+
+  std::vector<Run> runs;
+  for (const auto& [physical_address, effective_address] : physical_addresses)
+  {
+    if (!IsRAMAddress(physical_address))
+      return;
+
+    if (!runs.empty() && (physical_address & PAGE_MASK) != 0)
+    {
+      Run& last = runs.back();
+      const u32 offset = last.num_instructions * 4;
+      if (last.physical_address + offset == physical_address &&
+          last.effective_address + offset == effective_address)
+      {
+        ++last.num_instructions;
+        continue;
+      }
+    }
+    runs.push_back({effective_address, physical_address, 1});
+  }
+
+  const u32 num_instructions = static_cast<u32>(physical_addresses.size());
+  const Key key{block.effectiveAddress, block.physicalAddress, block.msrBits, num_instructions,
+                HashRuns(runs, num_instructions)};
+  if (!m_known_keys.insert(key).second)
+    return;
+
+  std::vector<u32> value;
+  value.reserve(runs.size() * 3);
+  for (const Run& run : runs)
+  {
+    value.push_back(run.effective_address);
+    value.push_back(run.physical_address);
+    value.push_back(run.num_instructions);
+  }
+  m_disk_cache.Append(key, value.data(), static_cast<u32>(value.size()));
+}
+
+std::vector<u32> JitPersistentCache::TakeBlocksToCompile(u32 physical_address, u32 msr_bits)
+{
+  std::vector<u32> addresses;
+  if (m_pending_entries.empty())
+    return addresses;
+
+  const u32 msr_flag = 1u << (msr_bits >> 4);
+  const bool initial_scan = (m_scanned_msr_bits & msr_flag) == 0;
+  m_scanned_msr_bits |= msr_flag;
+
+  const auto take_from_page = [&](std::vector<Entry>& entries, bool drop_stale) {
+    const auto end = std::remove_if(entries.begin(), entries.end(), [&](const Entry& entry) {
+      if (entry.key.msr_bits != msr_bits)
+        return false;
+      if (IsValid(entry))
+      {
+        addresses.push_back(entry.key.effective_address);
+        return true;
+      }
+      return drop_stale;
+    });
+    entries.erase(end, entries.end());
+  };
+
+  if (initial_scan)
+  {
+    // Entries whose code isn't in memory yet (e.g. code in modules that haven't been loaded)
+    // stay pending until the game starts executing code in the same page.
+    for (auto it = m_pending_entries.begin(); it != m_pending_entries.end();)
+    {
+      take_from_page(it->second, false);
+      it = it->second.empty() ? m_pending_entries.erase(it) : std::next(it);
+    }
+  }
+  else
+  {
+    const auto it = m_pending_entries.find(physical_address >> PAGE_SHIFT);
+    if (it != m_pending_entries.end())
+    {
+      take_from_page(it->second, true);
+      if (it->second.empty())
+        m_pending_entries.erase(it);
+    }
+  }
+
+  return addresses;
+}
@@ -0,0 +1,93 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+
+struct JitBlock;
+
+// Remembers which PPC blocks a game compiled in previous sessions, so that they can be compiled
+// ahead of time on the next launch instead of one at a time while the game is running.
+//
+// Emitted host code can't be stored directly: it embeds absolute pointers to the PPC state,
+// the fastmem arena, the far code region, trampolines and constant pools, all of which move
+// between sessions. Instead, the cache stores everything needed to rebuild a block (its
+// addresses, MSR bits and the exact instruction words it was built from) and rebuilds it through
+// the normal JIT path once the same code shows up in emulated memory again. Blocks built this
+// way are finalized (and therefore linked) like any other block.
+class JitPersistentCache
+{
+public:
+  // Key of a cache entry. The value of an entry is the list of runs the block was built from.
+  struct Key
+  {
+    u32 effective_address;
+    u32 physical_address;
+    u32 msr_bits;
+    u32 num_instructions;
+    u64 hash;
+
+    bool operator<(const Key& other) const;
+  };
+
+  JitPersistentCache();
+  ~JitPersistentCache();
+
+  // Opens (or creates) the cache of the given game. An empty game ID closes the cache.
+  void Open(const std::string& game_id);
+  void Close();
+  bool IsOpen() const { return m_is_open; }
+  const std::string& GetGameID() const { return m_game_id; }
+
+  // Appends a freshly compiled block to the cache if it isn't already known. physical_addresses
+  // maps the physical address of every instruction of the block to its effective address.
+  void RecordBlock(const JitBlock& block, const std::map<u32, u32>& physical_addresses);
+
+  // Returns the effective addresses of cached blocks that should be compiled now, given that the
+  // JIT is about to compile a block at physical_address with the given MSR bits. The first call
+  // for a given set of MSR bits returns every cached block whose code is present in memory; later
+  // calls only consider blocks sharing a page with physical_address, and drop those whose code
+  // no longer matches. Each cached block is returned at most once per session.
+  std::vector<u32> TakeBlocksToCompile(u32 physical_address, u32 msr_bits);
+
+private:
+  // Instructions which are contiguous in both effective and physical memory, within one page.
+  struct Run
+  {
+    u32 effective_address;
+    u32 physical_address;
+    u32 num_instructions;
+  };
+
+  struct Entry
+  {
+    Key key;
+    std::vector<Run> runs;
+  };
+
+  class Reader;
+
+  static constexpr u32 PAGE_SHIFT = 12;
+  static constexpr u32 PAGE_MASK = (1u << PAGE_SHIFT) - 1;
+
+  void AddEntry(const Key& key, std::vector<Run> runs);
+  static bool IsValid(const Entry& entry);
+
+  LinearDiskCache<Key, u32> m_disk_cache;
+  std::string m_game_id;
+  bool m_is_open = false;
+
+  std::set<Key> m_known_keys;
+  // Entries which haven't been compiled yet in this session, indexed by physical page.
+  std::map<u32, std::vector<Entry>> m_pending_entries;
+  // Bitmask of the MSR bit combinations for which the initial full pass has already been done.
+  u32 m_scanned_msr_bits = 0;
+};
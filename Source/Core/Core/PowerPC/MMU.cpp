@@ -164,6 +164,78 @@ static void EFB_Write(u32 data, u32 addr)
 BatTable ibat_table;
 BatTable dbat_table;
 
+SoftTLB soft_tlb_read;
+SoftTLB soft_tlb_write;
+SoftTLB soft_tlb_opcode;
+
+template <XCheckTLBFlag flag>
+static SoftTLB& GetSoftTLB()
+{
+  if (IsOpcodeFlag(flag))
+    return soft_tlb_opcode;
+  return flag == XCheckTLBFlag::Write ? soft_tlb_write : soft_tlb_read;
+}
+
+static SoftTLBEntry& GetSoftTLBEntry(SoftTLB& tlb, u32 address)
+{
+  return tlb[(address >> SOFT_TLB_PAGE_SHIFT) % SOFT_TLB_SIZE];
+}
+
+// Returns the host pointer for an access of the given size, or nullptr if the software TLB doesn't
+// have the page or the access crosses into the next page.
+template <XCheckTLBFlag flag>
+static u8* LookupSoftTLB(u32 address, u32 size)
+{
+  const SoftTLBEntry& entry = GetSoftTLBEntry(GetSoftTLB<flag>(), address);
+  if (entry.tag != ((address + size - 1) & ~SOFT_TLB_PAGE_MASK))
+    return nullptr;
+  return reinterpret_cast<u8*>(entry.host_base + address);
+}
+
+// Called after an address was translated through the page table. Only RAM pages are cached, and
+// only by accesses which updated the R and C bits, so that hits never need to update them.
+template <XCheckTLBFlag flag>
+static void UpdateSoftTLB(u32 address, u32 physical_address)
+{
+  if (IsNoExceptionFlag(flag))
+    return;
+
+  const u32 physical_page = physical_address & ~SOFT_TLB_PAGE_MASK;
+  u8* host_page;
+  if (Memory::m_pRAM && (physical_page & 0xF8000000) == 0x00000000)
+  {
+    host_page = &Memory::m_pRAM[physical_page & Memory::GetRamMask()];
+  }
+  else if (Memory::m_pEXRAM && (physical_page >> 28) == 0x1 &&
+           (physical_page & 0x0FFFFFFF) < Memory::GetExRamSizeReal())
+  {
+    host_page = &Memory::m_pEXRAM[physical_page & 0x0FFFFFFF];
+  }
+  else
+  {
+    return;
+  }
+
+  SoftTLBEntry& entry = GetSoftTLBEntry(GetSoftTLB<flag>(), address);
+  entry.tag = address & ~SOFT_TLB_PAGE_MASK;
+  entry.physical_page = physical_page;
+  entry.host_base = reinterpret_cast<uintptr_t>(host_page) - entry.tag;
+}
+
+// Invalidates every software TLB entry whose page maps to the given emulated TLB set.
+static void InvalidateSoftTLBSet(SoftTLB& tlb, u32 tlb_index)
+{
+  for (u32 i = tlb_index; i < SOFT_TLB_SIZE; i += HW_PAGE_INDEX_MASK + 1)
+    tlb[i].tag = SOFT_TLB_INVALID_TAG;
+}
+
+void InvalidateSoftTLB()
+{
+  soft_tlb_read.fill({});
+  soft_tlb_write.fill({});
+  soft_tlb_opcode.fill({});
+}
+
 static void GenerateDSIException(u32 effective_address, bool write);
 
 template <XCheckTLBFlag flag, typename T, bool never_translate = false>
@@ -171,6 +243,13 @@ static T ReadFromHardware(u32 em_address)
 {
   if (!never_translate && MSR.DR)
   {
+    if (const u8* host_ptr = LookupSoftTLB<flag>(em_address, sizeof(T)))
+    {
+      T value;
+      std::memcpy(&value, host_ptr, sizeof(T));
+      return bswap(value);
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -202,6 +281,8 @@ static T ReadFromHardware(u32 em_address)
       }
       return var;
     }
+    if (translated_addr.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+      UpdateSoftTLB<flag>(em_address, translated_addr.address);
     em_address = translated_addr.address;
   }
 
@@ -260,6 +341,18 @@ static void WriteToHardware(u32 em_address, const T data)
 {
   if (!never_translate && MSR.DR)
   {
+    if (u8* host_ptr = LookupSoftTLB<flag>(em_address, sizeof(T)))
+    {
+      const T swapped_data = bswap(data);
+      std::memcpy(host_ptr, &swapped_data, sizeof(T));
+      if (Memory::IsWriteTrackingEnabled())
+      {
+        const SoftTLBEntry& entry = GetSoftTLBEntry(GetSoftTLB<flag>(), em_address);
+        Memory::MarkWritten(entry.physical_page | (em_address & SOFT_TLB_PAGE_MASK), sizeof(T));
+      }
+      return;
+    }
+
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
     {
@@ -292,6 +385,8 @@ static void WriteToHardware(u32 em_address, const T data)
       }
       return;
     }
+    if (translated_addr.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+      UpdateSoftTLB<flag>(em_address, translated_addr.address);
     em_address = translated_addr.address;
   }
 
@@ -304,6 +399,7 @@ static void WriteToHardware(u32 em_address, const T data)
     // TODO: Only the first GetRamSizeReal() is supposed to be backed by actual memory.
     const T swapped_data = bswap(data);
     std::memcpy(&Memory::m_pRAM[em_address & Memory::GetRamMask()], &swapped_data, sizeof(T));
+    Memory::MarkWritten(em_address & Memory::GetRamMask(), sizeof(T));
     return;
   }
 
@@ -312,6 +408,7 @@ static void WriteToHardware(u32 em_address, const T data)
   {
     const T swapped_data = bswap(data);
     std::memcpy(&Memory::m_pEXRAM[em_address & 0x0FFFFFFF], &swapped_data, sizeof(T));
+    Memory::MarkWritten(em_address, sizeof(T));
     return;
   }
 
@@ -382,6 +479,23 @@ static void WriteToHardware(u32 em_address, const T data)
 
 static void GenerateISIException(u32 effective_address);
 
+// Instruction address translation for the interpreter and the JIT cache, which checks the opcode
+// software TLB before doing a full translation.
+static TranslateAddressResult TranslateInstructionAddress(u32 address)
+{
+  const SoftTLBEntry& entry = GetSoftTLBEntry(soft_tlb_opcode, address);
+  if (entry.tag == (address & ~SOFT_TLB_PAGE_MASK))
+  {
+    return TranslateAddressResult{TranslateAddressResult::PAGE_TABLE_TRANSLATED,
+                                  entry.physical_page | (address & SOFT_TLB_PAGE_MASK)};
+  }
+
+  const auto result = TranslateAddress<XCheckTLBFlag::Opcode>(address);
+  if (result.result == TranslateAddressResult::PAGE_TABLE_TRANSLATED)
+    UpdateSoftTLB<XCheckTLBFlag::Opcode>(address, result.address);
+  return result;
+}
+
 u32 Read_Opcode(u32 address)
 {
   TryReadInstResult result = TryReadInstruction(address);
@@ -398,7 +512,7 @@ TryReadInstResult TryReadInstruction(u32 address)
   bool from_bat = true;
   if (MSR.IR)
   {
-    auto tlb_addr = TranslateAddress<XCheckTLBFlag::Opcode>(address);
+    auto tlb_addr = TranslateInstructionAddress(address);
     if (!tlb_addr.Success())
     {
       return TryReadInstResult{false, false, 0, 0};
@@ -735,6 +849,7 @@ void DMA_LCToMemory(const u32 mem_address, const u32 cache_address, const u32 nu
     return;
 
   memcpy(dst, src, 32 * num_blocks);
+  Memory::MarkWritten(mem_address, 32 * num_blocks);
 }
 
 void DMA_MemoryToLC(const u32 cache_address, const u32 mem_address, const u32 num_blocks)
@@ -846,7 +961,7 @@ TranslateResult JitCache_TranslateAddress(u32 address)
     return TranslateResult{true, true, address};
 
   // TODO: We shouldn't use FLAG_OPCODE if the caller is the debugger.
-  auto tlb_addr = TranslateAddress<XCheckTLBFlag::Opcode>(address);
+  auto tlb_addr = TranslateInstructionAddress(address);
   if (!tlb_addr.Success())
   {
     return TranslateResult{false, false, 0};
@@ -993,6 +1108,7 @@ void SDRUpdated()
 
   PowerPC::ppcState.pagetable_base = htaborg << 16;
   PowerPC::ppcState.pagetable_hashmask = ((htabmask << 10) | 0x3ff);
+  InvalidateSoftTLB();
 }
 
 enum class TLBLookupResult
@@ -1062,6 +1178,19 @@ static void UpdateTLBEntry(const XCheckTLBFlag flag, UPTE2 PTE2, const u32 addre
   const int tag = address >> HW_PAGE_INDEX_SHIFT;
   TLBEntry& tlbe = ppcState.tlb[IsOpcodeFlag(flag)][tag & HW_PAGE_INDEX_MASK];
   const int index = tlbe.recent == 0 && tlbe.tag[0] != TLBEntry::INVALID_TAG;
+  if (tlbe.tag[index] != TLBEntry::INVALID_TAG)
+  {
+    // The evicted page must go through the page table again.
+    if (IsOpcodeFlag(flag))
+    {
+      InvalidateSoftTLBSet(soft_tlb_opcode, tag & HW_PAGE_INDEX_MASK);
+    }
+    else
+    {
+      InvalidateSoftTLBSet(soft_tlb_read, tag & HW_PAGE_INDEX_MASK);
+      InvalidateSoftTLBSet(soft_tlb_write, tag & HW_PAGE_INDEX_MASK);
+    }
+  }
   tlbe.recent = index;
   tlbe.paddr[index] = PTE2.RPN << HW_PAGE_INDEX_SHIFT;
   tlbe.pte[index] = PTE2.Hex;
@@ -1079,6 +1208,10 @@ void InvalidateTLBEntry(u32 address)
   TLBEntry& tlbe_i = ppcState.tlb[1][entry_index];
   tlbe_i.tag[0] = TLBEntry::INVALID_TAG;
   tlbe_i.tag[1] = TLBEntry::INVALID_TAG;
+
+  InvalidateSoftTLBSet(soft_tlb_read, entry_index);
+  InvalidateSoftTLBSet(soft_tlb_write, entry_index);
+  InvalidateSoftTLBSet(soft_tlb_opcode, entry_index);
 }
 
 // Page Address Translation
@@ -1280,6 +1413,9 @@ void DBATUpdated()
   Memory::UpdateLogicalMemory(dbat_table);
 #endif
 
+  // Pages which are now covered by a BAT must no longer hit in the software TLB.
+  InvalidateSoftTLB();
+
   // IsOptimizable*Address and dcbz depends on the BAT mapping, so we need a flush here.
   JitInterface::ClearSafe();
 }
@@ -1297,6 +1433,7 @@ void IBATUpdated()
     UpdateFakeMMUBat(ibat_table, 0x40000000);
     UpdateFakeMMUBat(ibat_table, 0x70000000);
   }
+  InvalidateSoftTLB();
   JitInterface::ClearSafe();
 }
 
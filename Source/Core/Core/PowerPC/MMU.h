@@ -120,5 +120,27 @@ inline bool TranslateBatAddess(const BatTable& bat_table, u32* address)
   return true;
 }
 
+// Host-side software TLB in front of the page table translation. Each table is direct-mapped by
+// effective page and only holds pages which were translated through the page table to RAM, so a
+// hit turns an effective address into a host pointer without looking at the BATs, the emulated
+// TLB or the page table. The JIT reads the data tables directly from generated code.
+constexpr u32 SOFT_TLB_PAGE_SHIFT = 12;
+constexpr u32 SOFT_TLB_PAGE_MASK = (1 << SOFT_TLB_PAGE_SHIFT) - 1;
+constexpr u32 SOFT_TLB_SIZE = 1024;
+// Never page aligned, so it can't match any address.
+constexpr u32 SOFT_TLB_INVALID_TAG = 0x1;
+struct SoftTLBEntry
+{
+  u32 tag = SOFT_TLB_INVALID_TAG;  // Effective page address
+  u32 physical_page = 0;
+  // Host address of the page minus its effective page address
+  uintptr_t host_base = 0;
+};
+using SoftTLB = std::array<SoftTLBEntry, SOFT_TLB_SIZE>;
+extern SoftTLB soft_tlb_read;
+extern SoftTLB soft_tlb_write;
+extern SoftTLB soft_tlb_opcode;
+void InvalidateSoftTLB();
+
 std::optional<u32> GetTranslatedAddress(u32 address);
 }  // namespace PowerPC
@@ -731,6 +731,24 @@ bool PPCAnalyzer::IsBusyWaitLoop(CodeBlock* block, CodeOp* code, size_t instruct
   return false;
 }
 
+static u64 GetHotBranchKey(u32 msr, u32 address)
+{
+  return u64{msr & JitBaseBlockCache::JIT_CACHE_MSR_MASK} << 32 | address;
+}
+
+void PPCAnalyzer::SetHotBranch(u32 msr, u32 address, bool hot)
+{
+  if (hot)
+    m_hot_branches.insert(GetHotBranchKey(msr, address));
+  else
+    m_hot_branches.erase(GetHotBranchKey(msr, address));
+}
+
+bool PPCAnalyzer::IsHotBranch(u32 msr, u32 address) const
+{
+  return m_hot_branches.count(GetHotBranchKey(msr, address)) != 0;
+}
+
 u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size)
 {
   // Clear block stats
@@ -783,7 +801,7 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     code[i].inst = inst;
     code[i].skip = false;
     block->m_stats->numCycles += opinfo->numCycles;
-    block->m_physical_addresses.insert(result.physical_address);
+    block->m_physical_addresses.emplace(result.physical_address, address);
 
     SetInstructionStats(block, &code[i], opinfo, static_cast<u32>(i));
 
@@ -882,9 +900,19 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
     code[i].branchIsIdleLoop =
         code[i].branchTo == block->m_address && IsBusyWaitLoop(block, code, i);
 
+    if (enable_follow && HasOption(OPTION_HOT_BRANCH_FOLLOW) && conditional_continue &&
+        inst.OPCD == 16 && !inst.LK && !code[i].branchIsIdleLoop &&
+        numFollows < BRANCH_FOLLOWING_THRESHOLD && IsHotBranch(MSR.Hex, code[i].address))
+    {
+      // Continue on the hot path, the JIT turns the fallthrough into a side exit.
+      code[i].branchIsFollowed = true;
+      follow = true;
+      found_call = false;
+    }
+
     if (follow && numFollows < BRANCH_FOLLOWING_THRESHOLD)
     {
-      // Follow the unconditional branch.
+      // Follow the unconditional (or hot conditional) branch.
       numFollows++;
       address = code[i].branchTo;
     }
@@ -908,6 +936,11 @@ u32 PPCAnalyzer::Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std:
 
   block->m_num_instructions = num_inst;
 
+  // A followed branch can only leave the block through its side exit if the block continues
+  // after it, so it has to be handled as a regular branch if the block ended early.
+  if (num_inst > 0)
+    code[num_inst - 1].branchIsFollowed = false;
+
   if (block->m_num_instructions > 1)
     ReorderInstructions(block->m_num_instructions, code);
 
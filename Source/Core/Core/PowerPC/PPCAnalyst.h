@@ -6,7 +6,8 @@
 
 #include <algorithm>
 #include <cstddef>
-#include <set>
+#include <map>
+#include <unordered_set>
 #include <vector>
 
 #include "Common/BitSet.h"
@@ -35,6 +36,8 @@ struct CodeOp  // 16B
   bool isBranchTarget;
   bool branchUsesCtr;
   bool branchIsIdleLoop;
+  // Conditional branch whose target was inlined; the block is left when the branch isn't taken.
+  bool branchIsFollowed;
   bool wantsCR0;
   bool wantsCR1;
   bool wantsFPRF;
@@ -166,8 +169,9 @@ struct CodeBlock
   // Which GPRs this block reads from before defining, if any.
   BitSet32 m_gpr_inputs;
 
-  // Which memory locations are occupied by this block.
-  std::set<u32> m_physical_addresses;
+  // Which memory locations are occupied by this block, and the effective addresses they were read
+  // from.
+  std::map<u32, u32> m_physical_addresses;
 };
 
 class PPCAnalyzer
@@ -209,12 +213,24 @@ public:
 
     // Reorder cror instructions next to their associated fcmp.
     OPTION_CROR_MERGE = (1 << 6),
+
+    // Follow conditional branches which were marked as hot, turning the path
+    // where the branch isn't taken into a side exit.
+    // Requires JIT support to be enabled.
+    OPTION_HOT_BRANCH_FOLLOW = (1 << 7),
   };
 
   // Option setting/getting
   void SetOption(AnalystOption option) { m_options |= option; }
   void ClearOption(AnalystOption option) { m_options &= ~(option); }
   bool HasOption(AnalystOption option) const { return !!(m_options & option); }
+
+  // Hot branch tracking for OPTION_HOT_BRANCH_FOLLOW. Like blocks, branches are told apart by
+  // their effective address and the address translation bits of MSR.
+  void SetHotBranch(u32 msr, u32 address, bool hot);
+  bool IsHotBranch(u32 msr, u32 address) const;
+  void ClearHotBranches() { m_hot_branches.clear(); }
+
   u32 Analyze(u32 address, CodeBlock* block, CodeBuffer* buffer, std::size_t block_size);
 
 private:
@@ -232,6 +248,9 @@ private:
 
   // Options
   u32 m_options = 0;
+
+  // Conditional branches which are usually taken, keyed by the MSR bits and the address
+  std::unordered_set<u64> m_hot_branches;
 };
 
 void FindFunctions(u32 startAddr, u32 endAddr, PPCSymbolDB* func_db);
@@ -71,6 +71,17 @@ public:
     return Common::FromBigEndian(temp);
   }
 
+  // Maps the blob's file into memory if supported, so that reads don't need any read calls and
+  // GetDirectPointer can be used. Returns whether the file is mapped. Only do this when crashing is
+  // acceptable if the file can't be read anymore (like when it's on a removed drive or a dropped
+  // network share, or gets truncated): accessing the data then raises SIGBUS or
+  // EXCEPTION_IN_PAGE_ERROR instead of making Read return false.
+  virtual bool MapIntoMemory() { return false; }
+
+  // Returns a pointer to size bytes at offset if the blob's data is already in memory, and nullptr
+  // otherwise. The pointer stays valid for as long as the blob reader exists.
+  virtual const u8* GetDirectPointer(u64 offset, u64 size) const { return nullptr; }
+
   virtual bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const
   {
     return false;
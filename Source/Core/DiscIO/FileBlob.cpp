@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,21 +16,32 @@
 
 namespace DiscIO
 {
-PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
+PlainFileReader::PlainFileReader(File::IOFile file, const std::string& path)
+    : m_file(std::move(file)), m_path(path)
 {
   m_size = m_file.GetSize();
 }
 
-std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
+std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file, const std::string& path)
 {
   if (file)
-    return std::unique_ptr<PlainFileReader>(new PlainFileReader(std::move(file)));
+    return std::unique_ptr<PlainFileReader>(new PlainFileReader(std::move(file), path));
 
   return nullptr;
 }
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (m_mapped_file.IsOpen())
+  {
+    const u8* data = GetDirectPointer(offset, nbytes);
+    if (!data)
+      return false;
+
+    std::memcpy(out_ptr, data, nbytes);
+    return true;
+  }
+
   if (m_file.Seek(offset, SEEK_SET) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
@@ -41,6 +53,27 @@ bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   }
 }
 
+bool PlainFileReader::MapIntoMemory()
+{
+  if (m_mapped_file.IsOpen())
+    return true;
+
+  // Paths that can't be opened by the OS directly (like Android content URIs) keep using m_file
+  if (m_mapped_file.Open(m_path) && m_mapped_file.GetSize() != static_cast<u64>(m_size))
+    m_mapped_file.Close();
+
+  return m_mapped_file.IsOpen();
+}
+
+const u8* PlainFileReader::GetDirectPointer(u64 offset, u64 size) const
+{
+  const u64 mapped_size = m_mapped_file.GetSize();
+  if (!m_mapped_file.IsOpen() || offset > mapped_size || size > mapped_size - offset)
+    return nullptr;
+
+  return m_mapped_file.GetData() + offset;
+}
+
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
                     const std::string& outfile_path, CompressCB callback)
 {
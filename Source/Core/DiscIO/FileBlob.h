@@ -10,6 +10,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -17,7 +18,7 @@ namespace DiscIO
 class PlainFileReader : public BlobReader
 {
 public:
-  static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
+  static std::unique_ptr<PlainFileReader> Create(File::IOFile file, const std::string& path);
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
 
@@ -30,11 +31,17 @@ public:
   std::string GetCompressionMethod() const override { return {}; }
 
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
+  bool MapIntoMemory() override;
+  const u8* GetDirectPointer(u64 offset, u64 size) const override;
 
 private:
-  PlainFileReader(File::IOFile file);
+  PlainFileReader(File::IOFile file, const std::string& path);
 
   File::IOFile m_file;
+  std::string m_path;
+  // Used instead of m_file once the image is mapped into memory. Reads then become a memcpy from
+  // the page cache, and no seek or read calls are made.
+  File::MappedFile m_mapped_file;
   s64 m_size;
 };
 
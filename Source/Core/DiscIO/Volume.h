@@ -49,6 +49,14 @@ public:
   Volume() {}
   virtual ~Volume() {}
   virtual bool Read(u64 offset, u64 length, u8* buffer, const Partition& partition) const = 0;
+  // See BlobReader::MapIntoMemory.
+  virtual bool MapIntoMemory() { return false; }
+  // Returns a pointer to the data if it can be accessed without being copied, and nullptr
+  // otherwise. The pointer stays valid for as long as the volume exists.
+  virtual const u8* GetDirectPointer(u64 offset, u64 length, const Partition& partition) const
+  {
+    return nullptr;
+  }
   template <typename T>
   std::optional<T> ReadSwapped(u64 offset, const Partition& partition) const
   {
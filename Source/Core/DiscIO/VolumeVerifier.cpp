@@ -11,19 +11,19 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <unordered_set>
 
 #include <mbedtls/md5.h>
-#include <mbedtls/sha1.h>
 #include <pugixml.hpp>
 #include <unzip.h>
-#include <zlib.h>
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/HttpRequest.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
@@ -356,7 +356,8 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
   return {Status::Unknown, Common::GetStringT("Unknown disc")};
 }
 
-constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
+// Large enough that the blocks of eight Wii groups can be checked in parallel
+constexpr u64 DEFAULT_READ_SIZE = 0x1000000;
 
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
                                Hashes<bool> hashes_to_calculate)
@@ -604,6 +605,11 @@ bool VolumeVerifier::CheckPartition(const Partition& partition)
                         std::min(block_index + VolumeWii::BLOCKS_PER_GROUP, blocks)});
     }
 
+    // The first integrity check of a partition sets up its decryption key, which isn't thread
+    // safe. Get that out of the way here, since Process checks many blocks at once.
+    if (blocks != 0)
+      m_volume.CheckBlockIntegrity(0, partition);
+
     m_block_errors.emplace(partition, 0);
   }
 
@@ -1034,19 +1040,17 @@ void VolumeVerifier::SetUpHashing()
   std::sort(m_groups.begin(), m_groups.end(),
             [](const GroupToVerify& a, const GroupToVerify& b) { return a.offset < b.offset; });
 
-  if (m_hashes_to_calculate.crc32)
-    m_crc32_context = crc32(0, nullptr, 0);
-
   if (m_hashes_to_calculate.md5)
   {
     mbedtls_md5_init(&m_md5_context);
     mbedtls_md5_starts_ret(&m_md5_context);
   }
 
-  if (m_hashes_to_calculate.sha1)
+  if (!m_groups.empty())
   {
-    mbedtls_sha1_init(&m_sha1_context);
-    mbedtls_sha1_starts_ret(&m_sha1_context);
+    // The thread that calls ParallelFor also does its share of the work
+    const u32 threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    m_thread_pool.Start(threads, "Volume Verifier");
   }
 }
 
@@ -1098,6 +1102,7 @@ void VolumeVerifier::Process()
   IOS::ES::Content content{};
   bool content_read = false;
   bool group_read = false;
+  size_t groups_read = 0;
   u64 bytes_to_read = DEFAULT_READ_SIZE;
   u64 excess_bytes = 0;
   if (m_content_index < m_content_offsets.size() &&
@@ -1120,15 +1125,25 @@ void VolumeVerifier::Process()
   }
   else if (m_group_index < m_groups.size() && m_groups[m_group_index].offset == m_progress)
   {
-    const size_t blocks =
-        m_groups[m_group_index].block_index_end - m_groups[m_group_index].block_index_start;
-    bytes_to_read = VolumeWii::BLOCK_TOTAL_SIZE * blocks;
+    // Read all the directly following groups that fit, so that they can be checked in parallel
+    u64 end = m_progress;
+    do
+    {
+      const GroupToVerify& group = m_groups[m_group_index + groups_read];
+      end = group.offset +
+            VolumeWii::BLOCK_TOTAL_SIZE * (group.block_index_end - group.block_index_start);
+      ++groups_read;
+    } while (m_group_index + groups_read < m_groups.size() &&
+             m_groups[m_group_index + groups_read].offset == end &&
+             end - m_progress < DEFAULT_READ_SIZE);
+
+    bytes_to_read = end - m_progress;
     group_read = true;
 
-    if (m_group_index + 1 < m_groups.size() &&
-        m_groups[m_group_index + 1].offset < m_progress + bytes_to_read)
+    if (m_group_index + groups_read < m_groups.size() &&
+        m_groups[m_group_index + groups_read].offset < end)
     {
-      excess_bytes = m_progress + bytes_to_read - m_groups[m_group_index + 1].offset;
+      excess_bytes = end - m_groups[m_group_index + groups_read].offset;
     }
   }
   else if (m_group_index < m_groups.size() && m_groups[m_group_index].offset > m_progress)
@@ -1165,9 +1180,7 @@ void VolumeVerifier::Process()
     if (m_hashes_to_calculate.crc32)
     {
       m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        // It would be nice to use crc32_z here instead of crc32, but it isn't available on Android
-        m_crc32_context =
-            crc32(m_crc32_context, m_data.data(), static_cast<unsigned int>(byte_increment));
+        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data.data(), byte_increment);
       });
     }
 
@@ -1181,7 +1194,7 @@ void VolumeVerifier::Process()
     if (m_hashes_to_calculate.sha1)
     {
       m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_sha1_update_ret(&m_sha1_context, m_data.data(), byte_increment);
+        m_sha1_context.Update(m_data.data(), byte_increment);
       });
     }
   }
@@ -1200,43 +1213,77 @@ void VolumeVerifier::Process()
 
   if (group_read)
   {
-    m_group_future = std::async(std::launch::async, [this, read_succeeded,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
-
-        if (read_succeeded && m_volume.CheckBlockIntegrity(
-                                  block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
-      }
-    });
+    m_group_future =
+        std::async(std::launch::async, &VolumeVerifier::VerifyGroups, this, m_group_index,
+                   groups_read, m_progress, read_succeeded);
 
-    m_group_index++;
+    m_group_index += groups_read;
   }
 
   m_progress += byte_increment;
 }
 
+void VolumeVerifier::VerifyGroups(size_t first_group_index, size_t group_count, u64 data_offset,
+                                  bool read_succeeded)
+{
+  struct Block
+  {
+    const GroupToVerify* group;
+    u64 index;
+    u64 offset;
+  };
+
+  std::vector<Block> blocks;
+  for (size_t i = first_group_index; i < first_group_index + group_count; ++i)
+  {
+    const GroupToVerify& group = m_groups[i];
+    u64 offset = group.offset;
+    for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
+         ++block_index, offset += VolumeWii::BLOCK_TOTAL_SIZE)
+    {
+      blocks.push_back({&group, block_index, offset});
+    }
+  }
+
+  // Each block has its own hashes, so they can all be checked at once. Blocks that go past the end
+  // of the volume weren't read and count as invalid.
+  std::vector<u8> block_is_valid(blocks.size(), false);
+  if (read_succeeded)
+  {
+    const u64 data_end = data_offset + m_data.size();
+    m_thread_pool.ParallelFor(static_cast<u32>(blocks.size()), [&](u32 i) {
+      const Block& block = blocks[i];
+      if (block.offset + VolumeWii::BLOCK_TOTAL_SIZE > data_end)
+        return;
+      block_is_valid[i] = m_volume.CheckBlockIntegrity(
+          block.index, m_data.data() + (block.offset - data_offset), block.group->partition);
+    });
+  }
+
+  for (size_t i = 0; i < blocks.size(); ++i)
+  {
+    const Block& block = blocks[i];
+    if (block_is_valid[i])
+    {
+      m_biggest_verified_offset =
+          std::max(m_biggest_verified_offset, block.offset + VolumeWii::BLOCK_TOTAL_SIZE);
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(block.offset))
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block.offset);
+        m_unused_block_errors[block.group->partition]++;
+      }
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block.offset);
+        m_block_errors[block.group->partition]++;
+      }
+    }
+  }
+}
+
 u64 VolumeVerifier::GetBytesProcessed() const
 {
   return m_progress;
@@ -1273,8 +1320,8 @@ void VolumeVerifier::Finish()
 
     if (m_hashes_to_calculate.sha1)
     {
-      m_result.hashes.sha1 = std::vector<u8>(20);
-      mbedtls_sha1_finish_ret(&m_sha1_context, m_result.hashes.sha1.data());
+      const Common::SHA1::Digest sha1 = m_sha1_context.Finish();
+      m_result.hashes.sha1 = std::vector<u8>(sha1.begin(), sha1.end());
     }
   }
 
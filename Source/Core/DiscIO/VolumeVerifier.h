@@ -11,9 +11,10 @@
 #include <vector>
 
 #include <mbedtls/md5.h>
-#include <mbedtls/sha1.h>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/ThreadPool.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/Volume.h"
@@ -157,6 +158,8 @@ private:
   void SetUpHashing();
   void WaitForAsyncOperations() const;
   bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  void VerifyGroups(size_t first_group_index, size_t group_count, u64 data_offset,
+                    bool read_succeeded);
 
   void AddProblem(Severity severity, std::string text);
 
@@ -173,9 +176,9 @@ private:
 
   Hashes<bool> m_hashes_to_calculate{};
   bool m_calculating_any_hash = false;
-  unsigned long m_crc32_context = 0;
+  u32 m_crc32_context = 0;
   mbedtls_md5_context m_md5_context;
-  mbedtls_sha1_context m_sha1_context;
+  Common::SHA1::Context m_sha1_context;
 
   u64 m_excess_bytes = 0;
   std::vector<u8> m_data;
@@ -191,6 +194,7 @@ private:
   u16 m_content_index = 0;
   std::vector<GroupToVerify> m_groups;
   size_t m_group_index = 0;  // Index in m_groups, not index in a specific partition
+  Common::ThreadPool m_thread_pool;  // For checking the blocks of several groups at once
   std::map<Partition, size_t> m_block_errors;
   std::map<Partition, size_t> m_unused_block_errors;
 
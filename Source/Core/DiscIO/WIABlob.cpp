@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <limits>
 #include <map>
@@ -22,6 +23,7 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
 #include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
@@ -77,13 +79,32 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 
 template <bool RVZ>
 WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
-    : m_file(std::move(file)), m_encryption_cache(this)
+    : m_path(path), m_file(std::move(file)), m_encryption_cache(this)
 {
   m_valid = Initialize(path);
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::~WIARVZFileReader() = default;
+WIARVZFileReader<RVZ>::~WIARVZFileReader()
+{
+  m_read_ahead_thread.Cancel();
+
+  // Only readers that have read groups sequentially are interesting.
+  if (m_read_ahead_file.IsOpen())
+  {
+    const ChunkCacheStats stats = GetChunkCacheStats();
+    const u64 total = stats.hits + stats.read_ahead_hits + stats.misses;
+    const auto to_ms = [](std::chrono::nanoseconds time) {
+      return std::chrono::duration_cast<std::chrono::milliseconds>(time).count();
+    };
+    INFO_LOG_FMT(DISCIO,
+                 "Chunk cache of {}: {} hits, {} read-ahead hits, {} misses ({}% hit rate), "
+                 "{} ms reading, {} ms reading ahead",
+                 m_path, stats.hits, stats.read_ahead_hits, stats.misses,
+                 (stats.hits + stats.read_ahead_hits) * 100 / total, to_ms(stats.read_time),
+                 to_ms(stats.read_ahead_time));
+  }
+}
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
@@ -503,42 +524,31 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     if (total_group_index >= m_group_entries.size())
       return false;
 
-    const GroupEntry group = m_group_entries[total_group_index];
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
+    const u64 group_size = std::min(chunk_size, data_size - group_offset_in_data);
 
-    chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
-
-    const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
+    const u64 bytes_to_read = std::min(group_size - offset_in_group, *size);
+    const ChunkParameters parameters = GetGroupChunkParameters(
+        m_group_entries[total_group_index], group_size, group_offset_in_data, exception_lists);
 
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
-
-      group_data_size &= 0x7FFFFFFF;
-
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
-
-    if (group_data_size == 0)
+    if (parameters.compressed_size == 0)
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
-
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
-
-      if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
+      const auto start_time = std::chrono::steady_clock::now();
+      Chunk& chunk = ReadCompressedData(
+          parameters.offset_in_file, parameters.compressed_size, parameters.decompressed_size,
+          parameters.compression_type, parameters.exception_lists, parameters.rvz_packed_size,
+          parameters.data_offset);
+      const bool success = chunk.Read(offset_in_group, bytes_to_read, *out_ptr);
+      m_stats.read_time += std::chrono::steady_clock::now() - start_time;
+
+      if (!success)
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        InvalidateCachedChunk(parameters.offset_in_file);
         return false;
       }
 
@@ -553,6 +563,33 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
       }
     }
 
+    // Games that stream data read the groups in order, so the next ones can be decompressed
+    // before they're needed. A single step is no sign of that, as random reads can span groups.
+    if (total_group_index == m_last_group_index + 1)
+      ++m_sequential_groups;
+    else if (total_group_index != m_last_group_index)
+      m_sequential_groups = 0;
+
+    if (total_group_index != m_last_group_index && m_sequential_groups >= 2)
+    {
+      std::vector<ChunkParameters> read_ahead;
+      for (u64 j = i + 1; j <= i + READ_AHEAD_CHUNKS && j < number_of_groups; ++j)
+      {
+        const u64 next_offset_in_data = j * chunk_size;
+        if (group_index + j >= m_group_entries.size() || next_offset_in_data >= data_size)
+          break;
+
+        const ChunkParameters next = GetGroupChunkParameters(
+            m_group_entries[group_index + j],
+            std::min(chunk_size, data_size - next_offset_in_data), next_offset_in_data,
+            exception_lists);
+        if (next.compressed_size != 0)
+          read_ahead.push_back(next);
+      }
+      QueueReadAhead(read_ahead);
+    }
+    m_last_group_index = total_group_index;
+
     *offset += bytes_to_read;
     *size -= bytes_to_read;
     *out_ptr += bytes_to_read;
@@ -561,6 +598,30 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::ChunkParameters
+WIARVZFileReader<RVZ>::GetGroupChunkParameters(const GroupEntry& group, u64 group_size,
+                                               u64 group_offset_in_data, u32 exception_lists) const
+{
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  WIARVZCompressionType compression_type = m_compression_type;
+  u32 rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+  return {group_offset_in_file, group_data_size, group_size, compression_type, exception_lists,
+          rvz_packed_size, group_offset_in_data};
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -568,11 +629,61 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  for (auto it = m_cached_chunks.begin(); it != m_cached_chunks.end(); ++it)
+  {
+    if (it->first == offset_in_file)
+    {
+      ++m_stats.hits;
+      m_cached_chunks.splice(m_cached_chunks.begin(), m_cached_chunks, it);
+      return m_cached_chunks.front().second;
+    }
+  }
+
+  std::optional<Chunk> chunk;
+  {
+    // If the read-ahead thread is working on the chunk, waiting for it is faster than starting
+    // over on this thread.
+    std::unique_lock lock(m_read_ahead_mutex);
+    m_read_ahead_done.wait(lock, [&] { return m_read_ahead_pending.count(offset_in_file) == 0; });
+
+    const auto it = m_read_ahead_chunks.find(offset_in_file);
+    if (it != m_read_ahead_chunks.end())
+    {
+      chunk = std::move(it->second);
+      m_read_ahead_chunks.erase(it);
+    }
+  }
+
+  if (chunk)
+  {
+    ++m_stats.read_ahead_hits;
+  }
+  else
+  {
+    ++m_stats.misses;
+    chunk = CreateChunk(&m_file, {offset_in_file, compressed_size, decompressed_size,
+                                  compression_type, exception_lists, rvz_packed_size, data_offset});
+  }
+
+  m_cached_chunks.emplace_front(offset_in_file, std::move(*chunk));
+
+  const size_t max_cached_chunks =
+      std::clamp<size_t>(CHUNK_CACHE_SIZE / (2 * GetBlockSize()), 2, MAX_CACHED_CHUNKS);
+  while (m_cached_chunks.size() > max_cached_chunks)
+    m_cached_chunks.pop_back();
+
+  return m_cached_chunks.front().second;
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(File::IOFile* file, const ChunkParameters& parameters) const
+{
+  const u64 decompressed_size = parameters.decompressed_size;
+  const u32 rvz_packed_size = parameters.rvz_packed_size;
 
   std::unique_ptr<Decompressor> decompressor;
-  switch (compression_type)
+  switch (parameters.compression_type)
   {
   case WIARVZCompressionType::None:
     decompressor = std::make_unique<NoneDecompressor>();
@@ -597,13 +708,95 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
     break;
   }
 
-  const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
+  const bool compressed_exception_lists =
+      parameters.compression_type > WIARVZCompressionType::Purge;
+
+  return Chunk(file, parameters.offset_in_file, parameters.compressed_size, decompressed_size,
+               parameters.exception_lists, compressed_exception_lists, rvz_packed_size,
+               parameters.data_offset, std::move(decompressor));
+}
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::InvalidateCachedChunk(u64 offset_in_file)
+{
+  m_cached_chunks.remove_if([offset_in_file](const auto& entry) {
+    return entry.first == offset_in_file;
+  });
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::QueueReadAhead(const std::vector<ChunkParameters>& chunks)
+{
+  if (chunks.empty())
+    return;
+
+  const auto is_wanted = [&chunks](u64 offset_in_file) {
+    return std::any_of(chunks.begin(), chunks.end(), [offset_in_file](const auto& parameters) {
+      return parameters.offset_in_file == offset_in_file;
+    });
+  };
+  const auto is_cached = [this](u64 offset_in_file) {
+    return std::any_of(
+        m_cached_chunks.begin(), m_cached_chunks.end(),
+        [offset_in_file](const auto& entry) { return entry.first == offset_in_file; });
+  };
+
+  if (!m_read_ahead_file.IsOpen())
+  {
+    // The read-ahead thread gets its own file, so that it doesn't need to share the position of
+    // m_file with this thread.
+    if (!m_read_ahead_file.Open(m_path, "rb"))
+      return;
+    m_read_ahead_thread.Reset([this](ChunkParameters parameters) { ReadAhead(parameters); });
+  }
+
+  std::lock_guard lock(m_read_ahead_mutex);
+
+  // Chunks that were decompressed ahead of time but not read are dropped once reads move on.
+  for (auto it = m_read_ahead_chunks.begin(); it != m_read_ahead_chunks.end();)
+    it = is_wanted(it->first) ? std::next(it) : m_read_ahead_chunks.erase(it);
+
+  for (const ChunkParameters& parameters : chunks)
+  {
+    const u64 offset_in_file = parameters.offset_in_file;
+    if (m_read_ahead_pending.size() >= READ_AHEAD_CHUNKS)
+      break;
+    if (m_read_ahead_chunks.count(offset_in_file) != 0 ||
+        m_read_ahead_pending.count(offset_in_file) != 0 || is_cached(offset_in_file))
+    {
+      continue;
+    }
+
+    m_read_ahead_pending.insert(offset_in_file);
+    m_read_ahead_thread.EmplaceItem(parameters);
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ReadAhead(const ChunkParameters& parameters)
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  Chunk chunk = CreateChunk(&m_read_ahead_file, parameters);
+  const bool success = chunk.DecompressAll();
+  const auto elapsed = std::chrono::steady_clock::now() - start_time;
+
+  {
+    std::lock_guard lock(m_read_ahead_mutex);
+    m_read_ahead_pending.erase(parameters.offset_in_file);
+    if (success)
+      m_read_ahead_chunks.emplace(parameters.offset_in_file, std::move(chunk));
+    m_read_ahead_time += elapsed;
+  }
+  m_read_ahead_done.notify_all();
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::ChunkCacheStats WIARVZFileReader<RVZ>::GetChunkCacheStats() const
+{
+  ChunkCacheStats stats = m_stats;
+  std::lock_guard lock(m_read_ahead_mutex);
+  stats.read_ahead_time = m_read_ahead_time;
+  return stats;
 }
 
 template <bool RVZ>
@@ -646,17 +839,33 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (!DecompressTo(offset + size))
+    return false;
+
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  return DecompressTo(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressTo(u64 end_offset)
 {
   if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+      end_offset > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
   {
     return false;
   }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  while (end_offset > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end_offset == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -669,7 +878,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end_offset - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -749,7 +958,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1321,8 +1529,8 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
   {
     const PartitionEntry& partition_entry = partition_entries[parameters.data_entry->index];
 
-    mbedtls_aes_context aes_context;
-    mbedtls_aes_setkey_dec(&aes_context, partition_entry.partition_key.data(), 128);
+    const Common::AES::Context aes_context(partition_entry.partition_key.data(),
+                                           Common::AES::Mode::Decrypt);
 
     const u64 groups = Common::AlignUp(parameters.data.size(), VolumeWii::GROUP_TOTAL_SIZE) /
                        VolumeWii::GROUP_TOTAL_SIZE;
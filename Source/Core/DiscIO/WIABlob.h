@@ -5,16 +5,22 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <condition_variable>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <set>
+#include <string>
 #include <type_traits>
 #include <utility>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
 #include "Common/Swap.h"
+#include "Common/WorkQueueThread.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
 #include "DiscIO/WIACompression.h"
@@ -66,6 +72,20 @@ public:
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
                                       int compression_level, int chunk_size, CompressCB callback);
 
+  struct ChunkCacheStats
+  {
+    // Chunks that were still cached, chunks that were decompressed ahead of time on the read-ahead
+    // thread, and chunks that had to be decompressed when they were read.
+    u64 hits = 0;
+    u64 read_ahead_hits = 0;
+    u64 misses = 0;
+    // Time spent reading and decompressing chunks on the thread that called Read.
+    std::chrono::nanoseconds read_time{};
+    std::chrono::nanoseconds read_ahead_time{};
+  };
+
+  ChunkCacheStats GetChunkCacheStats() const;
+
 private:
   using SHA1 = std::array<u8, 20>;
   using WiiKey = std::array<u8, 16>;
@@ -186,6 +206,7 @@ private:
           u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
+    bool DecompressAll();
 
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
@@ -198,6 +219,7 @@ private:
     }
 
   private:
+    bool DecompressTo(u64 end_offset);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -227,12 +249,29 @@ private:
 
   const PartitionEntry* GetPartition(u64 partition_data_offset, u32* partition_first_sector) const;
 
+  struct ChunkParameters
+  {
+    u64 offset_in_file;
+    u64 compressed_size;
+    u64 decompressed_size;
+    WIARVZCompressionType compression_type;
+    u32 exception_lists;
+    u32 rvz_packed_size;
+    u64 data_offset;
+  };
+
   bool ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size, u32 sector_size,
                       u64 data_offset, u64 data_size, u32 group_index, u32 number_of_groups,
                       u32 exception_lists);
+  ChunkParameters GetGroupChunkParameters(const GroupEntry& group, u64 group_size,
+                                          u64 group_offset_in_data, u32 exception_lists) const;
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk CreateChunk(File::IOFile* file, const ChunkParameters& parameters) const;
+  void InvalidateCachedChunk(u64 offset_in_file);
+  void QueueReadAhead(const std::vector<ChunkParameters>& chunks);
+  void ReadAhead(const ChunkParameters& parameters);
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -357,11 +396,16 @@ private:
   bool m_valid;
   WIARVZCompressionType m_compression_type;
 
+  std::string m_path;
   File::IOFile m_file;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  // Most recently used first. Only accessed by the thread that calls Read.
+  std::list<std::pair<u64, Chunk>> m_cached_chunks;
+  u64 m_last_group_index = std::numeric_limits<u64>::max();
+  u32 m_sequential_groups = 0;
   WiiEncryptionCache m_encryption_cache;
 
+  ChunkCacheStats m_stats;
+
   std::vector<HashExceptionEntry> m_exception_list;
   bool m_write_to_exception_list = false;
   u64 m_exception_list_last_group_index;
@@ -374,6 +418,23 @@ private:
 
   std::map<u64, DataEntry> m_data_entries;
 
+  // Chunks which are decompressed ahead of time when groups are read sequentially. They're keyed
+  // by their offset in the file, like m_cached_chunks, and moved there once they're read.
+  mutable std::mutex m_read_ahead_mutex;
+  std::condition_variable m_read_ahead_done;
+  std::map<u64, Chunk> m_read_ahead_chunks;
+  std::set<u64> m_read_ahead_pending;
+  std::chrono::nanoseconds m_read_ahead_time{};
+  File::IOFile m_read_ahead_file;
+  // Started when a sequential read is first detected, so that readers which are only used for
+  // a few reads, like the ones of the game list, don't start a thread.
+  Common::WorkQueueThread<ChunkParameters> m_read_ahead_thread;
+
+  // Decompressed chunks are kept around up to about this many bytes, and at least two of them.
+  static constexpr u64 CHUNK_CACHE_SIZE = 0x2000000;
+  static constexpr size_t MAX_CACHED_CHUNKS = 64;
+  static constexpr size_t READ_AHEAD_CHUNKS = 2;
+
   // Perhaps we could set WIA_VERSION_WRITE_COMPATIBLE to 0.9, but WIA version 0.9 was never in
   // any official release of wit, and interim versions (either source or binaries) are hard to find.
   // Since we've been unable to check if we're write compatible with 0.9, we set it 1.0 to be safe.
@@ -0,0 +1,192 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "DolphinNoGUI/FifoBenchmark.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+#include <fmt/format.h>
+#include <picojson.h>
+
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/StringUtil.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+
+static double ToMilliseconds(std::chrono::nanoseconds time)
+{
+  return std::chrono::duration<double, std::milli>(time).count();
+}
+
+FifoBenchmark::FifoBenchmark(u32 loops, std::string output_path)
+    : m_loops(loops), m_output_path(std::move(output_path))
+{
+}
+
+FifoBenchmark::~FifoBenchmark()
+{
+  Stop();
+}
+
+void FifoBenchmark::Start(std::function<void()> done_callback)
+{
+  m_done_callback = std::move(done_callback);
+
+  // Run as fast as possible, and keep replaying the log until every loop has been played.
+  SConfig::GetInstance().m_EmulationSpeed = 0.0f;
+  SConfig::GetInstance().bLoopFifoReplay = true;
+
+  FifoPlayer::GetInstance().SetFrameWrittenCallback([this] { OnFifoFrameWritten(); });
+  g_stats.collect_timings = true;
+  g_stats.frame_end_callback = [this](const Statistics::ThisFrame& stats) {
+    OnVideoFrameEnd(stats);
+  };
+}
+
+void FifoBenchmark::Stop()
+{
+  m_done = true;
+  g_stats.collect_timings = false;
+  g_stats.frame_end_callback = nullptr;
+  FifoPlayer::GetInstance().SetFrameWrittenCallback(nullptr);
+}
+
+void FifoBenchmark::OnFifoFrameWritten()
+{
+  if (m_done)
+    return;
+
+  // This is called before each frame is written. Like on the video thread, the first frame is
+  // skipped, so that the CPU and video frame times line up.
+  const auto now = std::chrono::steady_clock::now();
+  if (m_fifo_frames_written > 1)
+    m_cpu_frame_times.push_back(now - m_last_fifo_frame);
+  m_last_fifo_frame = now;
+
+  const FifoPlayer& player = FifoPlayer::GetInstance();
+  const u32 frames_per_loop = player.GetFrameRangeEnd() - player.GetFrameRangeStart() + 1;
+  if (m_fifo_frames_written++ == m_loops * frames_per_loop && !m_done.exchange(true))
+    m_done_callback();
+}
+
+void FifoBenchmark::OnVideoFrameEnd(const Statistics::ThisFrame& stats)
+{
+  if (m_done)
+    return;
+
+  // The first frame also includes booting, so it only marks the start of the benchmark.
+  const auto now = std::chrono::steady_clock::now();
+  if (!m_video_frame_started)
+  {
+    m_video_frame_started = true;
+    m_last_video_frame = now;
+    return;
+  }
+
+  FrameResult& frame = m_frames.emplace_back();
+  frame.frame_time = now - m_last_video_frame;
+  frame.vertex_loader_time = stats.vertex_loader_time;
+  frame.texture_decode_time = stats.texture_decode_time;
+  frame.draw_calls = stats.num_draw_calls;
+  frame.primitives = stats.num_prims + stats.num_dl_prims;
+  frame.uniform_bytes = stats.bytes_uniform_streamed;
+  frame.rasterized_pixels = stats.rasterized_pixels;
+  m_last_video_frame = now;
+}
+
+std::string FifoBenchmark::ToCSV() const
+{
+  std::string csv = "frame,cpu_ms,video_ms,vertex_loader_ms,texture_decode_ms,draw_calls,"
+                    "primitives,uniform_bytes,rasterized_pixels\n";
+  for (size_t i = 0; i < m_frames.size(); ++i)
+  {
+    const FrameResult& frame = m_frames[i];
+    // The CPU thread can finish a frame before the video thread does, or the other way around
+    // at the very end, so there isn't always a CPU time for each video frame.
+    std::string cpu_ms;
+    if (i < m_cpu_frame_times.size())
+      cpu_ms = fmt::format("{:.4f}", ToMilliseconds(m_cpu_frame_times[i]));
+    csv += fmt::format("{},{},{:.4f},{:.4f},{:.4f},{},{},{},{}\n", i, cpu_ms,
+                       ToMilliseconds(frame.frame_time), ToMilliseconds(frame.vertex_loader_time),
+                       ToMilliseconds(frame.texture_decode_time), frame.draw_calls,
+                       frame.primitives, frame.uniform_bytes, frame.rasterized_pixels);
+  }
+  return csv;
+}
+
+std::string FifoBenchmark::ToJSON() const
+{
+  picojson::array cpu_frames;
+  for (const std::chrono::nanoseconds time : m_cpu_frame_times)
+    cpu_frames.emplace_back(ToMilliseconds(time));
+
+  picojson::array video_frames;
+  for (const FrameResult& frame : m_frames)
+  {
+    picojson::object object;
+    object["video_ms"] = picojson::value(ToMilliseconds(frame.frame_time));
+    object["vertex_loader_ms"] = picojson::value(ToMilliseconds(frame.vertex_loader_time));
+    object["texture_decode_ms"] = picojson::value(ToMilliseconds(frame.texture_decode_time));
+    object["draw_calls"] = picojson::value(static_cast<double>(frame.draw_calls));
+    object["primitives"] = picojson::value(static_cast<double>(frame.primitives));
+    object["uniform_bytes"] = picojson::value(static_cast<double>(frame.uniform_bytes));
+    object["rasterized_pixels"] = picojson::value(static_cast<double>(frame.rasterized_pixels));
+    video_frames.emplace_back(std::move(object));
+  }
+
+  picojson::object root;
+  root["video_backend"] = picojson::value(Config::Get(Config::MAIN_GFX_BACKEND));
+  root["loops"] = picojson::value(static_cast<double>(m_loops));
+  root["cpu_frames_ms"] = picojson::value(std::move(cpu_frames));
+  root["video_frames"] = picojson::value(std::move(video_frames));
+  return picojson::value(std::move(root)).serialize(true);
+}
+
+bool FifoBenchmark::WriteResults() const
+{
+  if (m_output_path.empty())
+    return true;
+
+  const std::string results = StringEndsWith(m_output_path, ".csv") ? ToCSV() : ToJSON();
+  if (!File::WriteStringToFile(m_output_path, results))
+  {
+    std::fprintf(stderr, "Failed to write benchmark results to %s\n", m_output_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+void FifoBenchmark::PrintSummary() const
+{
+  if (m_frames.empty())
+  {
+    std::fprintf(stderr, "No frames were rendered\n");
+    return;
+  }
+
+  std::vector<std::chrono::nanoseconds> frame_times;
+  std::chrono::nanoseconds total{}, vertex_loader{}, texture_decode{};
+  for (const FrameResult& frame : m_frames)
+  {
+    frame_times.push_back(frame.frame_time);
+    total += frame.frame_time;
+    vertex_loader += frame.vertex_loader_time;
+    texture_decode += frame.texture_decode_time;
+  }
+  std::sort(frame_times.begin(), frame_times.end());
+
+  const double frames = static_cast<double>(m_frames.size());
+  fmt::print("{} frames in {:.1f} ms, {:.1f} FPS\n", m_frames.size(), ToMilliseconds(total),
+             frames * 1000.0 / ToMilliseconds(total));
+  fmt::print("Frame time: median {:.3f} ms, 99th percentile {:.3f} ms, max {:.3f} ms\n",
+             ToMilliseconds(frame_times[frame_times.size() / 2]),
+             ToMilliseconds(frame_times[frame_times.size() * 99 / 100]),
+             ToMilliseconds(frame_times.back()));
+  fmt::print("Vertex loader: {:.3f} ms/frame, texture decoding: {:.3f} ms/frame\n",
+             ToMilliseconds(vertex_loader) / frames, ToMilliseconds(texture_decode) / frames);
+}
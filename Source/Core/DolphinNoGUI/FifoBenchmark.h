@@ -0,0 +1,72 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/Statistics.h"
+
+// Plays a FIFO log a fixed number of times as fast as possible and records the timings and
+// statistics of every frame, so that changes to the video code can be measured without a GPU.
+class FifoBenchmark
+{
+public:
+  FifoBenchmark(u32 loops, std::string output_path);
+  ~FifoBenchmark();
+
+  FifoBenchmark(const FifoBenchmark&) = delete;
+  FifoBenchmark& operator=(const FifoBenchmark&) = delete;
+
+  // Has to be called before the FIFO log is booted. done_callback is called from the CPU thread
+  // once every loop has been written to the FIFO.
+  void Start(std::function<void()> done_callback);
+
+  // Stops recording. Emulation has to be stopped before this is called.
+  void Stop();
+
+  // Writes the results as CSV if the output path ends in .csv and as JSON otherwise.
+  bool WriteResults() const;
+  void PrintSummary() const;
+
+private:
+  struct FrameResult
+  {
+    // Time since the end of the previous frame on the video thread.
+    std::chrono::nanoseconds frame_time;
+    std::chrono::nanoseconds vertex_loader_time;
+    std::chrono::nanoseconds texture_decode_time;
+    int draw_calls;
+    int primitives;
+    int uniform_bytes;
+    // Only counted by the software renderer.
+    int rasterized_pixels;
+  };
+
+  void OnFifoFrameWritten();
+  void OnVideoFrameEnd(const Statistics::ThisFrame& stats);
+
+  std::string ToCSV() const;
+  std::string ToJSON() const;
+
+  u32 m_loops;
+  std::string m_output_path;
+  std::function<void()> m_done_callback;
+  std::atomic<bool> m_done{false};
+
+  // Only touched by the CPU thread while running.
+  u32 m_fifo_frames_written = 0;
+  std::chrono::steady_clock::time_point m_last_fifo_frame;
+  std::vector<std::chrono::nanoseconds> m_cpu_frame_times;
+
+  // Only touched by the video thread while running.
+  bool m_video_frame_started = false;
+  std::chrono::steady_clock::time_point m_last_video_frame;
+  std::vector<FrameResult> m_frames;
+};
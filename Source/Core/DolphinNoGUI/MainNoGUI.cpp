@@ -8,8 +8,10 @@
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
+#include <optional>
 #include <signal.h>
 #include <string>
+#include <variant>
 #include <vector>
 
 #ifndef _WIN32
@@ -18,6 +20,7 @@
 #include <Windows.h>
 #endif
 
+#include "Common/FileUtil.h"
 #include "Common/StringUtil.h"
 #include "Core/Boot/Boot.h"
 #include "Core/BootManager.h"
@@ -25,12 +28,15 @@
 #include "Core/DolphinAnalytics.h"
 #include "Core/Host.h"
 
+#include "DolphinNoGUI/FifoBenchmark.h"
+
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
 #include "UICommon/DiscordPresence.h"
 #endif
 #include "UICommon/UICommon.h"
 
+#include "VideoCommon/PipelineUIDCorpus.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -166,10 +172,49 @@ int main(int argc, char* argv[])
             "win32"
 #endif
       });
+  parser->add_option("--benchmark")
+      .action("store")
+      .type("int")
+      .metavar("LOOPS")
+      .help("Play a FIFO log LOOPS times as fast as possible and report frame timings");
+  parser->add_option("--benchmark_output")
+      .action("store")
+      .metavar("FILE")
+      .help("Write per frame results to FILE, as CSV if it ends in .csv or JSON otherwise");
+  parser->add_option("--merge_pipeline_uids")
+      .action("store")
+      .metavar("FILE")
+      .help("Merge the .uidcache and .uidcorpus files given as arguments into the corpus FILE");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
 
+  if (options.is_set("merge_pipeline_uids"))
+  {
+    const std::string output_path = static_cast<const char*>(options.get("merge_pipeline_uids"));
+    VideoCommon::PipelineUIDCorpus corpus;
+    if (File::Exists(output_path) && !corpus.AddFile(output_path))
+    {
+      fprintf(stderr, "Failed to read %s\n", output_path.c_str());
+      return 1;
+    }
+    for (const std::string& path : args)
+    {
+      if (!corpus.AddFile(path))
+      {
+        fprintf(stderr, "Failed to read %s\n", path.c_str());
+        return 1;
+      }
+    }
+    if (!corpus.Save(output_path))
+    {
+      fprintf(stderr, "Failed to write %s\n", output_path.c_str());
+      return 1;
+    }
+    printf("Wrote %zu pipeline UIDs to %s\n", corpus.GetSize(), output_path.c_str());
+    return 0;
+  }
+
   std::optional<std::string> save_state_path;
   if (options.is_set("save_state"))
   {
@@ -210,6 +255,22 @@ int main(int argc, char* argv[])
     return 0;
   }
 
+  std::optional<FifoBenchmark> benchmark;
+  if (options.is_set("benchmark"))
+  {
+    const int loops = static_cast<int>(options.get("benchmark"));
+    if (loops <= 0 || !boot || !std::holds_alternative<BootParameters::DFF>(boot->parameters))
+    {
+      fprintf(stderr, "A benchmark needs a FIFO log and a positive number of loops.\n");
+      return 1;
+    }
+
+    std::string output_path;
+    if (options.is_set("benchmark_output"))
+      output_path = static_cast<const char*>(options.get("benchmark_output"));
+    benchmark.emplace(static_cast<u32>(loops), std::move(output_path));
+  }
+
   std::string user_directory;
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
@@ -248,6 +309,9 @@ int main(int argc, char* argv[])
   sigaction(SIGTERM, &sa, nullptr);
 #endif
 
+  if (benchmark)
+    benchmark->Start([] { s_platform->Stop(); });
+
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
   if (!BootManager::BootCore(std::move(boot), s_platform->GetWindowSystemInfo()))
@@ -264,8 +328,18 @@ int main(int argc, char* argv[])
   Core::Stop();
 
   Core::Shutdown();
+
+  int exit_code = 0;
+  if (benchmark)
+  {
+    benchmark->Stop();
+    benchmark->PrintSummary();
+    if (!benchmark->WriteResults())
+      exit_code = 1;
+  }
+
   s_platform.reset();
   UICommon::Shutdown();
 
-  return 0;
+  return exit_code;
 }
@@ -59,5 +59,7 @@ void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>
 
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
-void IncPerfCounterQuadCount(PerfQueryType type);
+// Counts num_pixels drawn pixels at once. The rasterizer gathers the counts per thread and adds
+// them once it is done drawing.
+void IncPerfCounterQuadCount(PerfQueryType type, u32 num_pixels);
 }  // namespace EfbInterface
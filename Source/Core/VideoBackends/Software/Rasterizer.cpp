@@ -5,12 +5,17 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
@@ -21,22 +26,69 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// Triangles are binned into square tiles of the EFB, which are then drawn in parallel. Each tile
+// draws its triangles in the order they were submitted and tiles never share a pixel, so the
+// result is exactly the same as drawing one triangle after the other.
+static constexpr s32 TILE_SIZE = 32;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0, "Blocks must not straddle tiles");
+static constexpr s32 NUM_TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr s32 NUM_TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+
+// Waking up the workers costs more than drawing a few small triangles.
+static constexpr u32 MIN_PIXELS_FOR_WORKERS = 64 * 64;
+// Bounds the size of the bins for draws with lots of triangles.
+static constexpr size_t MAX_BINNED_TRIANGLES = 4096;
+
+// Everything needed to draw a triangle, so that it can be drawn after it has been binned.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  s32 vertex0X;
+  s32 vertex0Y;
+  float vertexOffsetX;
+  float vertexOffsetY;
+
+  // Half-edge constants
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Scissored bounding rectangle, starting in the corner of a block
+  s32 minx, maxx, miny, maxy;
+};
+
+// The state of one thread drawing tiles
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  u32 rasterizedPixels = 0;
+};
+
+// Kept across triangles for zfreeze
 static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
 
-static s32 vertex0X;
-static s32 vertex0Y;
-static float vertexOffsetX;
-static float vertexOffsetY;
+static std::vector<RasterContext> contexts;
+static Common::ThreadPool workers;
 
-static Tev tev;
-static RasterBlock rasterBlock;
+static std::vector<TriangleSetup> binnedTriangles;
+static std::array<std::vector<u32>, NUM_TILES_X * NUM_TILES_Y> tileBins;
+static std::vector<u32> activeTiles;
+static u32 binnedPixels;
 
 void Init()
 {
-  tev.Init();
+  // The GPU thread draws tiles as well.
+  const u32 num_workers = g_ActiveConfig.GetSWRasterizerThreads();
+  contexts.clear();
+  contexts.resize(num_workers + 1);
+  for (RasterContext& context : contexts)
+    context.tev.Init();
+  workers.Start(num_workers, "SW Rasterizer");
 
   // Set initial z reference plane in the unlikely case that zfreeze is enabled when drawing the
   // first primitive.
@@ -45,6 +97,16 @@ void Init()
   ZSlope.f0 = 1.f;
 }
 
+void Shutdown()
+{
+  workers.Stop();
+  binnedTriangles.clear();
+  for (std::vector<u32>& bin : tileBins)
+    bin.clear();
+  activeTiles.clear();
+  binnedPixels = 0;
+}
+
 // Returns approximation of log2(f) in s28.4
 // results are close enough to use for LOD
 static s32 FixedLog2(float f)
@@ -69,32 +131,37 @@ static inline int iround(float x)
 
 void SetTevReg(int reg, int comp, s16 color)
 {
-  tev.SetRegColor(reg, comp, color);
+  for (RasterContext& context : contexts)
+    context.tev.SetRegColor(reg, comp, color);
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(RasterContext& context, const TriangleSetup& triangle, s32 x, s32 y, s32 xi,
+                 s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  context.rasterizedPixels++;
+
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
 
-  float dx = vertexOffsetX + (float)(x - vertex0X);
-  float dy = vertexOffsetY + (float)(y - vertex0Y);
+  float dx = triangle.vertexOffsetX + (float)(x - triangle.vertex0X);
+  float dy = triangle.vertexOffsetY + (float)(y - triangle.vertex0Y);
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(triangle.ZSlope.GetValue(dx, dy), 0.0f, 16777215.0f);
 
   if (bpmem.UseEarlyDepthTest() && g_ActiveConfig.bZComploc)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    tev.Stats.perf_pixels[PQ_ZCOMP_INPUT_ZCOMPLOC]++;
     if (bpmem.zmode.testenable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    tev.Stats.perf_pixels[PQ_ZCOMP_OUTPUT_ZCOMPLOC]++;
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -105,7 +172,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(dx, dy);
+      u16 color = (u16)triangle.ColorSlopes[i][comp].GetValue(dx, dy);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -137,16 +204,16 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static void InitTriangle(float X1, float Y1, s32 xi, s32 yi)
+static void InitTriangle(TriangleSetup* triangle, float X1, float Y1, s32 xi, s32 yi)
 {
-  vertex0X = xi;
-  vertex0Y = yi;
+  triangle->vertex0X = xi;
+  triangle->vertex0Y = yi;
 
   // adjust a little less than 0.5
   const float adjust = 0.495f;
 
-  vertexOffsetX = ((float)xi - X1) + adjust;
-  vertexOffsetY = ((float)yi - Y1) + adjust;
+  triangle->vertexOffsetX = ((float)xi - X1) + adjust;
+  triangle->vertexOffsetY = ((float)yi - Y1) + adjust;
 }
 
 static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, float DX12,
@@ -162,7 +229,8 @@ static void InitSlope(Slope* slope, float f1, float f2, float f3, float DX31, fl
   slope->f0 = f1;
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   const FourTexUnits& texUnit = bpmem.tex[(texmap >> 2) & 1];
   const u8 subTexmap = texmap & 3;
@@ -175,17 +243,17 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   float sDelta, tDelta;
   if (tm0.diag_lod == LODType::Diagonal)
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][1].Uv[texcoord];
 
     sDelta = fabsf(uv0[0] - uv1[0]);
     tDelta = fabsf(uv0[1] - uv1[1]);
   }
   else
   {
-    float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
-    float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
-    float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
+    const float* uv0 = rasterBlock.Pixel[0][0].Uv[texcoord];
+    const float* uv1 = rasterBlock.Pixel[1][0].Uv[texcoord];
+    const float* uv2 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
     sDelta = std::max(fabsf(uv0[0] - uv1[0]), fabsf(uv0[0] - uv2[0]));
     tDelta = std::max(fabsf(uv0[1] - uv1[1]), fabsf(uv0[1] - uv2[1]));
@@ -211,30 +279,33 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterContext& context, const TriangleSetup& triangle, s32 blockX,
+                       s32 blockY)
 {
+  RasterBlock& rasterBlock = context.rasterBlock;
+
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
     for (s32 xi = 0; xi < BLOCK_SIZE; xi++)
     {
       RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
-      float dx = vertexOffsetX + (float)(xi + blockX - vertex0X);
-      float dy = vertexOffsetY + (float)(yi + blockY - vertex0Y);
+      float dx = triangle.vertexOffsetX + (float)(xi + blockX - triangle.vertex0X);
+      float dy = triangle.vertexOffsetY + (float)(yi + blockY - triangle.vertex0Y);
 
-      float invW = 1.0f / WSlope.GetValue(dx, dy);
+      float invW = 1.0f / triangle.WSlope.GetValue(dx, dy);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(dx, dy) * invW;
+        float q = triangle.TexSlopes[i][2].GetValue(dx, dy) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(dx, dy) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(dx, dy) * projection;
+        pixel.Uv[i][0] = triangle.TexSlopes[i][0].GetValue(dx, dy) * projection;
+        pixel.Uv[i][1] = triangle.TexSlopes[i][1].GetValue(dx, dy) * projection;
       }
     }
   }
@@ -247,7 +318,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texcoord = indref & 3;
     indref >>= 3;
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -259,16 +331,16 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
 
-void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                           const OutputVertexData* v2)
+// Returns false if nothing of the triangle is left after scissoring.
+static bool SetupTriangle(const OutputVertexData* v0, const OutputVertexData* v1,
+                          const OutputVertexData* v2, TriangleSetup* triangle)
 {
-  INCSTAT(g_stats.this_frame.num_triangles_drawn);
-
   // adapted from http://devmaster.net/posts/6145/advanced-rasterization
 
   // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
@@ -290,15 +362,6 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -331,7 +394,7 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   maxy = std::min(maxy, scissorBottom);
 
   if (minx >= maxx || miny >= maxy)
-    return;
+    return false;
 
   // Setup slopes
   float fltx1 = v0->screenPosition.x;
@@ -341,11 +404,11 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   float fltdy12 = flty1 - v1->screenPosition.y;
   float fltdy31 = v2->screenPosition.y - flty1;
 
-  InitTriangle(fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
+  InitTriangle(triangle, fltx1, flty1, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4);
 
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  InitSlope(&WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+  InitSlope(&triangle->WSlope, w[0], w[1], w[2], fltdx31, fltdx12, fltdy12, fltdy31);
 
   // TODO: The zfreeze emulation is not quite correct, yet!
   // Many things might prevent us from reaching this line (culling, clipping, scissoring).
@@ -356,19 +419,21 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   if (!bpmem.genMode.zfreeze || !g_ActiveConfig.bZFreeze)
     InitSlope(&ZSlope, v0->screenPosition[2], v1->screenPosition[2], v2->screenPosition[2], fltdx31,
               fltdx12, fltdy12, fltdy31);
+  triangle->ZSlope = ZSlope;
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      InitSlope(&ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp], v2->color[i][comp],
-                fltdx31, fltdx12, fltdy12, fltdy31);
+      InitSlope(&triangle->ColorSlopes[i][comp], v0->color[i][comp], v1->color[i][comp],
+                v2->color[i][comp], fltdx31, fltdx12, fltdy12, fltdy31);
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
-      InitSlope(&TexSlopes[i][comp], v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                v2->texCoords[i][comp] * w[2], fltdx31, fltdx12, fltdy12, fltdy31);
+      InitSlope(&triangle->TexSlopes[i][comp], v0->texCoords[i][comp] * w[0],
+                v1->texCoords[i][comp] * w[1], v2->texCoords[i][comp] * w[2], fltdx31, fltdx12,
+                fltdy12, fltdy31);
   }
 
   // Half-edge constants
@@ -384,9 +449,55 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  triangle->C1 = C1;
+  triangle->C2 = C2;
+  triangle->C3 = C3;
+  triangle->DX12 = DX12;
+  triangle->DX23 = DX23;
+  triangle->DX31 = DX31;
+  triangle->DY12 = DY12;
+  triangle->DY23 = DY23;
+  triangle->DY31 = DY31;
+
   // Start in corner of 8x8 block
-  minx &= ~(BLOCK_SIZE - 1);
-  miny &= ~(BLOCK_SIZE - 1);
+  triangle->minx = minx & ~(BLOCK_SIZE - 1);
+  triangle->miny = miny & ~(BLOCK_SIZE - 1);
+  triangle->maxx = maxx;
+  triangle->maxy = maxy;
+
+  return true;
+}
+
+// Draws the blocks of the triangle which start within the given rectangle.
+static void DrawTriangle(RasterContext& context, const TriangleSetup& triangle, s32 left, s32 top,
+                         s32 right, s32 bottom)
+{
+  const s32 C1 = triangle.C1;
+  const s32 C2 = triangle.C2;
+  const s32 C3 = triangle.C3;
+
+  const s32 DX12 = triangle.DX12;
+  const s32 DX23 = triangle.DX23;
+  const s32 DX31 = triangle.DX31;
+
+  const s32 DY12 = triangle.DY12;
+  const s32 DY23 = triangle.DY23;
+  const s32 DY31 = triangle.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  // Both are multiples of BLOCK_SIZE, so this stays on the block grid of the whole triangle.
+  const s32 minx = std::max(triangle.minx, left);
+  const s32 miny = std::max(triangle.miny, top);
+  const s32 maxx = std::min(triangle.maxx, right);
+  const s32 maxy = std::min(triangle.maxy, bottom);
 
   // Loop through blocks
   for (s32 y = miny; y < maxy; y += BLOCK_SIZE)
@@ -422,7 +533,7 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context, triangle, x, y);
 
       // Accept whole block when totally covered
       if (a == 0xF && b == 0xF && c == 0xF)
@@ -431,7 +542,7 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(context, triangle, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -451,7 +562,7 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
           {
             if (CX1 > 0 && CX2 > 0 && CX3 > 0)
             {
-              Draw(x + ix, y + iy, ix, iy);
+              Draw(context, triangle, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -467,4 +578,118 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
     }
   }
 }
+
+static bool UseWorkers()
+{
+  // The TEV debug dumps go through buffers shared by all pixels.
+  return workers.GetNumThreads() != 0 && !g_ActiveConfig.bDumpTevStages &&
+         !g_ActiveConfig.bDumpTevTextureFetches;
+}
+
+static void BinTriangle(const TriangleSetup& triangle)
+{
+  const u32 index = static_cast<u32>(binnedTriangles.size());
+  binnedTriangles.push_back(triangle);
+
+  const s32 first_tile_x = triangle.minx / TILE_SIZE;
+  const s32 last_tile_x = (triangle.maxx - 1) / TILE_SIZE;
+  const s32 first_tile_y = triangle.miny / TILE_SIZE;
+  const s32 last_tile_y = (triangle.maxy - 1) / TILE_SIZE;
+  for (s32 tile_y = first_tile_y; tile_y <= last_tile_y; tile_y++)
+  {
+    for (s32 tile_x = first_tile_x; tile_x <= last_tile_x; tile_x++)
+    {
+      const u32 tile = static_cast<u32>(tile_y * NUM_TILES_X + tile_x);
+      if (tileBins[tile].empty())
+        activeTiles.push_back(tile);
+      tileBins[tile].push_back(index);
+    }
+  }
+
+  binnedPixels +=
+      static_cast<u32>((triangle.maxx - triangle.minx) * (triangle.maxy - triangle.miny));
+}
+
+static void DrawTile(RasterContext& context, u32 tile)
+{
+  const s32 left = static_cast<s32>(tile % NUM_TILES_X) * TILE_SIZE;
+  const s32 top = static_cast<s32>(tile / NUM_TILES_X) * TILE_SIZE;
+  for (u32 index : tileBins[tile])
+    DrawTriangle(context, binnedTriangles[index], left, top, left + TILE_SIZE, top + TILE_SIZE);
+  tileBins[tile].clear();
+}
+
+static void DrawBinnedTriangles()
+{
+  if (activeTiles.empty())
+    return;
+
+  if (binnedPixels < MIN_PIXELS_FOR_WORKERS)
+  {
+    for (u32 tile : activeTiles)
+      DrawTile(contexts[0], tile);
+  }
+  else
+  {
+    // One task per context, each pulling tiles until there are none left.
+    std::atomic<u32> next_tile{0};
+    workers.ParallelFor(static_cast<u32>(contexts.size()), [&](u32 i) {
+      for (u32 t = next_tile.fetch_add(1, std::memory_order_relaxed); t < activeTiles.size();
+           t = next_tile.fetch_add(1, std::memory_order_relaxed))
+      {
+        DrawTile(contexts[i], activeTiles[t]);
+      }
+    });
+  }
+
+  binnedTriangles.clear();
+  activeTiles.clear();
+  binnedPixels = 0;
+}
+
+void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
+                           const OutputVertexData* v2)
+{
+  INCSTAT(g_stats.this_frame.num_triangles_drawn);
+
+  TriangleSetup triangle;
+  if (!SetupTriangle(v0, v1, v2, &triangle))
+    return;
+
+  if (!UseWorkers())
+  {
+    DrawTriangle(contexts[0], triangle, 0, 0, EFB_WIDTH, EFB_HEIGHT);
+    return;
+  }
+
+  BinTriangle(triangle);
+  if (binnedTriangles.size() >= MAX_BINNED_TRIANGLES)
+    DrawBinnedTriangles();
+}
+
+void Flush()
+{
+  DrawBinnedTriangles();
+
+  for (RasterContext& context : contexts)
+  {
+    Tev::PixelStats& stats = context.tev.Stats;
+
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, context.rasterizedPixels);
+    ADDSTAT(g_stats.this_frame.tev_pixels_in, stats.pixels_in);
+    ADDSTAT(g_stats.this_frame.tev_pixels_out, stats.pixels_out);
+
+    for (u32 type = 0; type < PQ_NUM_MEMBERS; type++)
+    {
+      if (stats.perf_pixels[type] != 0)
+        EfbInterface::IncPerfCounterQuadCount(PerfQueryType(type), stats.perf_pixels[type]);
+    }
+
+    if (stats.bbox_left <= stats.bbox_right)
+      BoundingBox::Update(stats.bbox_left, stats.bbox_right, stats.bbox_top, stats.bbox_bottom);
+
+    context.rasterizedPixels = 0;
+    stats = {};
+  }
+}
 }  // namespace Rasterizer
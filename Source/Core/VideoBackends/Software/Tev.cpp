@@ -10,18 +10,21 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "VideoBackends/Software/DebugUtil.h"
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
-#include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #ifdef _DEBUG
 #define ALLOW_TEV_DUMPS 1
 #else
@@ -345,6 +348,161 @@ void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const Inpu
     Reg[u32(ac.dest.Value())][ALP_C] = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
 }
 
+void Tev::ClampColor(const TevStageCombiner::ColorCombiner& cc)
+{
+  s16* dest = Reg[u32(cc.dest.Value())];
+  if (cc.clamp)
+  {
+    dest[RED_C] = Clamp255(dest[RED_C]);
+    dest[GRN_C] = Clamp255(dest[GRN_C]);
+    dest[BLU_C] = Clamp255(dest[BLU_C]);
+  }
+  else
+  {
+    dest[RED_C] = Clamp1024(dest[RED_C]);
+    dest[GRN_C] = Clamp1024(dest[GRN_C]);
+    dest[BLU_C] = Clamp1024(dest[BLU_C]);
+  }
+}
+
+void Tev::ClampAlpha(const TevStageCombiner::AlphaCombiner& ac)
+{
+  s16* dest = Reg[u32(ac.dest.Value())];
+  dest[ALP_C] = ac.clamp ? Clamp255(dest[ALP_C]) : Clamp1024(dest[ALP_C]);
+}
+
+#if defined(_M_X86) || defined(_M_ARM_64)
+// Per channel parameters of a color and an alpha combiner, in the same order as the registers.
+struct CombinerLanes
+{
+  s32 lshift[4];
+  s32 rshift[4];
+  s32 bias[4];
+  s32 round[4];
+  // The color combiner negates after dividing by 256, the alpha combiner before.
+  s32 negate_before[4];
+  s32 negate_after[4];
+  s32 min[4];
+  s32 max[4];
+};
+
+template <typename T>
+static void SetLanes(s32 (&lanes)[4], T color, T alpha)
+{
+  static_assert(Tev::ALP_C == 0, "The alpha channel has to be the first lane");
+  lanes[Tev::ALP_C] = s32(alpha);
+  lanes[Tev::BLU_C] = lanes[Tev::GRN_C] = lanes[Tev::RED_C] = s32(color);
+}
+#endif
+
+void Tev::DrawRegular(const TevStageCombiner::ColorCombiner& cc,
+                      const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4])
+{
+#if defined(_M_X86) || defined(_M_ARM_64)
+  CombinerLanes lanes;
+  const u32 color_scale = u32(cc.scale.Value());
+  const u32 alpha_scale = u32(ac.scale.Value());
+  SetLanes(lanes.lshift, m_ScaleLShiftLUT[color_scale], m_ScaleLShiftLUT[alpha_scale]);
+  SetLanes(lanes.rshift, m_ScaleRShiftLUT[color_scale], m_ScaleRShiftLUT[alpha_scale]);
+  SetLanes(lanes.bias, m_BiasLUT[u32(cc.bias.Value())], m_BiasLUT[u32(ac.bias.Value())]);
+  SetLanes(lanes.round,
+           (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128,
+           (ac.scale != TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128);
+  SetLanes(lanes.negate_before, 0, ac.op == TevOp::Sub ? -1 : 0);
+  SetLanes(lanes.negate_after, cc.op == TevOp::Sub ? -1 : 0, 0);
+  SetLanes(lanes.min, cc.clamp ? 0 : -1024, ac.clamp ? 0 : -1024);
+  SetLanes(lanes.max, cc.clamp ? 255 : 1023, ac.clamp ? 255 : 1023);
+
+  alignas(16) s32 a[4], b[4], c[4], d[4];
+  for (int i = 0; i < 4; i++)
+  {
+    a[i] = inputs[i].a;
+    b[i] = inputs[i].b;
+    c[i] = inputs[i].c + (inputs[i].c >> 7);
+    d[i] = inputs[i].d;
+  }
+
+  alignas(16) s32 result[4];
+#if defined(_M_X86)
+  const auto load = [](const s32* lane) {
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(lane));
+  };
+
+  // The weights are at most 1024, so madd can compute a * (256 - c) + b * c from 16 bit values.
+  // Scaling the weights is the same as scaling the sum, and SSE2 has no per lane shifts.
+  const __m128i factor = _mm_packs_epi32(
+      _mm_set_epi32(1 << lanes.lshift[3], 1 << lanes.lshift[2], 1 << lanes.lshift[1],
+                    1 << lanes.lshift[0]),
+      _mm_setzero_si128());
+  const __m128i c16 = _mm_packs_epi32(load(c), _mm_setzero_si128());
+  const __m128i weight_a = _mm_mullo_epi16(_mm_sub_epi16(_mm_set1_epi16(256), c16), factor);
+  const __m128i weight_b = _mm_mullo_epi16(c16, factor);
+  const __m128i inputs_ab =
+      _mm_unpacklo_epi16(_mm_packs_epi32(load(a), _mm_setzero_si128()),
+                         _mm_packs_epi32(load(b), _mm_setzero_si128()));
+  __m128i temp = _mm_madd_epi16(inputs_ab, _mm_unpacklo_epi16(weight_a, weight_b));
+
+  temp = _mm_add_epi32(temp, load(lanes.round));
+  const __m128i negate_before = load(lanes.negate_before);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before), negate_before);
+  temp = _mm_srai_epi32(temp, 8);
+  const __m128i negate_after = load(lanes.negate_after);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_after), negate_after);
+
+  // (d + bias) << lshift, sign extended from the 16 bit product.
+  const __m128i biased_d = _mm_packs_epi32(_mm_add_epi32(load(d), load(lanes.bias)),
+                                           _mm_setzero_si128());
+  const __m128i scaled_d = _mm_mullo_epi16(biased_d, factor);
+  __m128i sum = _mm_add_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(scaled_d, scaled_d), 16), temp);
+
+  // The right shift is either 0 or 1.
+  const __m128i divide = _mm_cmpgt_epi32(load(lanes.rshift), _mm_setzero_si128());
+  sum = _mm_or_si128(_mm_and_si128(divide, _mm_srai_epi32(sum, 1)),
+                     _mm_andnot_si128(divide, sum));
+
+  // Clamping the 16 bit values gives the same result as the scalar code, which stores the result
+  // in a 16 bit register before clamping it.
+  const __m128i min16 = _mm_packs_epi32(load(lanes.min), _mm_setzero_si128());
+  const __m128i max16 = _mm_packs_epi32(load(lanes.max), _mm_setzero_si128());
+  __m128i sum16 = _mm_packs_epi32(sum, _mm_setzero_si128());
+  sum16 = _mm_min_epi16(_mm_max_epi16(sum16, min16), max16);
+  _mm_store_si128(reinterpret_cast<__m128i*>(result),
+                  _mm_srai_epi32(_mm_unpacklo_epi16(sum16, sum16), 16));
+#else
+  const int32x4_t lshift = vld1q_s32(lanes.lshift);
+  int32x4_t temp = vmulq_s32(vld1q_s32(a), vshlq_s32(vsubq_s32(vdupq_n_s32(256), vld1q_s32(c)),
+                                                    lshift));
+  temp = vmlaq_s32(temp, vld1q_s32(b), vshlq_s32(vld1q_s32(c), lshift));
+
+  temp = vaddq_s32(temp, vld1q_s32(lanes.round));
+  const int32x4_t negate_before = vld1q_s32(lanes.negate_before);
+  temp = vsubq_s32(veorq_s32(temp, negate_before), negate_before);
+  temp = vshrq_n_s32(temp, 8);
+  const int32x4_t negate_after = vld1q_s32(lanes.negate_after);
+  temp = vsubq_s32(veorq_s32(temp, negate_after), negate_after);
+
+  int32x4_t sum = vshlq_s32(vaddq_s32(vld1q_s32(d), vld1q_s32(lanes.bias)), lshift);
+  sum = vaddq_s32(sum, temp);
+  // Shifting left by a negative amount is an arithmetic right shift.
+  sum = vshlq_s32(sum, vnegq_s32(vld1q_s32(lanes.rshift)));
+
+  sum = vminq_s32(vmaxq_s32(sum, vld1q_s32(lanes.min)), vld1q_s32(lanes.max));
+  vst1q_s32(result, sum);
+#endif
+
+  s16* color_dest = Reg[u32(cc.dest.Value())];
+  color_dest[BLU_C] = result[BLU_C];
+  color_dest[GRN_C] = result[GRN_C];
+  color_dest[RED_C] = result[RED_C];
+  Reg[u32(ac.dest.Value())][ALP_C] = result[ALP_C];
+#else
+  DrawColorRegular(cc, inputs);
+  ClampColor(cc);
+  DrawAlphaRegular(ac, inputs);
+  ClampAlpha(ac);
+#endif
+}
+
 static bool AlphaCompare(int alpha, int ref, CompareMode comp)
 {
   switch (comp)
@@ -544,7 +702,7 @@ void Tev::Draw()
   ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
   ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
+  Stats.pixels_in++;
 
   // initial color values
   for (int i = 0; i < 4; i++)
@@ -555,6 +713,11 @@ void Tev::Draw()
     Reg[i][ALP_C] = PixelShaderManager::constants.colors[i][3];
   }
 
+  // Stages can read these without setting them first. Don't let them carry over from whichever
+  // pixel this Tev happened to draw before, that depends on how the tiles were split up.
+  std::memset(TexColor, 0, sizeof(TexColor));
+  std::memset(IndirectTex, 0, sizeof(IndirectTex));
+
   for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
   {
     const int stageNum2 = stageNum >> 1;
@@ -667,33 +830,24 @@ void Tev::Draw()
     inputs[ALP_C].c = *m_AlphaInputLUT[u32(ac.c.Value())];
     inputs[ALP_C].d = *m_AlphaInputLUT[u32(ac.d.Value())];
 
-    if (cc.bias != TevBias::Compare)
-      DrawColorRegular(cc, inputs);
-    else
-      DrawColorCompare(cc, inputs);
-
-    if (cc.clamp)
+    if (cc.bias != TevBias::Compare && ac.bias != TevBias::Compare)
     {
-      Reg[u32(cc.dest.Value())][RED_C] = Clamp255(Reg[u32(cc.dest.Value())][RED_C]);
-      Reg[u32(cc.dest.Value())][GRN_C] = Clamp255(Reg[u32(cc.dest.Value())][GRN_C]);
-      Reg[u32(cc.dest.Value())][BLU_C] = Clamp255(Reg[u32(cc.dest.Value())][BLU_C]);
+      DrawRegular(cc, ac, inputs);
     }
     else
     {
-      Reg[u32(cc.dest.Value())][RED_C] = Clamp1024(Reg[u32(cc.dest.Value())][RED_C]);
-      Reg[u32(cc.dest.Value())][GRN_C] = Clamp1024(Reg[u32(cc.dest.Value())][GRN_C]);
-      Reg[u32(cc.dest.Value())][BLU_C] = Clamp1024(Reg[u32(cc.dest.Value())][BLU_C]);
-    }
-
-    if (ac.bias != TevBias::Compare)
-      DrawAlphaRegular(ac, inputs);
-    else
-      DrawAlphaCompare(ac, inputs);
+      if (cc.bias != TevBias::Compare)
+        DrawColorRegular(cc, inputs);
+      else
+        DrawColorCompare(cc, inputs);
+      ClampColor(cc);
 
-    if (ac.clamp)
-      Reg[u32(ac.dest.Value())][ALP_C] = Clamp255(Reg[u32(ac.dest.Value())][ALP_C]);
-    else
-      Reg[u32(ac.dest.Value())][ALP_C] = Clamp1024(Reg[u32(ac.dest.Value())][ALP_C]);
+      if (ac.bias != TevBias::Compare)
+        DrawAlphaRegular(ac, inputs);
+      else
+        DrawAlphaCompare(ac, inputs);
+      ClampAlpha(ac);
+    }
 
 #if ALLOW_TEV_DUMPS
     if (g_ActiveConfig.bDumpTevStages)
@@ -830,18 +984,20 @@ void Tev::Draw()
   if (late_ztest && bpmem.zmode.testenable)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    Stats.perf_pixels[PQ_ZCOMP_INPUT]++;
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    Stats.perf_pixels[PQ_ZCOMP_OUTPUT]++;
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BoundingBox::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  Stats.bbox_left = std::min(Stats.bbox_left, static_cast<u16>(Position[0] & ~1));
+  Stats.bbox_right = std::max(Stats.bbox_right, static_cast<u16>(Position[0] | 1));
+  Stats.bbox_top = std::min(Stats.bbox_top, static_cast<u16>(Position[1] & ~1));
+  Stats.bbox_bottom = std::max(Stats.bbox_bottom, static_cast<u16>(Position[1] | 1));
 
 #if ALLOW_TEV_DUMPS
   if (g_ActiveConfig.bDumpTevStages)
@@ -863,8 +1019,8 @@ void Tev::Draw()
   }
 #endif
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  Stats.pixels_out++;
+  Stats.perf_pixels[PQ_BLEND_INPUT]++;
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
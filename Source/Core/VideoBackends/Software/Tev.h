@@ -4,7 +4,11 @@
 
 #pragma once
 
+#include <array>
+
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -63,6 +67,13 @@ class Tev
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
+  void ClampColor(const TevStageCombiner::ColorCombiner& cc);
+  void ClampAlpha(const TevStageCombiner::AlphaCombiner& ac);
+
+  // Same as DrawColorRegular and DrawAlphaRegular followed by the clamps, with all four channels
+  // evaluated at once.
+  void DrawRegular(const TevStageCombiner::ColorCombiner& cc,
+                   const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
@@ -75,6 +86,20 @@ public:
   s32 TextureLod[16];
   bool TextureLinear[16];
 
+  // Draw() gathers these instead of updating the statistics, perf counters and bounding box for
+  // every pixel, so that one Tev per rasterizer thread can draw at the same time.
+  struct PixelStats
+  {
+    u32 pixels_in = 0;
+    u32 pixels_out = 0;
+    std::array<u32, PQ_NUM_MEMBERS> perf_pixels{};
+    u16 bbox_left = 0xffff;
+    u16 bbox_right = 0;
+    u16 bbox_top = 0xffff;
+    u16 bbox_bottom = 0;
+  };
+  PixelStats Stats;
+
   enum
   {
     ALP_C,
@@ -6,8 +6,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Core/HW/Memmap.h"
 
@@ -17,6 +19,10 @@
 
 #define ALLOW_MIPMAP 1
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 namespace TextureSampler
 {
 static inline void WrapCoord(int* coordp, WrapMode wrapMode, int imageSize)
@@ -46,21 +52,93 @@ static inline void WrapCoord(int* coordp, WrapMode wrapMode, int imageSize)
   *coordp = coord;
 }
 
-static inline void SetTexel(const u8* inTexel, u32* outTexel, u32 fract)
+// BlendTexels sets outTexel to the weighted sum of two or four RGBA8 texels, shifted right by
+// shift. The weights have to fit in 15 bits.
+#if defined(_M_X86)
+static inline __m128i WeightTexels(const u8* texel0, const u8* texel1, u32 weight0, u32 weight1)
+{
+  u32 t0, t1;
+  std::memcpy(&t0, texel0, sizeof(u32));
+  std::memcpy(&t1, texel1, sizeof(u32));
+
+  // Interleave the channels of both texels, so that madd multiplies and adds them pairwise.
+  const __m128i texels = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(t0), _mm_cvtsi32_si128(t1)), _mm_setzero_si128());
+  return _mm_madd_epi16(texels, _mm_set1_epi32(weight0 | (weight1 << 16)));
+}
+
+static inline void StoreTexel(__m128i sum, int shift, u8* outTexel)
+{
+  sum = _mm_srli_epi32(sum, shift);
+  sum = _mm_packs_epi32(sum, sum);
+  const u32 result = _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+  std::memcpy(outTexel, &result, sizeof(u32));
+}
+
+static inline void BlendTexels(const u8* texel0, const u8* texel1, u32 weight0, u32 weight1,
+                               int shift, u8* outTexel)
+{
+  StoreTexel(WeightTexels(texel0, texel1, weight0, weight1), shift, outTexel);
+}
+
+static inline void BlendTexels(const u8 texels[4][4], const u32 weights[4], int shift,
+                               u8* outTexel)
+{
+  const __m128i sum = _mm_add_epi32(WeightTexels(texels[0], texels[1], weights[0], weights[1]),
+                                    WeightTexels(texels[2], texels[3], weights[2], weights[3]));
+  StoreTexel(sum, shift, outTexel);
+}
+#elif defined(_M_ARM_64)
+static inline uint16x4_t LoadTexel(const u8* texel)
+{
+  u32 value;
+  std::memcpy(&value, texel, sizeof(u32));
+  return vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(value))));
+}
+
+static inline void StoreTexel(uint32x4_t sum, int shift, u8* outTexel)
+{
+  const uint16x4_t narrow = vmovn_u32(vshlq_u32(sum, vdupq_n_s32(-shift)));
+  const u32 result = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(narrow, narrow))), 0);
+  std::memcpy(outTexel, &result, sizeof(u32));
+}
+
+static inline void BlendTexels(const u8* texel0, const u8* texel1, u32 weight0, u32 weight1,
+                               int shift, u8* outTexel)
+{
+  uint32x4_t sum = vmull_n_u16(LoadTexel(texel0), weight0);
+  sum = vmlal_n_u16(sum, LoadTexel(texel1), weight1);
+  StoreTexel(sum, shift, outTexel);
+}
+
+static inline void BlendTexels(const u8 texels[4][4], const u32 weights[4], int shift,
+                               u8* outTexel)
+{
+  uint32x4_t sum = vmull_n_u16(LoadTexel(texels[0]), weights[0]);
+  sum = vmlal_n_u16(sum, LoadTexel(texels[1]), weights[1]);
+  sum = vmlal_n_u16(sum, LoadTexel(texels[2]), weights[2]);
+  sum = vmlal_n_u16(sum, LoadTexel(texels[3]), weights[3]);
+  StoreTexel(sum, shift, outTexel);
+}
+#else
+static inline void BlendTexels(const u8* texel0, const u8* texel1, u32 weight0, u32 weight1,
+                               int shift, u8* outTexel)
 {
-  outTexel[0] = inTexel[0] * fract;
-  outTexel[1] = inTexel[1] * fract;
-  outTexel[2] = inTexel[2] * fract;
-  outTexel[3] = inTexel[3] * fract;
+  for (int i = 0; i < 4; i++)
+    outTexel[i] = (u8)((texel0[i] * weight0 + texel1[i] * weight1) >> shift);
 }
 
-static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
+static inline void BlendTexels(const u8 texels[4][4], const u32 weights[4], int shift,
+                               u8* outTexel)
 {
-  outTexel[0] += inTexel[0] * fract;
-  outTexel[1] += inTexel[1] * fract;
-  outTexel[2] += inTexel[2] * fract;
-  outTexel[3] += inTexel[3] * fract;
+  for (int i = 0; i < 4; i++)
+  {
+    const u32 sum = texels[0][i] * weights[0] + texels[1][i] * weights[1] +
+                    texels[2][i] * weights[2] + texels[3][i] * weights[3];
+    outTexel[i] = (u8)(sum >> shift);
+  }
 }
+#endif
 
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 {
@@ -86,19 +164,12 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 
   if (mipLinear)
   {
-    u8 sampledTex[4];
-    u32 texel[4];
+    u8 sampledTex[2][4];
 
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
-    SetTexel(sampledTex, texel, (16 - lodFract));
+    SampleMip(s, t, baseMip, linear, texmap, sampledTex[0]);
+    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex[1]);
 
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
-    AddTexel(sampledTex, texel, lodFract);
-
-    sample[0] = (u8)(texel[0] >> 4);
-    sample[1] = (u8)(texel[1] >> 4);
-    sample[2] = (u8)(texel[2] >> 4);
-    sample[3] = (u8)(texel[3] >> 4);
+    BlendTexels(sampledTex[0], sampledTex[1], 16 - lodFract, lodFract, 4, sample);
   }
   else
 #endif
@@ -184,55 +255,38 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
-
     WrapCoord(&imageS, tm0.wrap_s, imageWidth);
     WrapCoord(&imageT, tm0.wrap_t, imageHeight);
     WrapCoord(&imageSPlus1, tm0.wrap_s, imageWidth);
     WrapCoord(&imageTPlus1, tm0.wrap_t, imageHeight);
 
+    u8 sampledTex[4][4];
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1[subTexmap].cache_manually_managed))
     {
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
+      TexDecoder_DecodeTexel(sampledTex[0], imageSrc, imageS, imageT, imageWidth, texfmt, tlut,
                              tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageT, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageTPlus1, imageWidth, texfmt, tlut,
-                             tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
+      TexDecoder_DecodeTexel(sampledTex[1], imageSrc, imageSPlus1, imageT, imageWidth, texfmt,
+                             tlut, tlutfmt);
+      TexDecoder_DecodeTexel(sampledTex[2], imageSrc, imageS, imageTPlus1, imageWidth, texfmt,
+                             tlut, tlutfmt);
+      TexDecoder_DecodeTexel(sampledTex[3], imageSrc, imageSPlus1, imageTPlus1, imageWidth, texfmt,
                              tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageT,
-                                          imageWidth);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1, imageT,
-                                          imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageS, imageTPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[0], imageSrc, imageSrcOdd, imageS, imageT,
                                           imageWidth);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, imageSrc, imageSrcOdd, imageSPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[1], imageSrc, imageSrcOdd, imageSPlus1,
+                                          imageT, imageWidth);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[2], imageSrc, imageSrcOdd, imageS,
+                                          imageTPlus1, imageWidth);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[3], imageSrc, imageSrcOdd, imageSPlus1,
                                           imageTPlus1, imageWidth);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
 
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    const u32 weights[4] = {u32((128 - fractS) * (128 - fractT)), u32(fractS * (128 - fractT)),
+                            u32((128 - fractS) * fractT), u32(fractS * fractT)};
+    BlendTexels(sampledTex, weights, 14, sample);
   }
   else
   {
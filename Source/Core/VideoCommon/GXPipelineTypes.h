@@ -23,6 +23,9 @@ namespace VideoCommon
 // TODO: Remove PixelShaderUid hasindstage on the next UID version bump
 constexpr u32 GX_PIPELINE_UID_VERSION = 2;  // Last changed in PR 9122
 
+// Magic of the per-game files that the UIDs of newly used pipelines are appended to.
+constexpr u32 GX_PIPELINE_UID_CACHE_MAGIC = 0x44495550;  // PUID
+
 struct GXPipelineUid
 {
   const NativeVertexFormat* vertex_format;
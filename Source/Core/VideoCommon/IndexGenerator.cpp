@@ -9,14 +9,223 @@
 #include <cstring>
 
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/OpcodeDecoding.h"
-#include "VideoCommon/VideoConfig.h"
+
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
 
 namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+// The indices of a group of primitives, relative to the first vertex of the group. Long draws are
+// written a whole group at a time with vectors of 8 indices, which only need one add per vector
+// to move on to the next group.
+template <size_t N>
+struct IndexPattern
+{
+  static_assert(N % 8 == 0, "Patterns must consist of whole vectors");
+
+  constexpr void SetVertex(size_t lane, u16 offset)
+  {
+    indices[lane] = offset;
+    base_mask[lane] = UINT16_MAX;
+    advance_mask[lane] = UINT16_MAX;
+  }
+
+  // A vertex that is shared by all groups, like the center of a fan.
+  constexpr void SetFixedVertex(size_t lane, u16 offset)
+  {
+    indices[lane] = offset;
+    base_mask[lane] = UINT16_MAX;
+    advance_mask[lane] = 0;
+  }
+
+  constexpr void SetRestart(size_t lane)
+  {
+    indices[lane] = s_primitive_restart;
+    base_mask[lane] = 0;
+    advance_mask[lane] = 0;
+  }
+
+  std::array<u16, N> indices{};
+  // Lanes which are offset by the first vertex of the draw.
+  std::array<u16, N> base_mask{};
+  // Lanes which are offset by the number of vertices of every preceding group.
+  std::array<u16, N> advance_mask{};
+  // The number of vertices that a group consumes.
+  u16 vertices = 0;
+};
+
+// Points, line lists, triangle lists and strips with primitive restart.
+constexpr auto s_consecutive_pattern = [] {
+  IndexPattern<24> pattern;
+  for (size_t lane = 0; lane < 24; lane++)
+    pattern.SetVertex(lane, static_cast<u16>(lane));
+  pattern.vertices = 24;
+  return pattern;
+}();
+
+// 6 triangles, each followed by a restart.
+constexpr auto s_list_pr_pattern = [] {
+  IndexPattern<24> pattern;
+  for (size_t lane = 0; lane < 24; lane++)
+  {
+    if (lane % 4 == 3)
+      pattern.SetRestart(lane);
+    else
+      pattern.SetVertex(lane, static_cast<u16>(lane / 4 * 3 + lane % 4));
+  }
+  pattern.vertices = 18;
+  return pattern;
+}();
+
+// 8 triangles, with every other one wound the other way.
+constexpr auto s_strip_pattern = [] {
+  IndexPattern<24> pattern;
+  for (size_t lane = 0; lane < 24; lane++)
+  {
+    const size_t triangle = lane / 3;
+    size_t vertex = lane % 3;
+    if (triangle % 2 != 0 && vertex != 0)
+      vertex = 3 - vertex;
+    pattern.SetVertex(lane, static_cast<u16>(triangle + vertex));
+  }
+  pattern.vertices = 8;
+  return pattern;
+}();
+
+// 8 triangles around the first vertex.
+constexpr auto s_fan_pattern = [] {
+  IndexPattern<24> pattern;
+  for (size_t lane = 0; lane < 24; lane++)
+  {
+    if (lane % 3 == 0)
+      pattern.SetFixedVertex(lane, 0);
+    else
+      pattern.SetVertex(lane, static_cast<u16>(lane / 3 + lane % 3));
+  }
+  pattern.vertices = 8;
+  return pattern;
+}();
+
+// 4 strips of 3 triangles, see AddFan.
+constexpr auto s_fan_pr_pattern = [] {
+  constexpr std::array<u16, 6> strip = {1, 2, 0, 3, 4, s_primitive_restart};
+  IndexPattern<24> pattern;
+  for (size_t lane = 0; lane < 24; lane++)
+  {
+    const u16 vertex = strip[lane % 6];
+    if (vertex == s_primitive_restart)
+      pattern.SetRestart(lane);
+    else if (vertex == 0)
+      pattern.SetFixedVertex(lane, 0);
+    else
+      pattern.SetVertex(lane, static_cast<u16>(lane / 6 * 3 + vertex));
+  }
+  pattern.vertices = 12;
+  return pattern;
+}();
+
+// 4 quads of 2 triangles, see AddQuads.
+constexpr auto s_quads_pattern = [] {
+  constexpr std::array<u16, 6> quad = {0, 1, 2, 0, 2, 3};
+  IndexPattern<24> pattern;
+  for (size_t lane = 0; lane < 24; lane++)
+    pattern.SetVertex(lane, static_cast<u16>(lane / 6 * 4 + quad[lane % 6]));
+  pattern.vertices = 16;
+  return pattern;
+}();
+
+// 8 quads as strips of 4 vertices.
+constexpr auto s_quads_pr_pattern = [] {
+  constexpr std::array<u16, 5> quad = {1, 2, 0, 3, s_primitive_restart};
+  IndexPattern<40> pattern;
+  for (size_t lane = 0; lane < 40; lane++)
+  {
+    if (quad[lane % 5] == s_primitive_restart)
+      pattern.SetRestart(lane);
+    else
+      pattern.SetVertex(lane, static_cast<u16>(lane / 5 * 4 + quad[lane % 5]));
+  }
+  pattern.vertices = 32;
+  return pattern;
+}();
+
+// 12 lines, each starting at the end of the previous one.
+constexpr auto s_line_strip_pattern = [] {
+  IndexPattern<24> pattern;
+  for (size_t lane = 0; lane < 24; lane++)
+    pattern.SetVertex(lane, static_cast<u16>(lane / 2 + lane % 2));
+  pattern.vertices = 12;
+  return pattern;
+}();
+
+template <size_t N>
+u16* WritePatterns(u16* index_ptr, const IndexPattern<N>& pattern, u32 index, u32 num_groups)
+{
+  constexpr size_t num_vectors = N / 8;
+
+#if defined(_M_X86)
+  const __m128i base = _mm_set1_epi16(static_cast<s16>(index));
+  const __m128i advance = _mm_set1_epi16(static_cast<s16>(pattern.vertices));
+  __m128i indices[num_vectors];
+  __m128i steps[num_vectors];
+  for (size_t i = 0; i < num_vectors; i++)
+  {
+    const auto load = [i](const std::array<u16, N>& lanes) {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lanes[i * 8]));
+    };
+    indices[i] = _mm_add_epi16(load(pattern.indices), _mm_and_si128(base, load(pattern.base_mask)));
+    steps[i] = _mm_and_si128(advance, load(pattern.advance_mask));
+  }
+
+  for (u32 group = 0; group < num_groups; group++, index_ptr += N)
+  {
+    for (size_t i = 0; i < num_vectors; i++)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr + i * 8), indices[i]);
+      indices[i] = _mm_add_epi16(indices[i], steps[i]);
+    }
+  }
+#elif defined(_M_ARM_64)
+  const uint16x8_t base = vdupq_n_u16(static_cast<u16>(index));
+  const uint16x8_t advance = vdupq_n_u16(pattern.vertices);
+  uint16x8_t indices[num_vectors];
+  uint16x8_t steps[num_vectors];
+  for (size_t i = 0; i < num_vectors; i++)
+  {
+    indices[i] = vaddq_u16(vld1q_u16(&pattern.indices[i * 8]),
+                           vandq_u16(base, vld1q_u16(&pattern.base_mask[i * 8])));
+    steps[i] = vandq_u16(advance, vld1q_u16(&pattern.advance_mask[i * 8]));
+  }
+
+  for (u32 group = 0; group < num_groups; group++, index_ptr += N)
+  {
+    for (size_t i = 0; i < num_vectors; i++)
+    {
+      vst1q_u16(index_ptr + i * 8, indices[i]);
+      indices[i] = vaddq_u16(indices[i], steps[i]);
+    }
+  }
+#else
+  for (u32 group = 0; group < num_groups; group++)
+  {
+    const u32 group_index = group * pattern.vertices;
+    for (size_t i = 0; i < N; i++)
+    {
+      *index_ptr++ = pattern.indices[i] + (index & pattern.base_mask[i]) +
+                     (group_index & pattern.advance_mask[i]);
+    }
+  }
+#endif
+
+  return index_ptr;
+}
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -31,7 +240,11 @@ u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 template <bool pr>
 u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 2; i < num_verts; i += 3)
+  constexpr auto& pattern = pr ? s_list_pr_pattern : s_consecutive_pattern;
+  const u32 num_groups = num_verts / pattern.vertices;
+  index_ptr = WritePatterns(index_ptr, pattern, index, num_groups);
+
+  for (u32 i = num_groups * pattern.vertices + 2; i < num_verts; i += 3)
   {
     index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
   }
@@ -43,7 +256,10 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
+    const u32 num_groups = num_verts / s_consecutive_pattern.vertices;
+    index_ptr = WritePatterns(index_ptr, s_consecutive_pattern, index, num_groups);
+
+    for (u32 i = num_groups * s_consecutive_pattern.vertices; i < num_verts; ++i)
     {
       *index_ptr++ = index + i;
     }
@@ -51,8 +267,12 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   }
   else
   {
+    const u32 num_groups = num_verts > 2 ? (num_verts - 2) / s_strip_pattern.vertices : 0;
+    index_ptr = WritePatterns(index_ptr, s_strip_pattern, index, num_groups);
+
+    // Groups have an even number of triangles, so the winding starts over.
     bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    for (u32 i = num_groups * s_strip_pattern.vertices + 2; i < num_verts; ++i)
     {
       index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
 
@@ -84,7 +304,11 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 template <bool pr>
 u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 {
-  u32 i = 2;
+  constexpr auto& pattern = pr ? s_fan_pr_pattern : s_fan_pattern;
+  const u32 num_groups = num_verts > 2 ? (num_verts - 2) / pattern.vertices : 0;
+  index_ptr = WritePatterns(index_ptr, pattern, index, num_groups);
+
+  u32 i = num_groups * pattern.vertices + 2;
 
   if constexpr (pr)
   {
@@ -136,6 +360,19 @@ template <bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
   u32 i = 3;
+  if constexpr (pr)
+  {
+    const u32 num_groups = num_verts / s_quads_pr_pattern.vertices;
+    index_ptr = WritePatterns(index_ptr, s_quads_pr_pattern, index, num_groups);
+    i += num_groups * s_quads_pr_pattern.vertices;
+  }
+  else
+  {
+    const u32 num_groups = num_verts / s_quads_pattern.vertices;
+    index_ptr = WritePatterns(index_ptr, s_quads_pattern, index, num_groups);
+    i += num_groups * s_quads_pattern.vertices;
+  }
+
   for (; i < num_verts; i += 4)
   {
     if constexpr (pr)
@@ -171,7 +408,10 @@ u16* AddQuads_nonstandard(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; i += 2)
+  const u32 num_groups = num_verts / s_consecutive_pattern.vertices;
+  index_ptr = WritePatterns(index_ptr, s_consecutive_pattern, index, num_groups);
+
+  for (u32 i = num_groups * s_consecutive_pattern.vertices + 1; i < num_verts; i += 2)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -183,7 +423,10 @@ u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
 // so converting them to lists
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
+  const u32 num_groups = num_verts > 1 ? (num_verts - 1) / s_line_strip_pattern.vertices : 0;
+  index_ptr = WritePatterns(index_ptr, s_line_strip_pattern, index, num_groups);
+
+  for (u32 i = num_groups * s_line_strip_pattern.vertices + 1; i < num_verts; ++i)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -193,7 +436,10 @@ u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 
 u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 0; i != num_verts; ++i)
+  const u32 num_groups = num_verts / s_consecutive_pattern.vertices;
+  index_ptr = WritePatterns(index_ptr, s_consecutive_pattern, index, num_groups);
+
+  for (u32 i = num_groups * s_consecutive_pattern.vertices; i != num_verts; ++i)
   {
     *index_ptr++ = index + i;
   }
@@ -201,9 +447,9 @@ u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 }
 }  // Anonymous namespace
 
-void IndexGenerator::Init()
+void IndexGenerator::Init(bool primitive_restart)
 {
-  if (g_Config.backend_info.bSupportsPrimitiveRestart)
+  if (primitive_restart)
   {
     m_primitive_table[OpcodeDecoder::GX_DRAW_QUADS] = AddQuads<true>;
     m_primitive_table[OpcodeDecoder::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
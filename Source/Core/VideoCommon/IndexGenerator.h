@@ -13,7 +13,9 @@
 class IndexGenerator
 {
 public:
-  void Init();
+  // With primitive restart, triangles are written as strips which are separated by restart
+  // indices. Without it, they're written as a list.
+  void Init(bool primitive_restart);
   void Start(u16* index_ptr);
 
   void AddIndices(int primitive, u32 num_vertices);
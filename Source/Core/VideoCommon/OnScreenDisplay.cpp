@@ -97,7 +97,9 @@ static float DrawMessage(int index, Message& msg, const ImVec2& position, int ti
 
 void AddTypedMessage(MessageType type, std::string message, u32 ms, u32 argb)
 {
+#ifdef ANDROID
   argb = *AndroidTheme::GetInt();
+#endif
   std::lock_guard lock{s_messages_mutex};
   s_messages.erase(type);
   s_messages.emplace(type, Message(std::move(message), Common::Timer::GetTimeMs() + ms, ms, argb));
@@ -105,7 +107,9 @@ void AddTypedMessage(MessageType type, std::string message, u32 ms, u32 argb)
 
 void AddMessage(std::string message, u32 ms, u32 argb)
 {
+#ifdef ANDROID
   argb = *AndroidTheme::GetInt();
+#endif
   std::lock_guard lock{s_messages_mutex};
   s_messages.emplace(MessageType::Typeless,
                      Message(std::move(message), Common::Timer::GetTimeMs() + ms, ms, argb));
@@ -0,0 +1,175 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/PipelineUIDCorpus.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace VideoCommon
+{
+constexpr u32 CORPUS_FILE_MAGIC = 0x43495550;  // PUIC
+constexpr u32 CORPUS_FILE_VERSION = 1;
+
+namespace
+{
+// Everything is stored in little endian, like the UIDs themselves.
+struct CorpusHeader
+{
+  u32 magic;
+  u32 version;
+  u32 uid_version;
+  // Lets files from builds with a different UID layout be rejected even without a version bump.
+  u32 uid_size;
+  u32 num_entries;
+};
+
+#pragma pack(push, 1)
+struct CorpusEntry
+{
+  SerializedGXPipelineUid uid;
+  u32 first_seen;
+  u32 sessions;
+};
+#pragma pack(pop)
+
+struct UIDCacheHeader
+{
+  u32 magic;
+  u32 version;
+};
+}  // namespace
+
+void PipelineUIDCorpus::AddSession(const std::vector<SerializedGXPipelineUid>& uids)
+{
+  // A session may contain a UID more than once, if its UID cache was rewritten.
+  PipelineUIDCorpus session;
+  for (size_t i = 0; i < uids.size(); i++)
+    session.m_entries.emplace(uids[i], Entry{uids[i], static_cast<u32>(i), 1});
+
+  Merge(session);
+}
+
+void PipelineUIDCorpus::Merge(const PipelineUIDCorpus& other)
+{
+  for (const auto& it : other.m_entries)
+    AddEntry(it.second);
+}
+
+void PipelineUIDCorpus::AddEntry(const Entry& entry)
+{
+  const auto [iter, inserted] = m_entries.emplace(entry.uid, entry);
+  if (inserted)
+    return;
+
+  iter->second.first_seen = std::min(iter->second.first_seen, entry.first_seen);
+  iter->second.sessions += entry.sessions;
+}
+
+bool PipelineUIDCorpus::AddFile(const std::string& filename)
+{
+  File::IOFile file(filename, "rb");
+  std::vector<u8> data(file.GetSize());
+  if (!file.ReadBytes(data.data(), data.size()))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to read pipeline UIDs from {}", filename);
+    return false;
+  }
+
+  u32 magic = 0;
+  if (data.size() >= sizeof(magic))
+    std::memcpy(&magic, data.data(), sizeof(magic));
+
+  if ((magic == CORPUS_FILE_MAGIC && ReadCorpus(data)) ||
+      (magic == GX_PIPELINE_UID_CACHE_MAGIC && ReadUIDCache(data)))
+  {
+    return true;
+  }
+
+  ERROR_LOG_FMT(VIDEO, "{} is not a pipeline UID file of this version", filename);
+  return false;
+}
+
+bool PipelineUIDCorpus::ReadCorpus(const std::vector<u8>& data)
+{
+  CorpusHeader header;
+  if (data.size() < sizeof(header))
+    return false;
+  std::memcpy(&header, data.data(), sizeof(header));
+
+  if (header.version != CORPUS_FILE_VERSION || header.uid_version != GX_PIPELINE_UID_VERSION ||
+      header.uid_size != sizeof(SerializedGXPipelineUid) ||
+      data.size() != sizeof(header) + u64{header.num_entries} * sizeof(CorpusEntry))
+  {
+    return false;
+  }
+
+  const u8* src = data.data() + sizeof(header);
+  for (u32 i = 0; i < header.num_entries; i++, src += sizeof(CorpusEntry))
+  {
+    CorpusEntry entry;
+    std::memcpy(&entry, src, sizeof(entry));
+    AddEntry(Entry{entry.uid, entry.first_seen, entry.sessions});
+  }
+
+  return true;
+}
+
+bool PipelineUIDCorpus::ReadUIDCache(const std::vector<u8>& data)
+{
+  UIDCacheHeader header;
+  if (data.size() < sizeof(header))
+    return false;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (header.version != GX_PIPELINE_UID_VERSION)
+    return false;
+
+  // An entry that was cut off when the game was closed is skipped.
+  std::vector<SerializedGXPipelineUid> uids((data.size() - sizeof(header)) /
+                                            sizeof(SerializedGXPipelineUid));
+  const u8* src = data.data() + sizeof(header);
+  for (size_t i = 0; i < uids.size(); i++, src += sizeof(SerializedGXPipelineUid))
+    std::memcpy(&uids[i], src, sizeof(SerializedGXPipelineUid));
+  AddSession(uids);
+  return true;
+}
+
+bool PipelineUIDCorpus::Save(const std::string& filename) const
+{
+  const std::vector<Entry> entries = GetEntriesInCompileOrder();
+  const CorpusHeader header = {CORPUS_FILE_MAGIC, CORPUS_FILE_VERSION, GX_PIPELINE_UID_VERSION,
+                               sizeof(SerializedGXPipelineUid), static_cast<u32>(entries.size())};
+
+  File::IOFile file(filename, "wb");
+  bool success = file.WriteArray(&header, 1);
+  for (const Entry& entry : entries)
+  {
+    const CorpusEntry disk_entry = {entry.uid, entry.first_seen, entry.sessions};
+    success = success && file.WriteArray(&disk_entry, 1);
+  }
+
+  if (!success)
+    ERROR_LOG_FMT(VIDEO, "Failed to write pipeline UIDs to {}", filename);
+  return success;
+}
+
+std::vector<PipelineUIDCorpus::Entry> PipelineUIDCorpus::GetEntriesInCompileOrder() const
+{
+  std::vector<Entry> entries;
+  entries.reserve(m_entries.size());
+  for (const auto& it : m_entries)
+    entries.push_back(it.second);
+
+  // Stable, so that the result doesn't depend on how the corpus was merged.
+  std::stable_sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) {
+    if (lhs.first_seen != rhs.first_seen)
+      return lhs.first_seen < rhs.first_seen;
+    return lhs.sessions > rhs.sessions;
+  });
+  return entries;
+}
+}  // namespace VideoCommon
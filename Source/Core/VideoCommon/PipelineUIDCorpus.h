@@ -0,0 +1,63 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/GXPipelineTypes.h"
+
+namespace VideoCommon
+{
+// The deduplicated pipeline UIDs of any number of play sessions of one game. Corpora can be
+// merged and shipped per game ID, so that the pipelines are compiled before the game needs them,
+// starting with the ones that are needed earliest.
+class PipelineUIDCorpus
+{
+public:
+  struct Entry
+  {
+    SerializedGXPipelineUid uid;
+    // The earliest position at which the UID was first used in any session.
+    u32 first_seen;
+    // The number of sessions that used the UID.
+    u32 sessions;
+  };
+
+  // Adds the UIDs of one session, in the order in which they were first used.
+  void AddSession(const std::vector<SerializedGXPipelineUid>& uids);
+
+  void Merge(const PipelineUIDCorpus& other);
+
+  // Merges a corpus file, or adds a .uidcache file of the shader cache as one session.
+  // Returns false if the file can't be read or is from another version.
+  bool AddFile(const std::string& filename);
+
+  bool Save(const std::string& filename) const;
+
+  // Sorted by the position the UIDs were first seen at, and then by how many sessions used them.
+  std::vector<Entry> GetEntriesInCompileOrder() const;
+
+  size_t GetSize() const { return m_entries.size(); }
+
+private:
+  struct UIDLess
+  {
+    bool operator()(const SerializedGXPipelineUid& lhs, const SerializedGXPipelineUid& rhs) const
+    {
+      return std::memcmp(&lhs, &rhs, sizeof(lhs)) < 0;
+    }
+  };
+
+  void AddEntry(const Entry& entry);
+  bool ReadCorpus(const std::vector<u8>& data);
+  bool ReadUIDCache(const std::vector<u8>& data);
+
+  std::map<SerializedGXPipelineUid, Entry, UIDLess> m_entries;
+};
+}  // namespace VideoCommon
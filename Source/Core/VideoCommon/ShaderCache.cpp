@@ -5,12 +5,14 @@
 #include "VideoCommon/ShaderCache.h"
 
 #include "Common/Assert.h"
+#include "Common/CommonPaths.h"
 #include "Common/FileUtil.h"
 #include "Common/MsgHandler.h"
 #include "Core/ConfigManager.h"
 
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/PipelineUIDCorpus.h"
 #include "VideoCommon/RenderBase.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -261,7 +263,7 @@ void ShaderCache::ClearShaderCache(T& cache)
 }
 
 template <typename KeyType, typename DiskKeyType, typename T>
-void ShaderCache::LoadPipelineCache(T& cache, LinearDiskCache<DiskKeyType, u8>& disk_cache,
+void ShaderCache::LoadPipelineCache(T& cache, IndexedDiskCache<DiskKeyType, u8>& disk_cache,
                                     APIType api_type, const char* type, bool include_gameid)
 {
   class CacheReader : public LinearDiskCacheReader<DiskKeyType, u8>
@@ -402,10 +404,17 @@ void ShaderCache::ClearCaches()
 
 void ShaderCache::CompileMissingPipelines()
 {
-  // Queue all uids with a null pipeline for compilation.
+  // Queue all uids with a null pipeline for compilation. Items of the same priority are compiled
+  // in the order they were queued, so the ones games needed earliest go first.
+  for (const GXPipelineUid& uid : m_gx_pipeline_compile_order)
+  {
+    const auto it = m_gx_pipeline_cache.find(uid);
+    if (it != m_gx_pipeline_cache.end() && !it->second.first && !it->second.second)
+      QueuePipelineCompile(uid, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+  }
   for (auto& it : m_gx_pipeline_cache)
   {
-    if (!it.second.first)
+    if (!it.second.first && !it.second.second)
       QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
   }
   for (auto& it : m_gx_uber_pipeline_cache)
@@ -724,10 +733,10 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
 
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
   constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  std::string filename = File::GetUserPath(D_CACHE_IDX) + game_id + ".uidcache";
+  std::vector<SerializedGXPipelineUid> session_uids;
   if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
   {
     // If an existing case exists, validate the version before reading entries.
@@ -736,7 +745,8 @@ void ShaderCache::LoadPipelineUIDCache()
     bool uid_file_valid = false;
     if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
         m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
+        existing_magic == GX_PIPELINE_UID_CACHE_MAGIC &&
+        existing_version == GX_PIPELINE_UID_VERSION)
     {
       // Ensure the expected size matches the actual size of the file. If it doesn't, it means
       // the cache file may be corrupted, and we should not proceed with loading potentially
@@ -755,6 +765,7 @@ void ShaderCache::LoadPipelineUIDCache()
           {
             // This just adds the pipeline to the map, it is compiled later.
             AddSerializedGXPipelineUID(serialized_uid);
+            session_uids.push_back(serialized_uid);
           }
           else
           {
@@ -780,7 +791,8 @@ void ShaderCache::LoadPipelineUIDCache()
     if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
     {
       // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
+      m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_CACHE_MAGIC,
+                                              sizeof(GX_PIPELINE_UID_CACHE_MAGIC));
       m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
                                               sizeof(GX_PIPELINE_UID_VERSION));
 
@@ -793,6 +805,27 @@ void ShaderCache::LoadPipelineUIDCache()
   }
 
   INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}", m_gx_pipeline_cache.size(), filename);
+
+  // Merge the UIDs recorded by other users of this game, which are shipped in the Sys directory
+  // or placed in the Load directory. They aren't appended to the UID cache file above, so a game
+  // that never uses them doesn't keep compiling them in every session.
+  PipelineUIDCorpus corpus;
+  corpus.AddSession(session_uids);
+  for (const std::string& corpus_filename :
+       {File::GetSysDirectory() + PIPELINE_UIDS_DIR DIR_SEP + game_id + ".uidcorpus",
+        File::GetUserPath(D_LOAD_IDX) + PIPELINE_UIDS_DIR DIR_SEP + game_id + ".uidcorpus"})
+  {
+    if (File::Exists(corpus_filename) && corpus.AddFile(corpus_filename))
+      INFO_LOG_FMT(VIDEO, "Merged pipeline UIDs from {}", corpus_filename);
+  }
+
+  m_gx_pipeline_compile_order.clear();
+  m_gx_pipeline_compile_order.reserve(corpus.GetSize());
+  for (const PipelineUIDCorpus::Entry& entry : corpus.GetEntriesInCompileOrder())
+  {
+    AddSerializedGXPipelineUID(entry.uid);
+    UnserializePipelineUid(entry.uid, m_gx_pipeline_compile_order.emplace_back());
+  }
 }
 
 void ShaderCache::ClosePipelineUIDCache()
@@ -15,6 +15,9 @@ Statistics g_stats;
 
 void Statistics::ResetFrame()
 {
+  if (frame_end_callback)
+    frame_end_callback(this_frame);
+
   this_frame = {};
 }
 
@@ -83,6 +86,7 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Uniform skipped", "%i kB", this_frame.bytes_uniform_skipped / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
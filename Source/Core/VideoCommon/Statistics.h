@@ -5,6 +5,8 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <functional>
 
 struct Statistics
 {
@@ -45,6 +47,8 @@ struct Statistics
     int bytes_vertex_streamed;
     int bytes_index_streamed;
     int bytes_uniform_streamed;
+    // Constants which were flagged as dirty, but didn't change since they were last uploaded.
+    int bytes_uniform_skipped;
 
     int num_triangles_clipped;
     int num_triangles_in;
@@ -59,8 +63,17 @@ struct Statistics
 
     int num_efb_peeks;
     int num_efb_pokes;
+
+    // Only measured while collect_timings is set.
+    std::chrono::nanoseconds vertex_loader_time;
+    std::chrono::nanoseconds texture_decode_time;
   };
   ThisFrame this_frame;
+
+  bool collect_timings;
+  // Called on the video thread with the counters of each frame, right before they are reset.
+  std::function<void(const ThisFrame&)> frame_end_callback;
+
   void ResetFrame();
   void SwapDL();
   void Display() const;
@@ -69,6 +82,30 @@ struct Statistics
 
 extern Statistics g_stats;
 
+// Adds the time spent in its scope to one of the frame timings, if they are being collected.
+class ScopedStatisticsTimer
+{
+public:
+  explicit ScopedStatisticsTimer(std::chrono::nanoseconds* timing)
+      : m_timing(g_stats.collect_timings ? timing : nullptr)
+  {
+    if (m_timing)
+      m_start = std::chrono::steady_clock::now();
+  }
+  ~ScopedStatisticsTimer()
+  {
+    if (m_timing)
+      *m_timing += std::chrono::steady_clock::now() - m_start;
+  }
+
+  ScopedStatisticsTimer(const ScopedStatisticsTimer&) = delete;
+  ScopedStatisticsTimer& operator=(const ScopedStatisticsTimer&) = delete;
+
+private:
+  std::chrono::nanoseconds* m_timing;
+  std::chrono::steady_clock::time_point m_start;
+};
+
 #define STATISTICS
 
 #ifdef STATISTICS
@@ -20,6 +20,7 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
+#include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
@@ -47,6 +48,7 @@
 #include "VideoCommon/TextureConversionShader.h"
 #include "VideoCommon/TextureConverterShaderGen.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureDiskCache.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -55,6 +57,10 @@ static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
+// Textures decoded on the CPU are only split into bands of at least this many texels.
+static const u32 MIN_TEXELS_PER_DECODE_TASK = 256 * 64;
+// Smaller textures are decoded faster than they are hashed and looked up in the disk cache.
+static const u32 MIN_DISK_CACHE_TEXTURE_SIZE = 64 * 64 * 4;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
@@ -82,6 +88,48 @@ void TextureCacheBase::CheckTempSize(size_t required_size)
   temp = static_cast<u8*>(Common::AllocateAlignedMemory(temp_size, 16));
 }
 
+void TextureCacheBase::DecodeLevelsOnCPU(const std::vector<CPUDecodeRegion>& levels,
+                                         TextureFormat format, const u8* tlut, TLUTFormat tlutfmt)
+{
+  ScopedStatisticsTimer timer(&g_stats.this_frame.texture_decode_time);
+
+  // Every row of blocks is stored contiguously, and decodes to whole rows of the destination, so
+  // large levels can be split into bands that are decoded straight into their part of temp.
+  // The format overlay is drawn over the whole level, so those levels are kept in one piece.
+  m_decode_bands.clear();
+  const u32 block_height = TexDecoder_GetBlockHeightInTexels(format);
+  for (const CPUDecodeRegion& level : levels)
+  {
+    u32 band_height = level.expanded_height;
+    if (m_decoder_pool.GetNumThreads() > 0 && !backup_config.texfmt_overlay)
+    {
+      band_height =
+          std::max(Common::AlignUp(MIN_TEXELS_PER_DECODE_TASK / level.expanded_width, block_height),
+                   block_height);
+    }
+
+    for (u32 y = 0; y < level.expanded_height; y += band_height)
+    {
+      m_decode_bands.push_back(
+          {level.dst + y * level.expanded_width * sizeof(u32),
+           level.src + TexDecoder_GetTextureSizeInBytes(level.expanded_width, y, format),
+           level.expanded_width, std::min(band_height, level.expanded_height - y)});
+    }
+  }
+
+  m_decoder_pool.ParallelFor(static_cast<u32>(m_decode_bands.size()), [&](u32 i) {
+    const CPUDecodeRegion& band = m_decode_bands[i];
+    TexDecoder_Decode(band.dst, band.src, band.expanded_width, band.expanded_height, format, tlut,
+                      tlutfmt);
+  });
+}
+
+static std::string GetTextureDiskCacheFileName()
+{
+  return fmt::format("{}Textures" DIR_SEP "{}.cache", File::GetUserPath(D_CACHE_IDX),
+                     SConfig::GetInstance().GetGameID());
+}
+
 TextureCacheBase::TextureCacheBase()
 {
   SetBackupConfig(g_ActiveConfig);
@@ -92,9 +140,18 @@ TextureCacheBase::TextureCacheBase()
   TexDecoder_SetTexFmtOverlayOptions(backup_config.texfmt_overlay,
                                      backup_config.texfmt_overlay_center);
 
+  if (backup_config.texture_decoder_threads > 0)
+    m_decoder_pool.Start(backup_config.texture_decoder_threads, "Texture Decoder");
+
+  if (backup_config.texture_disk_cache)
+  {
+    m_disk_cache = TextureDiskCache::Create(GetTextureDiskCacheFileName(),
+                                            backup_config.compress_texture_disk_cache);
+  }
+
   HiresTexture::Init();
 
-  Common::SetHash64Function();
+  Common::SetHash64Function(backup_config.hash_function);
 
   InvalidateAllBindPoints();
 }
@@ -156,8 +213,12 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     HiresTexture::Update();
   }
 
+  if (config.texture_hash_function != backup_config.hash_function)
+    Common::SetHash64Function(config.texture_hash_function);
+
   // TODO: Invalidating texcache is really stupid in some of these cases
   if (config.iSafeTextureCache_ColorSamples != backup_config.color_samples ||
+      config.texture_hash_function != backup_config.hash_function ||
       config.bTexFmtOverlayEnable != backup_config.texfmt_overlay ||
       config.bTexFmtOverlayCenter != backup_config.texfmt_overlay_center ||
       config.bHiresTextures != backup_config.hires_textures ||
@@ -169,6 +230,25 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  if (config.GetTextureDecoderThreads() != backup_config.texture_decoder_threads)
+  {
+    m_decoder_pool.Stop();
+    if (config.GetTextureDecoderThreads() > 0)
+      m_decoder_pool.Start(config.GetTextureDecoderThreads(), "Texture Decoder");
+  }
+
+  if (config.bTextureDiskCache != backup_config.texture_disk_cache ||
+      config.bCompressTextureDiskCache != backup_config.compress_texture_disk_cache)
+  {
+    // Finish writing the old file before it is opened again.
+    m_disk_cache.reset();
+    if (config.bTextureDiskCache)
+    {
+      m_disk_cache = TextureDiskCache::Create(GetTextureDiskCacheFileName(),
+                                              config.bCompressTextureDiskCache);
+    }
+  }
+
   SetBackupConfig(config);
 }
 
@@ -249,6 +329,7 @@ bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 r
 void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 {
   backup_config.color_samples = config.iSafeTextureCache_ColorSamples;
+  backup_config.hash_function = config.texture_hash_function;
   backup_config.texfmt_overlay = config.bTexFmtOverlayEnable;
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
@@ -258,6 +339,9 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
   backup_config.disable_vram_copies = config.bDisableCopyToVRAM;
   backup_config.arbitrary_mipmap_detection = config.bArbitraryMipmapDetection;
+  backup_config.texture_decoder_threads = config.GetTextureDecoderThreads();
+  backup_config.texture_disk_cache = config.bTextureDiskCache;
+  backup_config.compress_texture_disk_cache = config.bCompressTextureDiskCache;
 }
 
 TextureCacheBase::TCacheEntry*
@@ -1256,10 +1340,56 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
         texture_info.GetRawAddress(), texture_info.GetFullLevelSize(), MemoryUpdate::TEXTURE_MAP);
   }
 
-  // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
-  // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  // With write tracking, normal textures at this address remember the hash of the texture data,
+  // which stays valid until that memory is written to.
+  const bool track_writes = Memory::IsWriteTrackingEnabled() && !texture_info.IsFromTmem();
+  u64 base_hash_write_stamp = 0;
+  if (track_writes)
+  {
+    auto iter_range = textures_by_address.equal_range(texture_info.GetRawAddress());
+    for (auto iter = iter_range.first; iter != iter_range.second; ++iter)
+    {
+      const TCacheEntry* entry = iter->second;
+      if (!entry->IsCopy() && entry->size_in_bytes == texture_info.GetTextureSize() &&
+          !Memory::WasWrittenSince(entry->addr, entry->size_in_bytes,
+                                   entry->tracked_hash_write_stamp))
+      {
+        base_hash = entry->tracked_hash;
+        base_hash_write_stamp = entry->tracked_hash_write_stamp;
+        break;
+      }
+    }
+  }
+
+  if (base_hash_write_stamp == 0)
+  {
+    if (track_writes)
+    {
+      base_hash_write_stamp =
+          Memory::TrackWrites(texture_info.GetRawAddress(), texture_info.GetTextureSize());
+    }
+
+    // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more
+    // data from the low tmem bank than it should)
+    base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
+                                  textureCacheSafetyColorSampleSize);
+
+    // Let the other textures at this address skip hashing the same data again.
+    if (base_hash_write_stamp != 0)
+    {
+      auto iter_range = textures_by_address.equal_range(texture_info.GetRawAddress());
+      for (auto iter = iter_range.first; iter != iter_range.second; ++iter)
+      {
+        TCacheEntry* entry = iter->second;
+        if (!entry->IsCopy() && entry->size_in_bytes == texture_info.GetTextureSize())
+        {
+          entry->tracked_hash = base_hash;
+          entry->tracked_hash_write_stamp = base_hash_write_stamp;
+        }
+      }
+    }
+  }
+
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
@@ -1537,6 +1667,12 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
 
   // Initialized to null because only software loading uses this buffer
   u8* dst_buffer = nullptr;
+  bool mipmaps_decoded = false;
+
+  // Every level of the texture, when they were found in the disk cache.
+  std::optional<TextureDiskCache::Key> disk_cache_key;
+  const u8* cached_levels = nullptr;
+  u32 decoded_levels_size = 0;
 
   if (!hires_tex)
   {
@@ -1569,22 +1705,97 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
       dst_buffer = temp;
       if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        m_decode_levels.clear();
+        m_decode_levels.push_back(
+            {dst_buffer, texture_info.GetData(), expanded_width, expanded_height});
+
+        // Without GPU decoding, the mipmaps are decoded along with the base level, so that the
+        // whole chain is spread over the decoder threads at once.
+        if (!decode_on_gpu)
+        {
+          u8* mip_dst = dst_buffer + decoded_texture_size;
+          for (u32 level = 1; level != texLevels; ++level)
+          {
+            const auto mip_level = texture_info.GetMipMapLevel(level - 1);
+            if (!mip_level)
+              continue;
+
+            m_decode_levels.push_back({mip_dst, mip_level->GetData(),
+                                       mip_level->GetExpandedWidth(),
+                                       mip_level->GetExpandedHeight()});
+            mip_dst += mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
+          }
+          mipmaps_decoded = true;
+
+          decoded_levels_size = static_cast<u32>(mip_dst - dst_buffer);
+          if (m_disk_cache && decoded_levels_size >= MIN_DISK_CACHE_TEXTURE_SIZE &&
+              !texture_info.IsFromTmem() && !backup_config.texfmt_overlay)
+          {
+            ScopedStatisticsTimer timer(&g_stats.this_frame.texture_decode_time);
+
+            // The hashes above may only sample the data and don't cover the mipmaps, so the disk
+            // cache is keyed by hashes of everything that is decoded.
+            const u64 tlut_hash =
+                palette_size ?
+                    TextureDiskCache::HashData(texture_info.GetTlutAddress(), palette_size) :
+                    0;
+            disk_cache_key = TextureDiskCache::MakeKey(
+                TextureDiskCache::HashData(texture_info.GetData(),
+                                           texture_info.GetFullLevelSize()),
+                tlut_hash, texture_info.GetTextureFormat(), texture_info.GetTlutFormat(),
+                expanded_width, expanded_height, texLevels);
+            cached_levels = m_disk_cache->Lookup(*disk_cache_key, decoded_levels_size, dst_buffer);
+          }
+        }
+
+        if (!cached_levels)
+        {
+          DecodeLevelsOnCPU(m_decode_levels, texture_info.GetTextureFormat(),
+                            texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        }
       }
       else
       {
+        ScopedStatisticsTimer timer(&g_stats.this_frame.texture_decode_time);
         TexDecoder_DecodeRGBA8FromTmem(dst_buffer, texture_info.GetData(),
                                        texture_info.GetTmemOddAddress(), expanded_width,
                                        expanded_height);
       }
 
-      entry->texture->Load(0, width, height, expanded_width, dst_buffer, decoded_texture_size);
+      if (cached_levels)
+      {
+        // Upload every level straight from the disk cache. The temp buffer is only used for the
+        // arbitrary mipmap detection then.
+        const u8* level_data = cached_levels;
+        entry->texture->Load(0, width, height, expanded_width, level_data, decoded_texture_size);
+        arbitrary_mip_detector.AddLevel(width, height, expanded_width, level_data);
+        level_data += decoded_texture_size;
+
+        for (u32 level = 1; level != texLevels; ++level)
+        {
+          const auto mip_level = texture_info.GetMipMapLevel(level - 1);
+          if (!mip_level)
+            continue;
+
+          const u32 decoded_mip_size =
+              mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
+          entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
+                               mip_level->GetExpandedWidth(), level_data, decoded_mip_size);
+          arbitrary_mip_detector.AddLevel(mip_level->GetRawWidth(), mip_level->GetRawHeight(),
+                                          mip_level->GetExpandedWidth(), level_data);
+          level_data += decoded_mip_size;
+        }
 
-      arbitrary_mip_detector.AddLevel(width, height, expanded_width, dst_buffer);
+        dst_buffer += decoded_levels_size;
+      }
+      else
+      {
+        entry->texture->Load(0, width, height, expanded_width, dst_buffer, decoded_texture_size);
 
-      dst_buffer += decoded_texture_size;
+        arbitrary_mip_detector.AddLevel(width, height, expanded_width, dst_buffer);
+
+        dst_buffer += decoded_texture_size;
+      }
     }
   }
 
@@ -1604,6 +1815,8 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   entry->is_custom_tex = hires_tex != nullptr;
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
+  entry->tracked_hash = base_hash;
+  entry->tracked_hash_write_stamp = base_hash_write_stamp;
 
   std::string basename;
   if (g_ActiveConfig.bDumpTextures && !hires_tex)
@@ -1620,7 +1833,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
                            level.data.data(), level.data.size());
     }
   }
-  else
+  else if (!cached_levels)
   {
     for (u32 level = 1; level != texLevels; ++level)
     {
@@ -1639,9 +1852,15 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        if (!mipmaps_decoded)
+        {
+          m_decode_levels.clear();
+          m_decode_levels.push_back({dst_buffer, mip_level->GetData(),
+                                     mip_level->GetExpandedWidth(),
+                                     mip_level->GetExpandedHeight()});
+          DecodeLevelsOnCPU(m_decode_levels, texture_info.GetTextureFormat(),
+                            texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        }
         entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
 
@@ -1656,6 +1875,10 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   entry->has_arbitrary_mips = hires_tex ? hires_tex->HasArbitraryMipmaps() :
                                           arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
 
+  // The arbitrary mipmap detection only uses the temp buffer after the decoded levels.
+  if (disk_cache_key && !cached_levels)
+    m_disk_cache->Store(*disk_cache_key, temp, decoded_levels_size);
+
   if (g_ActiveConfig.bDumpTextures && !hires_tex)
   {
     for (u32 level = 0; level < texLevels; ++level)
@@ -2219,6 +2442,10 @@ void TextureCacheBase::CopyRenderTargetToTexture(
     }
   }
 
+  // Guest memory was written through a pointer, so write tracking has to be told about it.
+  // Deferred copies are marked again when they are flushed.
+  Memory::MarkWritten(dstAddr, covered_range);
+
   // Invalidate all textures, if they are either fully overwritten by our efb copy, or if they
   // have a different stride than our efb copy. Partly overwritten textures with the same stride
   // as our efb copy are marked to check them for partial texture updates.
@@ -2328,6 +2555,7 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
   u8* const dst = Memory::GetPointer(entry->addr);
   WriteEFBCopyToRAM(dst, entry->pending_efb_copy_width, entry->pending_efb_copy_height,
                     entry->memory_stride, std::move(entry->pending_efb_copy));
+  Memory::MarkWritten(entry->addr, entry->pending_efb_copy_height * entry->memory_stride);
 
   // If the EFB copy was invalidated (e.g. the bloom case mentioned in InvalidateTexture), now is
   // the time to clean up the TCacheEntry. In which case, we don't need to compute the new hash of
@@ -2846,6 +3074,7 @@ void TextureCacheBase::TCacheEntry::SetXfbCopy(u32 stride)
   is_xfb_copy = true;
   is_xfb_container = false;
   memory_stride = stride;
+  tracked_hash_write_stamp = 0;
 
   ASSERT_MSG(VIDEO, memory_stride >= BytesPerRow(), "Memory stride is too small");
 
@@ -2858,6 +3087,7 @@ void TextureCacheBase::TCacheEntry::SetEfbCopy(u32 stride)
   is_xfb_copy = false;
   is_xfb_container = false;
   memory_stride = stride;
+  tracked_hash_write_stamp = 0;
 
   ASSERT_MSG(VIDEO, memory_stride >= BytesPerRow(), "Memory stride is too small");
 
@@ -2869,6 +3099,7 @@ void TextureCacheBase::TCacheEntry::SetNotCopy()
   is_efb_copy = false;
   is_xfb_copy = false;
   is_xfb_container = false;
+  tracked_hash_write_stamp = 0;
 }
 
 int TextureCacheBase::TCacheEntry::HashSampleSize() const
@@ -2881,7 +3112,21 @@ int TextureCacheBase::TCacheEntry::HashSampleSize() const
   return g_ActiveConfig.iSafeTextureCache_ColorSamples;
 }
 
-u64 TextureCacheBase::TCacheEntry::CalculateHash() const
+u64 TextureCacheBase::TCacheEntry::CalculateHash()
+{
+  if (!Memory::IsWriteTrackingEnabled())
+    return HashMemory();
+
+  if (!Memory::WasWrittenSince(addr, size_in_bytes, tracked_hash_write_stamp))
+    return tracked_hash;
+
+  // Start tracking before hashing, so that no write can be missed in between.
+  tracked_hash_write_stamp = Memory::TrackWrites(addr, size_in_bytes);
+  tracked_hash = HashMemory();
+  return tracked_hash;
+}
+
+u64 TextureCacheBase::TCacheEntry::HashMemory() const
 {
   const u32 bytes_per_row = BytesPerRow();
   const u32 hash_sample_size = HashSampleSize();
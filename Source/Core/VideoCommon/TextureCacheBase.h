@@ -16,7 +16,9 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 #include "Common/MathUtil.h"
+#include "Common/ThreadPool.h"
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
@@ -26,6 +28,7 @@
 class AbstractFramebuffer;
 class AbstractStagingTexture;
 class PointerWrap;
+class TextureDiskCache;
 struct VideoConfig;
 
 struct TextureAndTLUTFormat
@@ -109,6 +112,11 @@ public:
 
     bool reference_changed = false;  // used by xfb to determine when a reference xfb changed
 
+    // With write tracking, the hash of the memory of this entry as of the write stamp, which is
+    // reused until that memory is written to. A stamp of 0 means that there is no such hash.
+    u64 tracked_hash = 0;
+    u64 tracked_hash_write_stamp = 0;
+
     unsigned int native_width,
         native_height;  // Texture dimensions from the GameCube's point of view
     unsigned int native_levels;
@@ -143,6 +151,7 @@ public:
       size_in_bytes = _size;
       format = _format;
       should_force_safe_hashing = force_safe_hashing;
+      tracked_hash_write_stamp = 0;
     }
 
     void SetDimensions(unsigned int _native_width, unsigned int _native_height,
@@ -179,7 +188,7 @@ public:
     u32 NumBlocksY() const;
     u32 BytesPerRow() const;
 
-    u64 CalculateHash() const;
+    u64 CalculateHash();
 
     int HashSampleSize() const;
     u32 GetWidth() const { return texture->GetConfig().width; }
@@ -188,6 +197,9 @@ public:
     u32 GetNumLayers() const { return texture->GetConfig().layers; }
     AbstractTextureFormat GetFormat() const { return texture->GetConfig().format; }
     void DoState(PointerWrap& p);
+
+  private:
+    u64 HashMemory() const;
   };
 
   // Minimal version of TCacheEntry just for TexPool
@@ -294,6 +306,19 @@ private:
   void DumpTexture(TCacheEntry* entry, std::string basename, unsigned int level, bool is_arbitrary);
   void CheckTempSize(size_t required_size);
 
+  // A texture level, or a band of block rows of one, decoded on the CPU.
+  struct CPUDecodeRegion
+  {
+    u8* dst;
+    const u8* src;
+    u32 expanded_width;
+    u32 expanded_height;
+  };
+
+  // Decodes all levels on the GPU thread and the texture decoder threads.
+  void DecodeLevelsOnCPU(const std::vector<CPUDecodeRegion>& levels, TextureFormat format,
+                         const u8* tlut, TLUTFormat tlutfmt);
+
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
@@ -340,6 +365,7 @@ private:
   struct BackupConfig
   {
     int color_samples;
+    Common::HashFunction hash_function;
     bool texfmt_overlay;
     bool texfmt_overlay_center;
     bool hires_textures;
@@ -350,6 +376,9 @@ private:
     bool gpu_texture_decoding;
     bool disable_vram_copies;
     bool arbitrary_mipmap_detection;
+    u32 texture_decoder_threads;
+    bool texture_disk_cache;
+    bool compress_texture_disk_cache;
   };
   BackupConfig backup_config = {};
 
@@ -360,6 +389,14 @@ private:
   // Decoding texture used for GPU texture decoding.
   std::unique_ptr<AbstractTexture> m_decoding_texture;
 
+  // Workers for decoding textures on the CPU, and the levels and bands they decode.
+  Common::ThreadPool m_decoder_pool;
+  std::vector<CPUDecodeRegion> m_decode_levels;
+  std::vector<CPUDecodeRegion> m_decode_bands;
+
+  // Textures decoded on the CPU in this and earlier sessions of the game.
+  std::unique_ptr<TextureDiskCache> m_disk_cache;
+
   // Pool of readback textures used for deferred EFB copies.
   std::vector<std::unique_ptr<AbstractStagingTexture>> m_efb_copy_staging_texture_pool;
 
@@ -0,0 +1,479 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <arm_neon.h>
+#include <cstring>
+
+#include "Common/CommonTypes.h"
+#include "Common/MsgHandler.h"
+#include "Common/Swap.h"
+
+#include "VideoCommon/LookUpTables.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureDecoder_Util.h"
+
+// GameCube/Wii texture decoder for AArch64.
+//
+// Every format is decoded into planar R, G, B and A vectors, which are then interleaved into RGBA8
+// pixels on store. The results are identical to the reference implementation in
+// TextureDecoder_Generic.cpp.
+
+static inline uint8x8_t Convert3To8(uint8x8_t v)
+{
+  return vorr_u8(vorr_u8(vshl_n_u8(v, 5), vshl_n_u8(v, 2)), vshr_n_u8(v, 1));
+}
+
+static inline uint8x8_t Convert4To8(uint8x8_t v)
+{
+  return vsli_n_u8(v, v, 4);
+}
+
+static inline uint8x16_t Convert4To8(uint8x16_t v)
+{
+  return vsliq_n_u8(v, v, 4);
+}
+
+static inline uint8x8_t Convert5To8(uint8x8_t v)
+{
+  return vorr_u8(vshl_n_u8(v, 3), vshr_n_u8(v, 2));
+}
+
+static inline uint8x8_t Convert6To8(uint8x8_t v)
+{
+  return vorr_u8(vshl_n_u8(v, 2), vshr_n_u8(v, 4));
+}
+
+// The decoders below take 8 16-bit texels or palette entries as they are laid out in memory, so
+// RGB565 and RGB5A3 are still big endian.
+
+static inline uint8x8x4_t DecodeIA8(uint16x8_t raw)
+{
+  const uint8x8_t a = vmovn_u16(raw);
+  const uint8x8_t i = vshrn_n_u16(raw, 8);
+  return {{i, i, i, a}};
+}
+
+static inline uint8x8x4_t DecodeRGB565(uint16x8_t raw)
+{
+  const uint16x8_t val = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(raw)));
+  const uint8x8_t r = Convert5To8(vmovn_u16(vshrq_n_u16(val, 11)));
+  const uint8x8_t g = Convert6To8(vand_u8(vshrn_n_u16(val, 5), vdup_n_u8(0x3f)));
+  const uint8x8_t b = Convert5To8(vand_u8(vmovn_u16(val), vdup_n_u8(0x1f)));
+  return {{r, g, b, vdup_n_u8(0xff)}};
+}
+
+static inline uint8x8x4_t DecodeRGB5A3(uint16x8_t raw)
+{
+  const uint16x8_t val = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(raw)));
+  const uint8x8_t low = vmovn_u16(val);
+  const uint8x8_t high = vshrn_n_u16(val, 8);
+  const uint8x8_t opaque = vmovn_u16(vtstq_u16(val, vdupq_n_u16(0x8000)));
+
+  // Opaque texels are RGB555, translucent ones ARGB3444.
+  const uint8x8_t r5 = Convert5To8(vand_u8(vshr_n_u8(high, 2), vdup_n_u8(0x1f)));
+  const uint8x8_t g5 = Convert5To8(vand_u8(vshrn_n_u16(val, 5), vdup_n_u8(0x1f)));
+  const uint8x8_t b5 = Convert5To8(vand_u8(low, vdup_n_u8(0x1f)));
+
+  const uint8x8_t a3 = Convert3To8(vand_u8(vshr_n_u8(high, 4), vdup_n_u8(0x7)));
+  const uint8x8_t r4 = Convert4To8(vand_u8(high, vdup_n_u8(0xf)));
+  const uint8x8_t g4 = Convert4To8(vshr_n_u8(low, 4));
+  const uint8x8_t b4 = Convert4To8(vand_u8(low, vdup_n_u8(0xf)));
+
+  return {{vbsl_u8(opaque, r5, r4), vbsl_u8(opaque, g5, g4), vbsl_u8(opaque, b5, b4),
+           vbsl_u8(opaque, vdup_n_u8(0xff), a3)}};
+}
+
+template <TLUTFormat tlutfmt>
+static inline uint8x8x4_t DecodePaletteEntries(uint16x8_t entries)
+{
+  if constexpr (tlutfmt == TLUTFormat::IA8)
+    return DecodeIA8(entries);
+  else if constexpr (tlutfmt == TLUTFormat::RGB565)
+    return DecodeRGB565(entries);
+  else
+    return DecodeRGB5A3(entries);
+}
+
+// Stores 8 pixels to a row of the destination.
+static inline void StoreRow8(u32* dst, uint8x8x4_t pixels)
+{
+  vst4_u8(reinterpret_cast<u8*>(dst), pixels);
+}
+
+static inline void StoreRow8(u32* dst, uint8x8_t r, uint8x8_t g, uint8x8_t b, uint8x8_t a)
+{
+  StoreRow8(dst, {{r, g, b, a}});
+}
+
+// Stores 16 pixels as the 4 rows of a 4x4 block.
+static inline void StoreBlock4x4(u32* dst, int width, uint8x16_t r, uint8x16_t g, uint8x16_t b,
+                                 uint8x16_t a)
+{
+  const uint8x16x2_t rg = vzipq_u8(r, g);
+  const uint8x16x2_t ba = vzipq_u8(b, a);
+  const uint16x8x2_t top =
+      vzipq_u16(vreinterpretq_u16_u8(rg.val[0]), vreinterpretq_u16_u8(ba.val[0]));
+  const uint16x8x2_t bottom =
+      vzipq_u16(vreinterpretq_u16_u8(rg.val[1]), vreinterpretq_u16_u8(ba.val[1]));
+
+  vst1q_u16(reinterpret_cast<u16*>(dst), top.val[0]);
+  vst1q_u16(reinterpret_cast<u16*>(dst + width), top.val[1]);
+  vst1q_u16(reinterpret_cast<u16*>(dst + width * 2), bottom.val[0]);
+  vst1q_u16(reinterpret_cast<u16*>(dst + width * 3), bottom.val[1]);
+}
+
+static inline void StoreBlock4x4(u32* dst, int width, uint8x8x4_t top, uint8x8x4_t bottom)
+{
+  StoreBlock4x4(dst, width, vcombine_u8(top.val[0], bottom.val[0]),
+                vcombine_u8(top.val[1], bottom.val[1]), vcombine_u8(top.val[2], bottom.val[2]),
+                vcombine_u8(top.val[3], bottom.val[3]));
+}
+
+// Reads 8 palette entries. NEON has no gather, so each entry is loaded into its lane separately.
+static inline uint16x8_t GatherEntries(const u16* tlut, const u16 indices[8])
+{
+  uint16x8_t entries = vld1q_dup_u16(tlut + indices[0]);
+  entries = vld1q_lane_u16(tlut + indices[1], entries, 1);
+  entries = vld1q_lane_u16(tlut + indices[2], entries, 2);
+  entries = vld1q_lane_u16(tlut + indices[3], entries, 3);
+  entries = vld1q_lane_u16(tlut + indices[4], entries, 4);
+  entries = vld1q_lane_u16(tlut + indices[5], entries, 5);
+  entries = vld1q_lane_u16(tlut + indices[6], entries, 6);
+  entries = vld1q_lane_u16(tlut + indices[7], entries, 7);
+  return entries;
+}
+
+template <TLUTFormat tlutfmt>
+static void TexDecoder_DecodeImpl_C4(u32* dst, const u8* src, int width, int height,
+                                     const u8* tlut)
+{
+  // All 16 palette entries fit into two registers, so they can be looked up with TBL by building
+  // the byte offsets of every entry from the 4-bit indices.
+  const uint8x16x2_t palette = {{vld1q_u8(tlut), vld1q_u8(tlut + 16)}};
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      for (int iy = 0; iy < 8; iy += 4, src += 16)
+      {
+        const uint8x16_t val = vld1q_u8(src);
+        const uint8x16x2_t indices = vzipq_u8(vshrq_n_u8(val, 4), vandq_u8(val, vdupq_n_u8(0xf)));
+        for (int half = 0; half < 2; ++half)
+        {
+          const uint8x16_t offsets = vshlq_n_u8(indices.val[half], 1);
+          const uint8x16x2_t bytes = vzipq_u8(offsets, vaddq_u8(offsets, vdupq_n_u8(1)));
+          for (int row = 0; row < 2; ++row)
+          {
+            const uint16x8_t entries = vreinterpretq_u16_u8(vqtbl2q_u8(palette, bytes.val[row]));
+            StoreRow8(dst + (y + iy + half * 2 + row) * width + x,
+                      DecodePaletteEntries<tlutfmt>(entries));
+          }
+        }
+      }
+    }
+  }
+}
+
+template <TLUTFormat tlutfmt>
+static void TexDecoder_DecodeImpl_C8(u32* dst, const u8* src, int width, int height,
+                                     const u8* tlut)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      for (int iy = 0; iy < 4; iy++, src += 8)
+      {
+        const u16 indices[8] = {src[0], src[1], src[2], src[3], src[4], src[5], src[6], src[7]};
+        const uint16x8_t entries = GatherEntries(reinterpret_cast<const u16*>(tlut), indices);
+        StoreRow8(dst + (y + iy) * width + x, DecodePaletteEntries<tlutfmt>(entries));
+      }
+    }
+  }
+}
+
+template <TLUTFormat tlutfmt>
+static void TexDecoder_DecodeImpl_C14X2(u32* dst, const u8* src, int width, int height,
+                                        const u8* tlut)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4)
+    {
+      uint8x8x4_t halves[2];
+      for (int half = 0; half < 2; ++half, src += 16)
+      {
+        const uint16x8_t val = vreinterpretq_u16_u8(vrev16q_u8(vld1q_u8(src)));
+        alignas(16) u16 indices[8];
+        vst1q_u16(indices, vandq_u16(val, vdupq_n_u16(0x3fff)));
+        const uint16x8_t entries = GatherEntries(reinterpret_cast<const u16*>(tlut), indices);
+        halves[half] = DecodePaletteEntries<tlutfmt>(entries);
+      }
+      StoreBlock4x4(dst + y * width + x, width, halves[0], halves[1]);
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_I4(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      for (int iy = 0; iy < 8; iy += 4, src += 16)
+      {
+        const uint8x16_t val = vld1q_u8(src);
+        const uint8x16x2_t i = vzipq_u8(vshrq_n_u8(val, 4), vandq_u8(val, vdupq_n_u8(0xf)));
+        for (int half = 0; half < 2; ++half)
+        {
+          const uint8x16_t rows = Convert4To8(i.val[half]);
+          const uint8x8_t top = vget_low_u8(rows);
+          const uint8x8_t bottom = vget_high_u8(rows);
+          StoreRow8(dst + (y + iy + half * 2) * width + x, top, top, top, top);
+          StoreRow8(dst + (y + iy + half * 2 + 1) * width + x, bottom, bottom, bottom, bottom);
+        }
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_I8(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      for (int iy = 0; iy < 4; iy++, src += 8)
+      {
+        const uint8x8_t i = vld1_u8(src);
+        StoreRow8(dst + (y + iy) * width + x, i, i, i, i);
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_IA4(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      for (int iy = 0; iy < 4; iy++, src += 8)
+      {
+        const uint8x8_t val = vld1_u8(src);
+        const uint8x8_t a = Convert4To8(vshr_n_u8(val, 4));
+        const uint8x8_t l = Convert4To8(vand_u8(val, vdup_n_u8(0xf)));
+        StoreRow8(dst + (y + iy) * width + x, l, l, l, a);
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_IA8(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4, src += 32)
+    {
+      // Alpha comes first in every texel.
+      const uint8x16x2_t val = vld2q_u8(src);
+      StoreBlock4x4(dst + y * width + x, width, val.val[1], val.val[1], val.val[1], val.val[0]);
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_RGB565(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4, src += 32)
+    {
+      const uint16x8_t top = vld1q_u16(reinterpret_cast<const u16*>(src));
+      const uint16x8_t bottom = vld1q_u16(reinterpret_cast<const u16*>(src + 16));
+      StoreBlock4x4(dst + y * width + x, width, DecodeRGB565(top), DecodeRGB565(bottom));
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_RGB5A3(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4, src += 32)
+    {
+      const uint16x8_t top = vld1q_u16(reinterpret_cast<const u16*>(src));
+      const uint16x8_t bottom = vld1q_u16(reinterpret_cast<const u16*>(src + 16));
+      StoreBlock4x4(dst + y * width + x, width, DecodeRGB5A3(top), DecodeRGB5A3(bottom));
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_RGBA8(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4, src += 64)
+    {
+      // The block is split into 32 bytes of AR pairs followed by 32 bytes of GB pairs.
+      const uint8x16x2_t ar = vld2q_u8(src);
+      const uint8x16x2_t gb = vld2q_u8(src + 32);
+      StoreBlock4x4(dst + y * width + x, width, ar.val[1], gb.val[0], gb.val[1], ar.val[0]);
+    }
+  }
+}
+
+static void DecodeDXTBlock(u32* dst, const DXTBlock* src, int width)
+{
+  // Building the 4 colors is cheap enough to do in scalar code. They are laid out planar, so that
+  // every channel of all 16 pixels can be looked up with one TBL.
+  const u16 c1 = Common::swap16(src->color1);
+  const u16 c2 = Common::swap16(src->color2);
+  const u8 blue1 = Convert5To8(c1 & 0x1F);
+  const u8 blue2 = Convert5To8(c2 & 0x1F);
+  const u8 green1 = Convert6To8((c1 >> 5) & 0x3F);
+  const u8 green2 = Convert6To8((c2 >> 5) & 0x3F);
+  const u8 red1 = Convert5To8((c1 >> 11) & 0x1F);
+  const u8 red2 = Convert5To8((c2 >> 11) & 0x1F);
+
+  alignas(16) u8 colors[16] = {red1,  red2,  0, 0, green1, green2, 0, 0,
+                               blue1, blue2, 0, 0, 255,    255,    255, 255};
+  if (c1 > c2)
+  {
+    colors[2] = DXTBlend(red2, red1);
+    colors[3] = DXTBlend(red1, red2);
+    colors[6] = DXTBlend(green2, green1);
+    colors[7] = DXTBlend(green1, green2);
+    colors[10] = DXTBlend(blue2, blue1);
+    colors[11] = DXTBlend(blue1, blue2);
+  }
+  else
+  {
+    // color[3] is the same as color[2] (average of both colors), but transparent.
+    colors[2] = colors[3] = (red1 + red2) / 2;
+    colors[6] = colors[7] = (green1 + green2) / 2;
+    colors[10] = colors[11] = (blue1 + blue2) / 2;
+    colors[15] = 0;
+  }
+  const uint8x16_t palette = vld1q_u8(colors);
+
+  // Every line is one byte holding the 2-bit indices of 4 pixels, starting with the top bits.
+  u32 lines;
+  std::memcpy(&lines, src->lines, sizeof(lines));
+  static constexpr u8 spread_lines[16] = {0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3};
+  static constexpr s8 index_shifts[16] = {-6, -4, -2, 0, -6, -4, -2, 0,
+                                          -6, -4, -2, 0, -6, -4, -2, 0};
+  const uint8x16_t spread =
+      vqtbl1q_u8(vreinterpretq_u8_u32(vdupq_n_u32(lines)), vld1q_u8(spread_lines));
+  const uint8x16_t indices =
+      vandq_u8(vshlq_u8(spread, vld1q_s8(index_shifts)), vdupq_n_u8(0x3));
+
+  StoreBlock4x4(dst, width, vqtbl1q_u8(palette, indices),
+                vqtbl1q_u8(palette, vaddq_u8(indices, vdupq_n_u8(4))),
+                vqtbl1q_u8(palette, vaddq_u8(indices, vdupq_n_u8(8))),
+                vqtbl1q_u8(palette, vaddq_u8(indices, vdupq_n_u8(12))));
+}
+
+static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int height)
+{
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      const DXTBlock* blocks = reinterpret_cast<const DXTBlock*>(src);
+      DecodeDXTBlock(dst + y * width + x, blocks, width);
+      DecodeDXTBlock(dst + y * width + x + 4, blocks + 1, width);
+      DecodeDXTBlock(dst + (y + 4) * width + x, blocks + 2, width);
+      DecodeDXTBlock(dst + (y + 4) * width + x + 4, blocks + 3, width);
+      src += sizeof(DXTBlock) * 4;
+    }
+  }
+}
+
+template <TLUTFormat tlutfmt>
+static void DecodePaletted(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
+                           const u8* tlut)
+{
+  switch (texformat)
+  {
+  case TextureFormat::C4:
+    TexDecoder_DecodeImpl_C4<tlutfmt>(dst, src, width, height, tlut);
+    break;
+  case TextureFormat::C8:
+    TexDecoder_DecodeImpl_C8<tlutfmt>(dst, src, width, height, tlut);
+    break;
+  case TextureFormat::C14X2:
+    TexDecoder_DecodeImpl_C14X2<tlutfmt>(dst, src, width, height, tlut);
+    break;
+  default:
+    break;
+  }
+}
+
+void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
+                            const u8* tlut, TLUTFormat tlutfmt)
+{
+  switch (texformat)
+  {
+  case TextureFormat::C4:
+  case TextureFormat::C8:
+  case TextureFormat::C14X2:
+    switch (tlutfmt)
+    {
+    case TLUTFormat::IA8:
+      DecodePaletted<TLUTFormat::IA8>(dst, src, width, height, texformat, tlut);
+      break;
+    case TLUTFormat::RGB565:
+      DecodePaletted<TLUTFormat::RGB565>(dst, src, width, height, texformat, tlut);
+      break;
+    case TLUTFormat::RGB5A3:
+      DecodePaletted<TLUTFormat::RGB5A3>(dst, src, width, height, texformat, tlut);
+      break;
+    default:
+      break;
+    }
+    break;
+
+  case TextureFormat::I4:
+    TexDecoder_DecodeImpl_I4(dst, src, width, height);
+    break;
+
+  case TextureFormat::I8:
+    TexDecoder_DecodeImpl_I8(dst, src, width, height);
+    break;
+
+  case TextureFormat::IA4:
+    TexDecoder_DecodeImpl_IA4(dst, src, width, height);
+    break;
+
+  case TextureFormat::IA8:
+    TexDecoder_DecodeImpl_IA8(dst, src, width, height);
+    break;
+
+  case TextureFormat::RGB565:
+    TexDecoder_DecodeImpl_RGB565(dst, src, width, height);
+    break;
+
+  case TextureFormat::RGB5A3:
+    TexDecoder_DecodeImpl_RGB5A3(dst, src, width, height);
+    break;
+
+  case TextureFormat::RGBA8:
+    TexDecoder_DecodeImpl_RGBA8(dst, src, width, height);
+    break;
+
+  case TextureFormat::CMPR:
+    TexDecoder_DecodeImpl_CMPR(dst, src, width, height);
+    break;
+
+  case TextureFormat::XFB:
+    TexDecoder_DecodeXFB(reinterpret_cast<u8*>(dst), src, width, height, width * 2);
+    break;
+
+  default:
+    PanicAlertFmt("Invalid Texture Format ({:#X})! (_TexDecoder_DecodeImpl)",
+                  static_cast<int>(texformat));
+    break;
+  }
+}
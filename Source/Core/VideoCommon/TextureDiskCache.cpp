@@ -0,0 +1,266 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include "VideoCommon/TextureDiskCache.h"
+
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include <xxhash.h>
+#include <zstd.h>
+
+#include "Common/Align.h"
+#include "Common/FileUtil.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/TextureDecoder.h"
+
+constexpr u32 CACHE_FILE_MAGIC = 0x43584554;  // "TEXC"
+// Bump this whenever the decoded output of any texture format or the key hash changes.
+constexpr u32 CACHE_FILE_VERSION = 2;
+
+// Entries and their data start on this alignment in the file.
+constexpr u32 ENTRY_ALIGNMENT = 16;
+
+// New entries aren't written once the file has reached this size.
+constexpr u64 MAX_FILE_SIZE = u64{4} << 30;
+
+namespace
+{
+struct FileHeader
+{
+  u32 magic;
+  u32 version;
+  u64 padding;
+};
+
+struct EntryHeader
+{
+  TextureDiskCache::Key key;
+  u32 stored_size;
+  u32 decoded_size;
+  u32 compressed;
+  std::array<u32, 3> padding;
+};
+
+static_assert(sizeof(FileHeader) % ENTRY_ALIGNMENT == 0);
+static_assert(sizeof(EntryHeader) % ENTRY_ALIGNMENT == 0);
+}  // namespace
+
+bool TextureDiskCache::Key::operator==(const Key& other) const
+{
+  return std::memcmp(this, &other, sizeof(Key)) == 0;
+}
+
+std::size_t TextureDiskCache::KeyHash::operator()(const Key& key) const
+{
+  return static_cast<std::size_t>(key.texture_hash ^ (key.tlut_hash * 0x9E3779B97F4A7C15ULL) ^
+                                  key.expanded_width ^ (u64{key.expanded_height} << 32));
+}
+
+u64 TextureDiskCache::HashData(const u8* data, std::size_t size)
+{
+  return XXH64(data, size, 0);
+}
+
+TextureDiskCache::Key TextureDiskCache::MakeKey(u64 texture_hash, u64 tlut_hash,
+                                                TextureFormat texture_format,
+                                                TLUTFormat tlut_format, u32 expanded_width,
+                                                u32 expanded_height, u32 levels)
+{
+  Key key = {};
+  key.texture_hash = texture_hash;
+  key.tlut_hash = tlut_hash;
+  key.texture_format = static_cast<u32>(texture_format);
+  key.tlut_format = static_cast<u32>(tlut_format);
+  key.expanded_width = expanded_width;
+  key.expanded_height = expanded_height;
+  key.levels = levels;
+  return key;
+}
+
+std::unique_ptr<TextureDiskCache> TextureDiskCache::Create(const std::string& filename,
+                                                           bool compress)
+{
+  std::unique_ptr<TextureDiskCache> cache(new TextureDiskCache(filename, compress));
+  if (!cache->Open())
+    return nullptr;
+
+  return cache;
+}
+
+TextureDiskCache::TextureDiskCache(const std::string& filename, bool compress)
+    : m_filename(filename), m_compress(compress)
+{
+}
+
+TextureDiskCache::~TextureDiskCache() = default;
+
+static bool CreateCacheFile(const std::string& filename)
+{
+  const FileHeader header = {CACHE_FILE_MAGIC, CACHE_FILE_VERSION, 0};
+  File::IOFile file(filename, "wb");
+  return file.WriteArray(&header, 1);
+}
+
+bool TextureDiskCache::Open()
+{
+  File::CreateFullPath(m_filename);
+  if (!File::Exists(m_filename) && !CreateCacheFile(m_filename))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to create texture disk cache {}", m_filename);
+    return false;
+  }
+
+  if (!m_mapped_file.Open(m_filename))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open texture disk cache {}", m_filename);
+    return false;
+  }
+
+  const u64 valid_size = IndexEntries();
+  if (valid_size == 0)
+  {
+    // The file is from another version, so start over.
+    m_mapped_file.Close();
+    if (!CreateCacheFile(m_filename))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to create texture disk cache {}", m_filename);
+      return false;
+    }
+    m_file_size = sizeof(FileHeader);
+  }
+  else if (valid_size != m_mapped_file.GetSize())
+  {
+    // Cut off an entry that wasn't completely written, so that new entries follow the last
+    // complete one. A mapped file can't be truncated on every OS, so it's mapped again after.
+    WARN_LOG_FMT(VIDEO, "Discarding incomplete entry at the end of texture disk cache {}",
+                 m_filename);
+    m_mapped_file.Close();
+    if (!File::IOFile(m_filename, "r+b").Resize(valid_size) || !m_mapped_file.Open(m_filename))
+    {
+      ERROR_LOG_FMT(VIDEO, "Failed to repair texture disk cache {}", m_filename);
+      m_entries.clear();
+      return false;
+    }
+    m_file_size = valid_size;
+  }
+  else
+  {
+    m_file_size = valid_size;
+  }
+
+  if (!m_file.Open(m_filename, "ab"))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open texture disk cache {} for writing", m_filename);
+    return false;
+  }
+
+  INFO_LOG_FMT(VIDEO, "Loaded {} textures from texture disk cache {}", m_entries.size(),
+               m_filename);
+
+  m_write_thread.Reset([this](PendingEntry entry) { WriteEntry(std::move(entry)); });
+  return true;
+}
+
+u64 TextureDiskCache::IndexEntries()
+{
+  const u8* data = m_mapped_file.GetData();
+  const u64 size = m_mapped_file.GetSize();
+
+  FileHeader file_header;
+  if (size < sizeof(file_header))
+    return 0;
+  std::memcpy(&file_header, data, sizeof(file_header));
+  if (file_header.magic != CACHE_FILE_MAGIC || file_header.version != CACHE_FILE_VERSION)
+    return 0;
+
+  u64 offset = sizeof(file_header);
+  while (size - offset >= sizeof(EntryHeader))
+  {
+    EntryHeader header;
+    std::memcpy(&header, data + offset, sizeof(header));
+    const u64 data_offset = offset + sizeof(header);
+    const u64 entry_end = data_offset + Common::AlignUp(header.stored_size, ENTRY_ALIGNMENT);
+    if (entry_end > size || header.compressed > 1 ||
+        (!header.compressed && header.stored_size != header.decoded_size))
+    {
+      break;
+    }
+
+    m_entries.emplace(header.key, Entry{data_offset, header.stored_size, header.decoded_size,
+                                        header.compressed != 0});
+    offset = entry_end;
+  }
+
+  return offset;
+}
+
+const u8* TextureDiskCache::Lookup(const Key& key, u32 decoded_size, u8* scratch_buffer) const
+{
+  const auto iter = m_entries.find(key);
+  if (iter == m_entries.end() || iter->second.offset == 0)
+    return nullptr;
+
+  const Entry& entry = iter->second;
+  if (entry.decoded_size != decoded_size)
+    return nullptr;
+
+  const u8* data = m_mapped_file.GetData() + entry.offset;
+  if (!entry.compressed)
+    return data;
+
+  const size_t result = ZSTD_decompress(scratch_buffer, decoded_size, data, entry.stored_size);
+  if (ZSTD_isError(result) || result != decoded_size)
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to decompress texture from texture disk cache {}", m_filename);
+    return nullptr;
+  }
+  return scratch_buffer;
+}
+
+void TextureDiskCache::Store(const Key& key, const u8* data, u32 decoded_size)
+{
+  const u64 entry_size = sizeof(EntryHeader) + Common::AlignUp(decoded_size, ENTRY_ALIGNMENT);
+  if (m_file_size + entry_size > MAX_FILE_SIZE)
+    return;
+
+  if (!m_entries.emplace(key, Entry{0, 0, decoded_size, false}).second)
+    return;
+
+  // Compression can only make the entry smaller, so this is an upper bound.
+  m_file_size += entry_size;
+  m_write_thread.EmplaceItem(PendingEntry{key, std::vector<u8>(data, data + decoded_size)});
+}
+
+void TextureDiskCache::WriteEntry(PendingEntry entry)
+{
+  const u32 decoded_size = static_cast<u32>(entry.data.size());
+  const u8* data = entry.data.data();
+  u32 stored_size = decoded_size;
+  bool compressed = false;
+
+  if (m_compress)
+  {
+    m_compress_buffer.resize(ZSTD_compressBound(decoded_size));
+    const size_t result = ZSTD_compress(m_compress_buffer.data(), m_compress_buffer.size(), data,
+                                        decoded_size, ZSTD_CLEVEL_DEFAULT);
+    if (!ZSTD_isError(result) && result < decoded_size)
+    {
+      data = m_compress_buffer.data();
+      stored_size = static_cast<u32>(result);
+      compressed = true;
+    }
+  }
+
+  static constexpr std::array<u8, ENTRY_ALIGNMENT> padding{};
+  const EntryHeader header = {entry.key, stored_size, decoded_size, compressed, {}};
+  if (!m_file.WriteArray(&header, 1) || !m_file.WriteBytes(data, stored_size) ||
+      !m_file.WriteBytes(padding.data(), Common::AlignUp(stored_size, ENTRY_ALIGNMENT) -
+                                             stored_size) ||
+      !m_file.Flush())
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to write to texture disk cache {}", m_filename);
+  }
+}
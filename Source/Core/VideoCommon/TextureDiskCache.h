@@ -0,0 +1,102 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/MappedFile.h"
+#include "Common/WorkQueueThread.h"
+
+enum class TextureFormat;
+enum class TLUTFormat;
+
+// Keeps textures that were decoded on the CPU in a per-game file, so that they don't need to be
+// decoded again in later sessions. The file is only ever appended to. Entries from earlier
+// sessions are read straight from the mapped file, while new entries are compressed and written
+// on a worker thread, and become available the next time the file is opened.
+class TextureDiskCache
+{
+public:
+  struct Key
+  {
+    // Hashes of the whole source data of every level and of the whole palette.
+    u64 texture_hash;
+    u64 tlut_hash;
+    u32 texture_format;
+    u32 tlut_format;
+    u32 expanded_width;
+    u32 expanded_height;
+    u32 levels;
+    u32 padding;
+
+    bool operator==(const Key& other) const;
+  };
+
+  // Hashes source data for a key. Unlike Common::GetHash64, the hash function doesn't depend on
+  // the settings, so keys stay valid across sessions.
+  static u64 HashData(const u8* data, std::size_t size);
+
+  static Key MakeKey(u64 texture_hash, u64 tlut_hash, TextureFormat texture_format,
+                     TLUTFormat tlut_format, u32 expanded_width, u32 expanded_height, u32 levels);
+
+  // Returns nullptr if the file can't be opened or created.
+  static std::unique_ptr<TextureDiskCache> Create(const std::string& filename, bool compress);
+
+  ~TextureDiskCache();
+
+  // Returns the decoded levels of a texture, or nullptr if it isn't in the file. Compressed
+  // entries are decompressed to scratch_buffer, which has to hold decoded_size bytes. Otherwise
+  // the data is in the mapped file, and stays valid until the cache is destroyed.
+  const u8* Lookup(const Key& key, u32 decoded_size, u8* scratch_buffer) const;
+
+  // Copies the decoded levels of a texture and queues them to be written to the file.
+  void Store(const Key& key, const u8* data, u32 decoded_size);
+
+private:
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Entry
+  {
+    // Offset of the stored data in the mapped file, 0 for entries stored in this session.
+    u64 offset;
+    u32 stored_size;
+    u32 decoded_size;
+    bool compressed;
+  };
+
+  struct PendingEntry
+  {
+    Key key;
+    std::vector<u8> data;
+  };
+
+  TextureDiskCache(const std::string& filename, bool compress);
+
+  bool Open();
+  u64 IndexEntries();
+  void WriteEntry(PendingEntry entry);
+
+  std::string m_filename;
+  bool m_compress;
+  File::MappedFile m_mapped_file;
+  std::unordered_map<Key, Entry, KeyHash> m_entries;
+  u64 m_file_size = 0;
+
+  // Only used by the write thread once the cache is open.
+  File::IOFile m_file;
+  std::vector<u8> m_compress_buffer;
+
+  // Destroyed first, so that every queued entry is written before the file is closed.
+  Common::WorkQueueThread<PendingEntry> m_write_thread;
+};
@@ -255,7 +255,6 @@ int VertexLoader::RunVertices(DataReader src, DataReader dst, int count)
   g_vertex_manager_write_ptr = dst.GetPointer();
   g_video_buffer_read_ptr = src.GetPointer();
 
-  m_numLoadedVertices += count;
   m_skippedVertices = 0;
 
   for (m_counter = count - 1; m_counter >= 0; m_counter--)
@@ -53,10 +53,17 @@ alignas(16) static const float scale_factors[] = {
 VertexLoaderARM64::VertexLoaderARM64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
     : VertexLoaderBase(vtx_desc, vtx_att), m_float_emit(this)
 {
-  AllocCodeSpace(4096);
+  AllocCodeSpace(8192);
   const Common::ScopedJITPageWriteAndNoExecute enable_jit_page_writes;
   ClearCodeSpace();
   GenerateVertexLoader();
+
+  // A second copy for the vertex loader pool, which leaves the zfreeze caches alone.
+  m_concurrent_code = AlignCode16();
+  m_src_ofs = 0;
+  m_dst_ofs = 0;
+  m_write_zfreeze_caches = false;
+  GenerateVertexLoader();
   WriteProtect();
 }
 
@@ -205,7 +212,7 @@ int VertexLoaderARM64::ReadVertex(VertexComponentFormat attribute, ComponentForm
   }
 
   // Z-Freeze
-  if (native_format == &m_native_vtx_decl.position)
+  if (native_format == &m_native_vtx_decl.position && m_write_zfreeze_caches)
   {
     CMP(count_reg, 3);
     FixupBranch dont_store = B(CC_GT);
@@ -418,11 +425,14 @@ void VertexLoaderARM64::GenerateVertexLoader()
     STR(IndexType::Unsigned, scratch1_reg, dst_reg, m_dst_ofs);
 
     // Z-Freeze
-    CMP(count_reg, 3);
-    FixupBranch dont_store = B(CC_GT);
-    MOVP2R(EncodeRegTo64(scratch2_reg), VertexLoaderManager::position_matrix_index);
-    STR(IndexType::Unsigned, scratch1_reg, EncodeRegTo64(scratch2_reg), 0);
-    SetJumpTarget(dont_store);
+    if (m_write_zfreeze_caches)
+    {
+      CMP(count_reg, 3);
+      FixupBranch dont_store = B(CC_GT);
+      MOVP2R(EncodeRegTo64(scratch2_reg), VertexLoaderManager::position_matrix_index);
+      STR(IndexType::Unsigned, scratch1_reg, EncodeRegTo64(scratch2_reg), 0);
+      SetJumpTarget(dont_store);
+    }
 
     m_native_vtx_decl.posmtx.components = 4;
     m_native_vtx_decl.posmtx.enable = true;
@@ -607,7 +617,12 @@ void VertexLoaderARM64::GenerateVertexLoader()
 
 int VertexLoaderARM64::RunVertices(DataReader src, DataReader dst, int count)
 {
-  m_numLoadedVertices += count;
   return ((int (*)(u8 * src, u8 * dst, int count)) region)(src.GetPointer(), dst.GetPointer(),
                                                            count);
 }
+
+int VertexLoaderARM64::RunConcurrentVertices(DataReader src, DataReader dst, int count)
+{
+  return ((int (*)(u8 * src, u8 * dst, int count)) m_concurrent_code)(src.GetPointer(),
+                                                                       dst.GetPointer(), count);
+}
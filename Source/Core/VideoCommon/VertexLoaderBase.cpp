@@ -85,7 +85,6 @@ public:
     }
 
     memcpy(dst.GetPointer(), buffer_a.data(), count_a * m_native_vtx_decl.stride);
-    m_numLoadedVertices += count;
     return count_a;
   }
 
@@ -177,6 +176,11 @@ std::vector<u32> VertexLoaderBase::GetVertexComponentSizes(const TVtxDesc& vtx_d
   return sizes;
 }
 
+int VertexLoaderBase::RunConcurrentVertices(DataReader src, DataReader dst, int count)
+{
+  return RunVertices(src, dst, count);
+}
+
 std::unique_ptr<VertexLoaderBase> VertexLoaderBase::CreateVertexLoader(const TVtxDesc& vtx_desc,
                                                                        const VAT& vtx_attr)
 {
@@ -68,6 +68,11 @@ public:
                                                               const VAT& vtx_attr);
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(DataReader src, DataReader dst, int count) = 0;
+  // Whether RunConcurrentVertices is available.
+  virtual bool SupportsConcurrentRuns() const { return false; }
+  // Like RunVertices, but leaves the zfreeze caches in VertexLoaderManager alone, so that it may be
+  // called from several threads at once for disjoint vertex ranges.
+  virtual int RunConcurrentVertices(DataReader src, DataReader dst, int count);
 
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
@@ -5,6 +5,7 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -16,6 +17,7 @@
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/ThreadPool.h"
 
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
@@ -31,6 +33,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace VertexLoaderManager
 {
@@ -51,6 +54,12 @@ static VertexLoaderMap s_vertex_loader_map;
 
 u8* cached_arraybases[NUM_VERTEX_COMPONENT_ARRAYS];
 
+// Draws are only split into tasks of at least this many vertices.
+constexpr int MIN_VERTICES_PER_TASK = 1024;
+static Common::ThreadPool s_vertex_loader_pool;
+static std::vector<int> s_task_vertex_counts;
+static std::vector<u8> s_zfreeze_vertices;
+
 void Init()
 {
   MarkAllDirty();
@@ -59,10 +68,16 @@ void Init()
   for (auto& map_entry : g_preprocess_cp_state.vertex_loaders)
     map_entry = nullptr;
   SETSTAT(g_stats.num_vertex_loaders, 0);
+
+  const u32 num_threads = g_Config.GetVertexLoaderThreads();
+  if (num_threads > 0)
+    s_vertex_loader_pool.Start(num_threads, "Vertex Loader");
 }
 
 void Clear()
 {
+  s_vertex_loader_pool.Stop();
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
@@ -240,6 +255,54 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
   return loader;
 }
 
+// Converts count vertices from src to dst, splitting large draws across the vertex loader pool.
+// Returns the number of vertices written to dst.
+static int ConvertVertices(VertexLoaderBase* loader, DataReader src, DataReader dst, int count)
+{
+  const int num_tasks = std::min(count / MIN_VERTICES_PER_TASK,
+                                 static_cast<int>(s_vertex_loader_pool.GetNumThreads()) + 1);
+  if (num_tasks <= 1 || !loader->SupportsConcurrentRuns())
+    return loader->RunVertices(src, dst, count);
+
+  const u32 src_stride = loader->m_vertex_size;
+  const u32 dst_stride = loader->m_native_vtx_decl.stride;
+  const int vertices_per_task = count / num_tasks;
+  s_task_vertex_counts.resize(num_tasks);
+  const auto run_task = [&](u32 task) {
+    const int first = static_cast<int>(task) * vertices_per_task;
+    const int task_count =
+        static_cast<int>(task) == num_tasks - 1 ? count - first : vertices_per_task;
+    DataReader task_src(src.GetPointer() + first * src_stride, src.GetPointer() + src.size());
+    DataReader task_dst(dst.GetPointer() + first * dst_stride, dst.GetPointer() + dst.size());
+    s_task_vertex_counts[task] = loader->RunConcurrentVertices(task_src, task_dst, task_count);
+  };
+  s_vertex_loader_pool.ParallelFor(num_tasks, run_task);
+
+  // The tasks leave the zfreeze caches alone. A single run stores its last vertices there, so
+  // convert the last vertices of the draw again to fill them the same way.
+  constexpr int num_cached = 3;
+  const int first_cached = count - num_cached;
+  s_zfreeze_vertices.resize(num_cached * dst_stride);
+  loader->RunVertices(
+      DataReader(src.GetPointer() + first_cached * src_stride, src.GetPointer() + src.size()),
+      DataReader(s_zfreeze_vertices.data(), s_zfreeze_vertices.data() + s_zfreeze_vertices.size()),
+      num_cached);
+
+  // Vertices with an index of 0xFFFF are skipped, which leaves gaps between the tasks' outputs.
+  int num_loaded = s_task_vertex_counts[0];
+  for (int task = 1; task < num_tasks; ++task)
+  {
+    const int first = task * vertices_per_task;
+    if (num_loaded != first)
+    {
+      std::memmove(dst.GetPointer() + num_loaded * dst_stride,
+                   dst.GetPointer() + first * dst_stride, s_task_vertex_counts[task] * dst_stride);
+    }
+    num_loaded += s_task_vertex_counts[task];
+  }
+  return num_loaded;
+}
+
 int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bool is_preprocess)
 {
   if (!count)
@@ -272,7 +335,11 @@ int RunVertices(int vtx_attr_group, int primitive, int count, DataReader src, bo
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  loader->m_numLoadedVertices += count;
+  {
+    ScopedStatisticsTimer timer(&g_stats.this_frame.vertex_loader_time);
+    count = ConvertVertices(loader, src, dst, count);
+  }
 
   g_vertex_manager->AddIndices(primitive, count);
   g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
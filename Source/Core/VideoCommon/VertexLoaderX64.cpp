@@ -45,9 +45,16 @@ static OpArg MPIC(const void* ptr)
 VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
     : VertexLoaderBase(vtx_desc, vtx_att)
 {
-  AllocCodeSpace(4096);
+  AllocCodeSpace(8192);
   ClearCodeSpace();
   GenerateVertexLoader();
+
+  // A second copy for the vertex loader pool, which leaves the zfreeze caches alone.
+  m_concurrent_code = AlignCode16();
+  m_src_ofs = 0;
+  m_dst_ofs = 0;
+  m_write_zfreeze_caches = false;
+  GenerateVertexLoader();
   WriteProtect();
 
   const std::string name =
@@ -203,7 +210,7 @@ int VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute, Com
         dest.AddMemOffset(sizeof(float));
 
         // zfreeze
-        if (native_format == &m_native_vtx_decl.position)
+        if (native_format == &m_native_vtx_decl.position && m_write_zfreeze_caches)
         {
           if (cpu_info.bSSE4_1)
           {
@@ -219,7 +226,7 @@ int VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute, Com
       }
 
       // zfreeze
-      if (native_format == &m_native_vtx_decl.position)
+      if (native_format == &m_native_vtx_decl.position && m_write_zfreeze_caches)
       {
         CMP(32, R(count_reg), Imm8(3));
         FixupBranch dont_store = J_CC(CC_A);
@@ -253,7 +260,7 @@ int VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute, Com
   }
 
   // zfreeze
-  if (native_format == &m_native_vtx_decl.position)
+  if (native_format == &m_native_vtx_decl.position && m_write_zfreeze_caches)
   {
     CMP(32, R(count_reg), Imm8(3));
     FixupBranch dont_store = J_CC(CC_A);
@@ -413,10 +420,13 @@ void VertexLoaderX64::GenerateVertexLoader()
     MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
 
     // zfreeze
-    CMP(32, R(count_reg), Imm8(3));
-    FixupBranch dont_store = J_CC(CC_A);
-    MOV(32, MPIC(VertexLoaderManager::position_matrix_index, count_reg, SCALE_4), R(scratch1));
-    SetJumpTarget(dont_store);
+    if (m_write_zfreeze_caches)
+    {
+      CMP(32, R(count_reg), Imm8(3));
+      FixupBranch dont_store = J_CC(CC_A);
+      MOV(32, MPIC(VertexLoaderManager::position_matrix_index, count_reg, SCALE_4), R(scratch1));
+      SetJumpTarget(dont_store);
+    }
 
     m_native_vtx_decl.posmtx.components = 4;
     m_native_vtx_decl.posmtx.enable = true;
@@ -542,7 +552,12 @@ void VertexLoaderX64::GenerateVertexLoader()
 
 int VertexLoaderX64::RunVertices(DataReader src, DataReader dst, int count)
 {
-  m_numLoadedVertices += count;
   return ((int (*)(u8*, u8*, int, const void*))region)(src.GetPointer(), dst.GetPointer(), count,
                                                        memory_base_ptr);
 }
+
+int VertexLoaderX64::RunConcurrentVertices(DataReader src, DataReader dst, int count)
+{
+  return ((int (*)(u8*, u8*, int, const void*))m_concurrent_code)(
+      src.GetPointer(), dst.GetPointer(), count, memory_base_ptr);
+}
@@ -19,10 +19,14 @@ public:
 
 protected:
   int RunVertices(DataReader src, DataReader dst, int count) override;
+  bool SupportsConcurrentRuns() const override { return true; }
+  int RunConcurrentVertices(DataReader src, DataReader dst, int count) override;
 
 private:
   u32 m_src_ofs = 0;
   u32 m_dst_ofs = 0;
+  bool m_write_zfreeze_caches = true;
+  const u8* m_concurrent_code = nullptr;
   Gen::FixupBranch m_skip_vertex;
   Gen::OpArg GetVertexAddr(int array, VertexComponentFormat attribute);
   int ReadVertex(Gen::OpArg data, VertexComponentFormat attribute, ComponentFormat format,
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstring>
 #include <memory>
 
 #include "Common/BitSet.h"
@@ -100,7 +101,7 @@ VertexManagerBase::~VertexManagerBase() = default;
 
 bool VertexManagerBase::Initialize()
 {
-  m_index_generator.Init();
+  m_index_generator.Init(g_Config.backend_info.bSupportsPrimitiveRestart);
   return true;
 }
 
@@ -283,11 +284,34 @@ void VertexManagerBase::UploadUniforms()
 {
 }
 
+template <typename T>
+void VertexManagerBase::SkipUnchangedConstants(bool& dirty, const T& constants,
+                                               UploadedConstants<T>& uploaded)
+{
+  if (!dirty)
+    return;
+
+  if (uploaded.valid && std::memcmp(&constants, &uploaded.constants, sizeof(T)) == 0)
+  {
+    dirty = false;
+    ADDSTAT(g_stats.this_frame.bytes_uniform_skipped, sizeof(T));
+    return;
+  }
+
+  std::memcpy(&uploaded.constants, &constants, sizeof(T));
+  uploaded.valid = true;
+}
+
 void VertexManagerBase::InvalidateConstants()
 {
   VertexShaderManager::dirty = true;
   GeometryShaderManager::dirty = true;
   PixelShaderManager::dirty = true;
+
+  // The backend no longer has the previous constants bound, so they have to be uploaded again.
+  m_uploaded_vertex_constants.valid = false;
+  m_uploaded_geometry_constants.valid = false;
+  m_uploaded_pixel_constants.valid = false;
 }
 
 void VertexManagerBase::UploadUtilityUniforms(const void* uniforms, u32 uniforms_size)
@@ -483,6 +507,12 @@ void VertexManagerBase::Flush()
     // Now we can upload uniforms, as nothing else will override them.
     GeometryShaderManager::SetConstants();
     PixelShaderManager::SetConstants();
+    SkipUnchangedConstants(VertexShaderManager::dirty, VertexShaderManager::constants,
+                           m_uploaded_vertex_constants);
+    SkipUnchangedConstants(GeometryShaderManager::dirty, GeometryShaderManager::constants,
+                           m_uploaded_geometry_constants);
+    SkipUnchangedConstants(PixelShaderManager::dirty, PixelShaderManager::constants,
+                           m_uploaded_pixel_constants);
     UploadUniforms();
 
     // Update the pipeline, or compile one if needed.
@@ -9,6 +9,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
+#include "VideoCommon/ConstantManager.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/ShaderCache.h"
@@ -148,7 +149,7 @@ public:
 
 protected:
   // When utility uniforms are used, the GX uniforms need to be re-written afterwards.
-  static void InvalidateConstants();
+  void InvalidateConstants();
 
   // Prepares the buffer for the next batch of vertices.
   virtual void ResetBuffer(u32 vertex_stride);
@@ -195,6 +196,20 @@ private:
   // Minimum number of draws per command buffer when attempting to preempt a readback operation.
   static constexpr u32 MINIMUM_DRAW_CALLS_PER_COMMAND_BUFFER_FOR_READBACK = 10;
 
+  // The constants of a stage as they were last uploaded. The shader managers flag their constants
+  // as dirty whenever a register is written, even if the values end up the same, so comparing
+  // against the previous upload lets redundant uploads be skipped.
+  template <typename T>
+  struct UploadedConstants
+  {
+    T constants{};
+    bool valid = false;
+  };
+
+  template <typename T>
+  static void SkipUnchangedConstants(bool& dirty, const T& constants,
+                                     UploadedConstants<T>& uploaded);
+
   void UpdatePipelineConfig();
   void UpdatePipelineObject();
 
@@ -207,6 +222,10 @@ private:
   std::vector<u32> m_cpu_accesses_this_frame;
   std::vector<u32> m_scheduled_command_buffer_kicks;
   bool m_allow_background_execution = true;
+
+  UploadedConstants<PixelShaderConstants> m_uploaded_pixel_constants;
+  UploadedConstants<VertexShaderConstants> m_uploaded_vertex_constants;
+  UploadedConstants<GeometryShaderConstants> m_uploaded_geometry_constants;
 };
 
 extern std::unique_ptr<VertexManagerBase> g_vertex_manager;
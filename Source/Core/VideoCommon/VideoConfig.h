@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
 
 enum class APIType;
 
@@ -67,6 +68,9 @@ struct VideoConfig final
   float fDisplayScale;
   bool bCrop;  // Aspect ratio controls.
   bool bShaderCache;
+  // Keeps textures decoded on the CPU in a per-game file, so they aren't decoded again.
+  bool bTextureDiskCache;
+  bool bCompressTextureDiskCache;
 
   // Enhancements
   u32 iMultisamples;
@@ -129,6 +133,7 @@ struct VideoConfig final
   bool bSkipPresentingDuplicateXFBs;
   bool bCopyEFBScaled;
   int iSafeTextureCache_ColorSamples;
+  Common::HashFunction texture_hash_function;
   float fAspectRatioHackW, fAspectRatioHackH;
   bool bEnablePixelLighting;
   bool bFastDepthCalc;
@@ -178,6 +183,21 @@ struct VideoConfig final
   int iShaderCompilerThreads;
   int iShaderPrecompilerThreads;
 
+  // Number of extra threads converting the vertices of large draws.
+  // 0 converts on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iVertexLoaderThreads;
+
+  // Number of extra threads decoding large textures and mipmap chains when GPU texture decoding
+  // is off. 0 decodes on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iTextureDecoderThreads;
+
+  // Number of extra threads drawing screen tiles in the software renderer.
+  // 0 draws on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -242,6 +262,9 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetVertexLoaderThreads() const;
+  u32 GetTextureDecoderThreads() const;
+  u32 GetSWRasterizerThreads() const;
 };
 
 extern VideoConfig g_Config;
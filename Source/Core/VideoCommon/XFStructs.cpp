@@ -4,6 +4,8 @@
 
 #include "VideoCommon/XFStructs.h"
 
+#include <algorithm>
+
 #include "Common/BitUtils.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
@@ -27,6 +29,20 @@ static void XFMemWritten(u32 transferSize, u32 baseAddress)
   VertexShaderManager::InvalidateXFRange(baseAddress, baseAddress + transferSize);
 }
 
+// Whether a transfer changes any of the registers from address up to end. Groups of registers
+// which are only written together don't need to split the current batch if none of them changed.
+static bool XFRegsChanged(u32 address, u32 end, int transferSize, const DataReader& src,
+                          u32 dataIndex)
+{
+  end = std::min(end, address + transferSize);
+  for (u32 i = 0; address + i < end; i++)
+  {
+    if (((u32*)&xfmem)[address + i] != src.Peek<u32>((dataIndex + i) * sizeof(u32)))
+      return true;
+  }
+  return false;
+}
+
 static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
 {
   u32 address = baseAddress;
@@ -115,10 +131,13 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETVIEWPORT + 3:
     case XFMEM_SETVIEWPORT + 4:
     case XFMEM_SETVIEWPORT + 5:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetViewportChanged();
-      PixelShaderManager::SetViewportChanged();
-      GeometryShaderManager::SetViewportChanged();
+      if (XFRegsChanged(address, XFMEM_SETVIEWPORT + 6, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetViewportChanged();
+        PixelShaderManager::SetViewportChanged();
+        GeometryShaderManager::SetViewportChanged();
+      }
 
       nextAddress = XFMEM_SETVIEWPORT + 6;
       break;
@@ -130,9 +149,12 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPROJECTION + 4:
     case XFMEM_SETPROJECTION + 5:
     case XFMEM_SETPROJECTION + 6:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetProjectionChanged();
-      GeometryShaderManager::SetProjectionChanged();
+      if (XFRegsChanged(address, XFMEM_SETPROJECTION + 7, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetProjectionChanged();
+        GeometryShaderManager::SetProjectionChanged();
+      }
 
       nextAddress = XFMEM_SETPROJECTION + 7;
       break;
@@ -150,8 +172,11 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETTEXMTXINFO + 5:
     case XFMEM_SETTEXMTXINFO + 6:
     case XFMEM_SETTEXMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      if (XFRegsChanged(address, XFMEM_SETTEXMTXINFO + 8, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETTEXMTXINFO);
+      }
 
       nextAddress = XFMEM_SETTEXMTXINFO + 8;
       break;
@@ -164,8 +189,11 @@ static void XFRegWritten(int transferSize, u32 baseAddress, DataReader src)
     case XFMEM_SETPOSTMTXINFO + 5:
     case XFMEM_SETPOSTMTXINFO + 6:
     case XFMEM_SETPOSTMTXINFO + 7:
-      g_vertex_manager->Flush();
-      VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
+      if (XFRegsChanged(address, XFMEM_SETPOSTMTXINFO + 8, transferSize, src, dataIndex))
+      {
+        g_vertex_manager->Flush();
+        VertexShaderManager::SetTexMatrixInfoChanged(address - XFMEM_SETPOSTMTXINFO);
+      }
 
       nextAddress = XFMEM_SETPOSTMTXINFO + 8;
       break;
@@ -241,10 +269,25 @@ void LoadXFReg(u32 transferSize, u32 baseAddress, DataReader src)
       transferSize = 0;
     }
 
-    XFMemWritten(xfMemTransferSize, xfMemBase);
+    // Games often load the same matrices again before each draw. Like redundant BP writes, these
+    // don't need to split the current batch, and only the changed part has to be uploaded again.
+    u32* const mem = (u32*)&xfmem + xfMemBase;
+    u32 first_changed = xfMemTransferSize;
+    u32 last_changed = 0;
+    for (u32 i = 0; i < xfMemTransferSize; i++)
+    {
+      if (mem[i] != src.Peek<u32>(i * sizeof(u32)))
+      {
+        first_changed = std::min(first_changed, i);
+        last_changed = i;
+      }
+    }
+
+    if (first_changed != xfMemTransferSize)
+      XFMemWritten(last_changed - first_changed + 1, xfMemBase + first_changed);
     for (u32 i = 0; i < xfMemTransferSize; i++)
     {
-      ((u32*)&xfmem)[xfMemBase + i] = src.Read<u32>();
+      mem[i] = src.Read<u32>();
     }
   }
 
@@ -0,0 +1,120 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <mbedtls/aes.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/AES.h"
+
+namespace
+{
+// From NIST SP 800-38A, F.2.1 and F.2.2
+constexpr std::array<u8, 16> KEY{{0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15,
+                                  0x88, 0x09, 0xcf, 0x4f, 0x3c}};
+constexpr std::array<u8, 16> IV{{0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+                                 0x0b, 0x0c, 0x0d, 0x0e, 0x0f}};
+constexpr std::array<u8, 64> PLAINTEXT{
+    {0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73,
+     0x93, 0x17, 0x2a, 0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7,
+     0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51, 0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4,
+     0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef, 0xf6, 0x9f, 0x24, 0x45,
+     0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10}};
+constexpr std::array<u8, 64> CIPHERTEXT{
+    {0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12,
+     0xe9, 0x19, 0x7d, 0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb,
+     0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2, 0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74,
+     0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16, 0x3f, 0xf1, 0xca, 0xa1,
+     0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7}};
+
+std::vector<u8> MakeData(size_t size)
+{
+  std::vector<u8> data(size);
+  u32 state = 0x12345678;
+  for (u8& byte : data)
+  {
+    state = state * 1103515245 + 12345;
+    byte = static_cast<u8>(state >> 24);
+  }
+  return data;
+}
+}  // namespace
+
+TEST(AES, KnownAnswer)
+{
+  std::array<u8, 16> iv = IV;
+  std::array<u8, 64> buffer;
+  Common::AES::Context(KEY.data(), Common::AES::Mode::Encrypt)
+      .Crypt(iv.data(), PLAINTEXT.data(), buffer.data(), buffer.size());
+  EXPECT_EQ(CIPHERTEXT, buffer);
+
+  iv = IV;
+  Common::AES::Context(KEY.data(), Common::AES::Mode::Decrypt)
+      .Crypt(iv.data(), buffer.data(), buffer.data(), buffer.size());
+  EXPECT_EQ(PLAINTEXT, buffer);
+}
+
+TEST(AES, MatchesMbedtls)
+{
+  // Sizes on either side of the number of blocks that are decrypted at once, in place and in
+  // several calls that continue from the IV that the previous call left behind.
+  const std::vector<u8> plaintext = MakeData(0x7c00);
+  Common::AES::Context encrypt(KEY.data(), Common::AES::Mode::Encrypt);
+  Common::AES::Context decrypt(KEY.data(), Common::AES::Mode::Decrypt);
+  mbedtls_aes_context mbedtls_context;
+  mbedtls_aes_init(&mbedtls_context);
+  mbedtls_aes_setkey_enc(&mbedtls_context, KEY.data(), 128);
+
+  for (size_t size : {16, 48, 128, 144, 0x400, 0x7c00})
+  {
+    std::array<u8, 16> expected_iv = IV;
+    std::vector<u8> expected(size);
+    mbedtls_aes_crypt_cbc(&mbedtls_context, MBEDTLS_AES_ENCRYPT, size, expected_iv.data(),
+                          plaintext.data(), expected.data());
+
+    std::array<u8, 16> iv = IV;
+    std::vector<u8> buffer(plaintext.begin(), plaintext.begin() + size);
+    const size_t split = size / 32 * 16;
+    encrypt.Crypt(iv.data(), buffer.data(), buffer.data(), split);
+    encrypt.Crypt(iv.data(), buffer.data() + split, buffer.data() + split, size - split);
+    EXPECT_EQ(expected, buffer) << size;
+    EXPECT_EQ(expected_iv, iv) << size;
+
+    iv = IV;
+    decrypt.Crypt(iv.data(), buffer.data(), buffer.data(), split);
+    decrypt.Crypt(iv.data(), buffer.data() + split, buffer.data() + split, size - split);
+    EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(), plaintext.begin())) << size;
+    EXPECT_EQ(expected_iv, iv) << size;
+  }
+
+  mbedtls_aes_free(&mbedtls_context);
+}
+
+TEST(AES, DISABLED_Speed)
+{
+  // The data part of a Wii disc block
+  constexpr size_t size = 0x7c00;
+  constexpr int iterations = 2000;
+  std::vector<u8> buffer = MakeData(size);
+
+  for (const Common::AES::Mode mode : {Common::AES::Mode::Decrypt, Common::AES::Mode::Encrypt})
+  {
+    Common::AES::Context context(KEY.data(), mode);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      std::array<u8, 16> iv = IV;
+      context.Crypt(iv.data(), buffer.data(), buffer.data(), size);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("{}: {:.1f} MiB/s\n", mode == Common::AES::Mode::Decrypt ? "Decrypt" : "Encrypt",
+               size * iterations / elapsed.count() / (1024 * 1024));
+  }
+}
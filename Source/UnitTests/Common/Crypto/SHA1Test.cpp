@@ -0,0 +1,78 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <mbedtls/sha1.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+
+namespace
+{
+Common::SHA1::Digest Digest(std::string_view message)
+{
+  return Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(message.data()),
+                                       message.size());
+}
+
+std::vector<u8> MakeData(size_t size)
+{
+  std::vector<u8> data(size);
+  for (size_t i = 0; i < size; i++)
+    data[i] = static_cast<u8>(i * 7 + (i >> 8));
+  return data;
+}
+}  // namespace
+
+TEST(SHA1, KnownAnswer)
+{
+  // From FIPS 180-2
+  EXPECT_EQ((Common::SHA1::Digest{0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81, 0x6a, 0xba, 0x3e,
+                                  0x25, 0x71, 0x78, 0x50, 0xc2, 0x6c, 0x9c, 0xd0, 0xd8, 0x9d}),
+            Digest("abc"));
+  EXPECT_EQ((Common::SHA1::Digest{0x84, 0x98, 0x3e, 0x44, 0x1c, 0x3b, 0xd2, 0x6e, 0xba, 0xae,
+                                  0x4a, 0xa1, 0xf9, 0x51, 0x29, 0xe5, 0xe5, 0x46, 0x70, 0xf1}),
+            Digest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"));
+  EXPECT_EQ((Common::SHA1::Digest{0xda, 0x39, 0xa3, 0xee, 0x5e, 0x6b, 0x4b, 0x0d, 0x32, 0x55,
+                                  0xbf, 0xef, 0x95, 0x60, 0x18, 0x90, 0xaf, 0xd8, 0x07, 0x09}),
+            Digest(""));
+}
+
+TEST(SHA1, MatchesMbedtls)
+{
+  // Every length around the padding boundaries, fed in one piece and in uneven pieces.
+  const std::vector<u8> data = MakeData(300);
+  for (size_t size = 0; size <= data.size(); size++)
+  {
+    Common::SHA1::Digest expected;
+    mbedtls_sha1_ret(data.data(), size, expected.data());
+    EXPECT_EQ(expected, Common::SHA1::CalculateDigest(data.data(), size)) << size;
+
+    Common::SHA1::Context context;
+    for (size_t offset = 0; offset < size; offset += 23)
+      context.Update(data.data() + offset, std::min<size_t>(23, size - offset));
+    EXPECT_EQ(expected, context.Finish()) << size;
+  }
+}
+
+TEST(SHA1, DISABLED_Speed)
+{
+  // The H0 hashes of a Wii disc block cover 0x400 bytes each
+  constexpr size_t size = 0x400;
+  constexpr int iterations = 50000;
+  const std::vector<u8> data = MakeData(size);
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    Common::SHA1::CalculateDigest(data.data(), size);
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  fmt::print("{:.1f} MiB/s\n", size * iterations / elapsed.count() / (1024 * 1024));
+}
@@ -0,0 +1,143 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <iterator>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+namespace
+{
+std::vector<u8> TestData(size_t size)
+{
+  std::vector<u8> data(size);
+  for (size_t i = 0; i < size; i++)
+    data[i] = static_cast<u8>((static_cast<u32>(i) * 2654435761u) >> 13);
+  return data;
+}
+
+// From TLUTs and small textures up to large RGBA8 textures.
+constexpr u32 TEST_SIZES[] = {32, 512, 2048, 8192, 32768, 131072, 524288};
+}  // namespace
+
+TEST(Hash, XXH3MatchesReference)
+{
+  // Reference values from XXH3_64bits of xxHash 0.8.2.
+  static constexpr std::tuple<u32, u64> expected[] = {
+      {0, 0x2d06800538d394c2},      {1, 0xc44bdff4074eecdb},     {3, 0xa1c4a8259b827291},
+      {4, 0xbb4e3d89ee0b271d},      {8, 0x79d02238b80e37b1},     {9, 0xf64cecc4271ff461},
+      {16, 0x222e9aead6bddd51},     {17, 0x47aad6b375eb4bba},    {100, 0xad1e77ff670a2548},
+      {128, 0x421a9c905c6e66ba},    {129, 0x9e2414800f83768a},   {240, 0xb714c5fd22744964},
+      {241, 0xbc424a2c480dd281},    {256, 0x2d040b1ab40f0d78},   {1024, 0x1fd15e7d36f5e1bc},
+      {1025, 0xfe08e5a874d23fd2},   {5000, 0x853377ef13cec7bd},  {65536, 0x32152aa15c5ff65a},
+      {1048576, 0xe2786b358eab4a67},
+  };
+
+  const std::vector<u8> data = TestData(1048576);
+  Common::SetHash64Function(Common::HashFunction::XXH3);
+  for (const auto& [size, hash] : expected)
+    EXPECT_EQ(hash, Common::GetHash64(data.data(), size, 0)) << size << " bytes";
+  Common::SetHash64Function();
+}
+
+TEST(Hash, CRC32MatchesZlib)
+{
+  const u8 check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+  EXPECT_EQ(0xcbf43926u, Common::UpdateCRC32(0, check, sizeof(check)));
+
+  // Sizes around the 64 and 16 byte steps of the vectorized version, in one piece and in two.
+  const std::vector<u8> data = TestData(5000);
+  for (size_t size : {0, 1, 15, 16, 63, 64, 65, 79, 80, 127, 128, 200, 1024, 4999})
+  {
+    const u32 expected = static_cast<u32>(crc32(0, data.data(), static_cast<uInt>(size)));
+    EXPECT_EQ(expected, Common::UpdateCRC32(0, data.data(), size)) << size << " bytes";
+
+    const size_t split = size / 3;
+    const u32 first = Common::UpdateCRC32(0, data.data(), split);
+    EXPECT_EQ(expected, Common::UpdateCRC32(first, data.data() + split, size - split))
+        << size << " bytes";
+  }
+}
+
+TEST(Hash, DISABLED_CRC32Speed)
+{
+  const std::vector<u8> data = TestData(1 << 20);
+  constexpr u32 iterations = 256;
+  const auto start = std::chrono::steady_clock::now();
+  u32 crc = 0;
+  for (u32 i = 0; i < iterations; i++)
+    crc = Common::UpdateCRC32(crc, data.data(), data.size());
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  fmt::print("CRC32: {:.0f} MB/s\n", double(iterations) * data.size() / elapsed.count() / 1e6);
+}
+
+class HashTest : public testing::TestWithParam<Common::HashFunction>
+{
+protected:
+  void SetUp() override { Common::SetHash64Function(GetParam()); }
+  void TearDown() override { Common::SetHash64Function(); }
+};
+
+TEST_P(HashTest, DetectsChanges)
+{
+  for (u32 size : TEST_SIZES)
+  {
+    std::vector<u8> data = TestData(size);
+    const u64 hash = Common::GetHash64(data.data(), size, 0);
+    EXPECT_EQ(hash, Common::GetHash64(data.data(), size, 0));
+
+    // Every part of the data is covered, including the tail that doesn't fill a block.
+    for (u32 offset : {0u, size / 2, size - 1})
+    {
+      data[offset] ^= 0x10;
+      EXPECT_NE(hash, Common::GetHash64(data.data(), size, 0)) << size << " bytes at " << offset;
+      data[offset] ^= 0x10;
+    }
+
+    EXPECT_NE(hash, Common::GetHash64(data.data(), size - 1, 0)) << size << " bytes";
+  }
+}
+
+TEST_P(HashTest, Samples)
+{
+  std::vector<u8> data = TestData(131072);
+  const u64 hash = Common::GetHash64(data.data(), 131072, 128);
+  EXPECT_EQ(hash, Common::GetHash64(data.data(), 131072, 128));
+
+  // The start of the data is always sampled.
+  data[0] ^= 1;
+  EXPECT_NE(hash, Common::GetHash64(data.data(), 131072, 128));
+}
+
+TEST_P(HashTest, DISABLED_Speed)
+{
+  const std::vector<u8> data = TestData(TEST_SIZES[std::size(TEST_SIZES) - 1]);
+  for (u32 samples : {0u, 128u})
+  {
+    for (u32 size : TEST_SIZES)
+    {
+      // Roughly the same amount of data for every size.
+      const u32 iterations = (u32{256} << 20) / size;
+      const auto start = std::chrono::steady_clock::now();
+      for (u32 i = 0; i < iterations; i++)
+        Common::GetHash64(data.data(), size, samples);
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      fmt::print("{} bytes, {} samples: {:.0f} MB/s, {:.1f} ns per hash\n", size, samples,
+                 double(iterations) * size / elapsed.count() / 1e6,
+                 elapsed.count() * 1e9 / iterations);
+    }
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(Functions, HashTest,
+                        testing::Values(Common::HashFunction::CRC32,
+                                        Common::HashFunction::MurmurHash3,
+                                        Common::HashFunction::XXH3));
@@ -0,0 +1,194 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/IndexedDiskCache.h"
+#include "Common/LinearDiskCache.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using Cache = IndexedDiskCache<u64, u8>;
+
+std::vector<u8> MakeValue(u8 seed, size_t size)
+{
+  std::vector<u8> value(size);
+  for (size_t i = 0; i < size; i++)
+    value[i] = static_cast<u8>(seed + i);
+  return value;
+}
+
+class Reader final : public LinearDiskCacheReader<u64, u8>
+{
+public:
+  void Read(const u64& key, const u8* value, u32 value_size) override
+  {
+    entries.emplace_back(key, std::vector<u8>(value, value + value_size));
+  }
+
+  std::vector<std::pair<u64, std::vector<u8>>> entries;
+};
+}  // namespace
+
+class IndexedDiskCacheTest : public testing::Test
+{
+protected:
+  IndexedDiskCacheTest()
+      : m_directory(File::CreateTempDir()), m_filename(m_directory + "/test.cache")
+  {
+  }
+
+  ~IndexedDiskCacheTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  void Append(Cache& cache, u64 key, const std::vector<u8>& value)
+  {
+    cache.Append(key, value.data(), static_cast<u32>(value.size()));
+  }
+
+  const std::string m_directory;
+  const std::string m_filename;
+};
+
+TEST_F(IndexedDiskCacheTest, Lookup)
+{
+  {
+    Cache cache;
+    EXPECT_EQ(0u, cache.Open(m_filename));
+    Append(cache, 1, MakeValue(1, 100));
+    Append(cache, 2, MakeValue(2, 0));
+    EXPECT_TRUE(cache.Contains(1));
+    EXPECT_FALSE(cache.Contains(3));
+  }
+
+  Cache cache;
+  EXPECT_EQ(2u, cache.Open(m_filename));
+
+  u32 size;
+  const u8* value = cache.Lookup(1, &size);
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(MakeValue(1, 100), std::vector<u8>(value, value + size));
+  ASSERT_NE(nullptr, cache.Lookup(2, &size));
+  EXPECT_EQ(0u, size);
+  EXPECT_EQ(nullptr, cache.Lookup(3, &size));
+}
+
+TEST_F(IndexedDiskCacheTest, NewestValueWins)
+{
+  {
+    Cache cache;
+    cache.Open(m_filename);
+    Append(cache, 1, MakeValue(1, 64));
+    Append(cache, 2, MakeValue(2, 64));
+    Append(cache, 1, MakeValue(3, 32));
+    EXPECT_EQ(2u, cache.GetNumEntries());
+    EXPECT_EQ(sizeof(u32) * 2 + sizeof(u64) + 64, cache.GetStaleSize());
+  }
+
+  Cache cache;
+  Reader reader;
+  EXPECT_EQ(2u, cache.OpenAndRead(m_filename, reader));
+  ASSERT_EQ(2u, reader.entries.size());
+  EXPECT_EQ(2u, reader.entries[0].first);
+  EXPECT_EQ(1u, reader.entries[1].first);
+  EXPECT_EQ(MakeValue(3, 32), reader.entries[1].second);
+}
+
+TEST_F(IndexedDiskCacheTest, Compaction)
+{
+  {
+    Cache cache;
+    cache.Open(m_filename);
+    for (u8 i = 0; i < 4; i++)
+      Append(cache, 1, MakeValue(i, 1000));
+    Append(cache, 2, MakeValue(9, 1000));
+  }
+  const u64 size = File::GetSize(m_filename);
+
+  // Most of the file is stale, so it's compacted when opened.
+  Cache cache;
+  EXPECT_EQ(2u, cache.Open(m_filename));
+  EXPECT_EQ(0u, cache.GetStaleSize());
+  EXPECT_LT(File::GetSize(m_filename), size / 2);
+
+  u32 value_size = 0;
+  const u8* value = cache.Lookup(1, &value_size);
+  ASSERT_NE(nullptr, value);
+  EXPECT_EQ(MakeValue(3, 1000), std::vector<u8>(value, value + value_size));
+  ASSERT_NE(nullptr, cache.Lookup(2, &value_size));
+  cache.Close();
+
+  EXPECT_TRUE(Cache::Compact(m_filename));
+  EXPECT_FALSE(Cache::Compact(m_directory + "/missing.cache"));
+}
+
+TEST_F(IndexedDiskCacheTest, Corruption)
+{
+  {
+    Cache cache;
+    cache.Open(m_filename);
+    Append(cache, 1, MakeValue(1, 100));
+    Append(cache, 2, MakeValue(2, 100));
+    Append(cache, 3, MakeValue(3, 100));
+  }
+
+  {
+    // Flip a byte of the second value and cut off the end of the third.
+    const u64 size = File::GetSize(m_filename);
+    File::IOFile file(m_filename, "r+b");
+    const u64 offset = size - 100 - (sizeof(u32) * 2 + sizeof(u64)) - 50;
+    u8 byte;
+    ASSERT_TRUE(file.Seek(offset, SEEK_SET) && file.ReadArray(&byte, 1));
+    byte ^= 1;
+    ASSERT_TRUE(file.Seek(offset, SEEK_SET) && file.WriteArray(&byte, 1));
+    ASSERT_TRUE(file.Resize(size - 1));
+  }
+
+  Cache cache;
+  Reader reader;
+  EXPECT_EQ(1u, cache.OpenAndRead(m_filename, reader));
+  ASSERT_EQ(1u, reader.entries.size());
+  EXPECT_EQ(1u, reader.entries[0].first);
+
+  // New entries follow the last complete one.
+  Append(cache, 4, MakeValue(4, 100));
+  cache.Close();
+  EXPECT_EQ(3u, cache.Open(m_filename));
+  EXPECT_TRUE(cache.Contains(4));
+  EXPECT_FALSE(cache.Contains(3));
+}
+
+TEST_F(IndexedDiskCacheTest, OtherFormat)
+{
+  {
+    LinearDiskCache<u64, u8> linear_cache;
+    Reader reader;
+    linear_cache.OpenAndRead(m_filename, reader);
+    const std::vector<u8> value = MakeValue(1, 100);
+    linear_cache.Append(1, value.data(), static_cast<u32>(value.size()));
+  }
+
+  // A file in another format is started over.
+  Cache cache;
+  EXPECT_EQ(0u, cache.Open(m_filename));
+  Append(cache, 1, MakeValue(1, 100));
+  cache.Close();
+  EXPECT_EQ(1u, cache.Open(m_filename));
+}
@@ -0,0 +1,56 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "Common/ThreadPool.h"
+
+using Common::ThreadPool;
+
+TEST(ThreadPool, RunsEveryTaskOnce)
+{
+  ThreadPool pool;
+  pool.Start(3, "ThreadPoolTest");
+  EXPECT_EQ(3u, pool.GetNumThreads());
+
+  for (u32 count : {0u, 1u, 2u, 7u, 1000u})
+  {
+    std::vector<std::atomic<u32>> calls(count);
+    pool.ParallelFor(count, [&](u32 i) { calls[i].fetch_add(1); });
+    for (u32 i = 0; i < count; ++i)
+      EXPECT_EQ(1u, calls[i].load());
+  }
+}
+
+TEST(ThreadPool, WithoutWorkers)
+{
+  ThreadPool pool;
+  EXPECT_EQ(0u, pool.GetNumThreads());
+
+  const std::thread::id caller = std::this_thread::get_id();
+  u32 sum = 0;
+  pool.ParallelFor(10, [&](u32 i) {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    sum += i;
+  });
+  EXPECT_EQ(45u, sum);
+}
+
+TEST(ThreadPool, Restart)
+{
+  ThreadPool pool;
+  pool.Start(2, "ThreadPoolTest");
+  std::atomic<u32> calls{0};
+  pool.ParallelFor(100, [&](u32) { calls.fetch_add(1); });
+
+  pool.Start(4, "ThreadPoolTest");
+  pool.ParallelFor(100, [&](u32) { calls.fetch_add(1); });
+
+  pool.Stop();
+  pool.ParallelFor(100, [&](u32) { calls.fetch_add(1); });
+  EXPECT_EQ(300u, calls.load());
+}
@@ -0,0 +1,94 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/HW/DVD/ReadPredictor.h"
+#include "DiscIO/Volume.h"
+
+#include <gtest/gtest.h>
+
+using DVDThread::ReadPredictor;
+
+namespace
+{
+constexpr u64 NO_LIMIT = 0x1000000;
+
+std::vector<std::pair<u64, u32>> ToPairs(const std::vector<ReadPredictor::Read>& reads)
+{
+  std::vector<std::pair<u64, u32>> pairs;
+  for (const ReadPredictor::Read& read : reads)
+    pairs.emplace_back(read.offset, read.length);
+  return pairs;
+}
+}  // namespace
+
+TEST(ReadPredictor, Sequential)
+{
+  ReadPredictor predictor;
+  EXPECT_TRUE(predictor.RecordRead(DiscIO::PARTITION_NONE, 0, 0x10000, 0x1000, 0x800, NO_LIMIT)
+                  .empty());
+
+  const std::vector<std::pair<u64, u32>> expected = {
+      {0x2000, 0x800}, {0x2800, 0x800}, {0x3000, 0x800}, {0x3800, 0x800}};
+  EXPECT_EQ(expected, ToPairs(predictor.RecordRead(DiscIO::PARTITION_NONE, 0, 0x10000, 0x1800,
+                                                   0x800, NO_LIMIT)));
+}
+
+TEST(ReadPredictor, Strided)
+{
+  ReadPredictor predictor;
+  EXPECT_TRUE(predictor.RecordRead(DiscIO::PARTITION_NONE, 0, 0x20000, 0, 0x800, NO_LIMIT).empty());
+  EXPECT_TRUE(
+      predictor.RecordRead(DiscIO::PARTITION_NONE, 0, 0x20000, 0x4000, 0x800, NO_LIMIT).empty());
+
+  const std::vector<std::pair<u64, u32>> expected = {
+      {0xC000, 0x800}, {0x10000, 0x800}, {0x14000, 0x800}, {0x18000, 0x800}};
+  EXPECT_EQ(expected, ToPairs(predictor.RecordRead(DiscIO::PARTITION_NONE, 0, 0x20000, 0x8000,
+                                                   0x800, NO_LIMIT)));
+
+  // Breaking the pattern stops the predictions.
+  EXPECT_TRUE(
+      predictor.RecordRead(DiscIO::PARTITION_NONE, 0, 0x20000, 0x100, 0x800, NO_LIMIT).empty());
+}
+
+TEST(ReadPredictor, Limits)
+{
+  ReadPredictor predictor;
+  predictor.RecordRead(DiscIO::PARTITION_NONE, 0x8000, 0x9100, 0x8000, 0x400, NO_LIMIT);
+
+  // Predictions stop at the end of the file.
+  const std::vector<std::pair<u64, u32>> expected = {{0x8800, 0x400}, {0x8C00, 0x400},
+                                                     {0x9000, 0x100}};
+  EXPECT_EQ(expected, ToPairs(predictor.RecordRead(DiscIO::PARTITION_NONE, 0x8000, 0x9100,
+                                                   0x8400, 0x400, NO_LIMIT)));
+
+  // And once max_bytes would be exceeded.
+  EXPECT_EQ(1u, predictor.RecordRead(DiscIO::PARTITION_NONE, 0x8000, 0x9100, 0x8800, 0x400, 0x4FF)
+                    .size());
+}
+
+TEST(ReadPredictor, InterleavedFiles)
+{
+  ReadPredictor predictor;
+  const DiscIO::Partition partition(0x50000);
+  for (u64 i = 0; i < 3; i++)
+  {
+    predictor.RecordRead(partition, 0, 0x100000, i * 0x8000, 0x8000, NO_LIMIT);
+    predictor.RecordRead(partition, 0x100000, 0x200000, 0x100000 + i * 0x1000, 0x1000, NO_LIMIT);
+  }
+
+  EXPECT_EQ(0x20000u, predictor.RecordRead(partition, 0, 0x100000, 0x18000, 0x8000, NO_LIMIT)
+                          .front()
+                          .offset);
+
+  // The same file offset in another partition is another file.
+  EXPECT_TRUE(predictor.RecordRead(DiscIO::PARTITION_NONE, 0, 0x100000, 0x20000, 0x8000, NO_LIMIT)
+                  .empty());
+
+  predictor.Clear();
+  EXPECT_TRUE(predictor.RecordRead(partition, 0, 0x100000, 0x20000, 0x8000, NO_LIMIT).empty());
+}
@@ -0,0 +1,214 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/CachedInterpreter/InterpreterBlockCache.h"
+#include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/PowerPC.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+class TestJit final : public JitBase
+{
+public:
+  TestJit() : m_block_cache(*this) { m_block_cache.Clear(); }
+
+  void Init() override {}
+  void Shutdown() override {}
+  void ClearCache() override { m_block_cache.Clear(); }
+  void Run() override {}
+  void SingleStep() override {}
+  const char* GetName() const override { return "TestJit"; }
+  JitBaseBlockCache* GetBlockCache() override { return &m_block_cache; }
+  void Jit(u32) override {}
+  const CommonAsmRoutinesBase* GetAsmRoutines() override { return nullptr; }
+  bool HandleFault(uintptr_t, SContext*) override { return false; }
+
+private:
+  BlockCache m_block_cache;
+};
+
+class JitCacheTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Blocks are looked up by physical address, which equals the effective address with
+    // address translation turned off.
+    MSR.Hex = 0;
+  }
+
+  JitBlock* AddBlock(u32 address, u32 num_instructions, std::vector<u32> exits = {})
+  {
+    JitBaseBlockCache& cache = *m_jit.GetBlockCache();
+    JitBlock* block = cache.AllocateBlock(address);
+    block->originalSize = num_instructions;
+    for (u32 exit : exits)
+      block->linkData.push_back({nullptr, exit, false, false});
+
+    std::map<u32, u32> physical_addresses;
+    for (u32 i = 0; i < num_instructions; ++i)
+      physical_addresses.emplace(address + i * 4, address + i * 4);
+    cache.FinalizeBlock(*block, true, physical_addresses);
+    return block;
+  }
+
+  JitBlock* Lookup(u32 address)
+  {
+    return m_jit.GetBlockCache()->GetBlockFromStartAddress(address, 0);
+  }
+
+  TestJit m_jit;
+};
+}  // namespace
+
+TEST_F(JitCacheTest, Lookup)
+{
+  JitBlock* first = AddBlock(0x80000000, 8);
+  JitBlock* second = AddBlock(0x80000020, 4);
+  JitBlock* distant = AddBlock(0x80800000, 16);
+
+  EXPECT_EQ(first, Lookup(0x80000000));
+  EXPECT_EQ(second, Lookup(0x80000020));
+  EXPECT_EQ(distant, Lookup(0x80800000));
+  EXPECT_EQ(nullptr, Lookup(0x80000004));
+  EXPECT_EQ(nullptr, Lookup(0x80000040));
+  EXPECT_EQ(nullptr, Lookup(0x81000000));
+
+  // Blocks compiled for a different MSR don't match.
+  EXPECT_EQ(nullptr, m_jit.GetBlockCache()->GetBlockFromStartAddress(0x80000000, 0x10));
+}
+
+TEST_F(JitCacheTest, ErasePhysicalRange)
+{
+  AddBlock(0x80000000, 8);
+  AddBlock(0x80000020, 4);
+  // Spans two macro blocks.
+  AddBlock(0x800000f0, 8);
+  AddBlock(0x80800000, 16);
+
+  JitBaseBlockCache& cache = *m_jit.GetBlockCache();
+  cache.ErasePhysicalRange(0x80000100, 4);
+  EXPECT_NE(nullptr, Lookup(0x80000000));
+  EXPECT_NE(nullptr, Lookup(0x80000020));
+  EXPECT_EQ(nullptr, Lookup(0x800000f0));
+
+  cache.ErasePhysicalRange(0x8000001c, 8);
+  EXPECT_EQ(nullptr, Lookup(0x80000000));
+  EXPECT_EQ(nullptr, Lookup(0x80000020));
+  EXPECT_NE(nullptr, Lookup(0x80800000));
+
+  cache.ErasePhysicalRange(0, 0xffffffff);
+  EXPECT_EQ(nullptr, Lookup(0x80800000));
+
+  size_t remaining = 0;
+  cache.RunOnBlocks([&remaining](const JitBlock&) { ++remaining; });
+  EXPECT_EQ(0u, remaining);
+}
+
+TEST_F(JitCacheTest, BlockLinking)
+{
+  JitBlock* source = AddBlock(0x80000000, 4, {0x80001000, 0x80002000});
+  EXPECT_FALSE(source->linkData[0].linkStatus);
+  EXPECT_FALSE(source->linkData[1].linkStatus);
+
+  AddBlock(0x80001000, 4);
+  EXPECT_TRUE(source->linkData[0].linkStatus);
+  EXPECT_FALSE(source->linkData[1].linkStatus);
+
+  m_jit.GetBlockCache()->ErasePhysicalRange(0x80001000, 4);
+  EXPECT_FALSE(source->linkData[0].linkStatus);
+
+  // Freed blocks are reused without keeping any of their old state.
+  JitBlock* reused = AddBlock(0x80003000, 4);
+  EXPECT_EQ(0x80003000u, reused->effectiveAddress);
+  EXPECT_TRUE(reused->linkData.empty());
+  EXPECT_EQ(4u, reused->physical_addresses.size());
+}
+
+TEST_F(JitCacheTest, RequestRecompilation)
+{
+  JitBlock* source = AddBlock(0x80001000, 4, {0x80000000});
+  JitBlock* block = AddBlock(0x80000000, 8);
+  ASSERT_TRUE(source->linkData[0].linkStatus);
+
+  JitBaseBlockCache& cache = *m_jit.GetBlockCache();
+  // Blocks compiled for a different MSR aren't affected.
+  cache.RequestRecompilation(0x80000010, 0x10);
+  EXPECT_FALSE(block->needs_recompile);
+  EXPECT_TRUE(source->linkData[0].linkStatus);
+
+  // The block is kept until the dispatcher gets to it, but it isn't entered directly anymore.
+  cache.RequestRecompilation(0x80000010, 0);
+  EXPECT_TRUE(block->needs_recompile);
+  EXPECT_EQ(block, Lookup(0x80000000));
+  EXPECT_FALSE(source->linkData[0].linkStatus);
+  JitBlock* other_source = AddBlock(0x80002000, 4, {0x80000000});
+  EXPECT_FALSE(other_source->linkData[0].linkStatus);
+
+  PC = 0x80000000;
+  EXPECT_EQ(nullptr, cache.Dispatch());
+  EXPECT_EQ(nullptr, Lookup(0x80000000));
+
+  JitBlock* recompiled = AddBlock(0x80000000, 12);
+  EXPECT_FALSE(recompiled->needs_recompile);
+  EXPECT_TRUE(source->linkData[0].linkStatus);
+  EXPECT_TRUE(other_source->linkData[0].linkStatus);
+}
+
+TEST_F(JitCacheTest, DISABLED_LookupSpeed)
+{
+  constexpr u32 NUM_BLOCKS = 50000;
+  for (u32 i = 0; i < NUM_BLOCKS; ++i)
+    AddBlock(0x80000000 + i * 0x40, 12, {0x80000000 + (i + 1) * 0x40});
+
+  const auto start = std::chrono::steady_clock::now();
+  u32 found = 0;
+  for (int pass = 0; pass < 100; ++pass)
+  {
+    for (u32 i = 0; i < NUM_BLOCKS; ++i)
+      found += Lookup(0x80000000 + ((i * 7919) % NUM_BLOCKS) * 0x40) != nullptr;
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  EXPECT_EQ(NUM_BLOCKS * 100, found);
+  fmt::print("{:.1f} million lookups/s\n", found / elapsed.count() / 1e6);
+}
+
+TEST_F(JitCacheTest, DISABLED_InvalidationSpeed)
+{
+  constexpr u32 NUM_BLOCKS = 50000;
+  JitBaseBlockCache& cache = *m_jit.GetBlockCache();
+
+  const auto start = std::chrono::steady_clock::now();
+  u32 invalidations = 0;
+  for (int pass = 0; pass < 10; ++pass)
+  {
+    for (u32 i = 0; i < NUM_BLOCKS; ++i)
+      AddBlock(0x80000000 + i * 0x40, 12, {0x80000000 + (i + 1) * 0x40});
+
+    // Invalidate in cache line sized steps like icbi does, then whole DMA-sized regions.
+    for (u32 i = 0; i < NUM_BLOCKS / 2; ++i, ++invalidations)
+      cache.ErasePhysicalRange(0x80000000 + i * 0x40, 32);
+    for (u32 address = 0x80000000 + NUM_BLOCKS / 2 * 0x40;
+         address < 0x80000000 + NUM_BLOCKS * 0x40; address += 0x4000, ++invalidations)
+    {
+      cache.ErasePhysicalRange(address, 0x4000);
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  size_t remaining = 0;
+  cache.RunOnBlocks([&remaining](const JitBlock&) { ++remaining; });
+  EXPECT_EQ(0u, remaining);
+  fmt::print("{:.1f} thousand block builds and invalidations/s\n",
+             (invalidations + NUM_BLOCKS * 10) / elapsed.count() / 1e3);
+}
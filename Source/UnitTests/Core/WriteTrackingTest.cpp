@@ -0,0 +1,133 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/ConfigManager.h"
+#include "Core/HW/Memmap.h"
+#include "Core/MemTools.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "UICommon/UICommon.h"
+
+#include <gtest/gtest.h>
+
+class WriteTrackingTest : public testing::Test
+{
+protected:
+  WriteTrackingTest() : m_profile_path(File::CreateTempDir()) {}
+
+  ~WriteTrackingTest() override
+  {
+    if (!m_profile_path.empty())
+      File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void SetUp() override
+  {
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    Config::SetCurrent(Config::GFX_TEXTURE_WRITE_TRACKING, true);
+    Memory::Init();
+  }
+
+  void TearDown() override
+  {
+    Memory::Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+  }
+
+  const std::string m_profile_path;
+};
+
+TEST_F(WriteTrackingTest, MarkedWrites)
+{
+  ASSERT_TRUE(Memory::IsWriteTrackingEnabled());
+
+  const u64 stamp = Memory::TrackWrites(0x00010000, 0x100);
+  ASSERT_NE(0u, stamp);
+  EXPECT_FALSE(Memory::WasWrittenSince(0x00010000, 0x100, stamp));
+
+  // Writes to other pages don't matter.
+  Memory::Write_U32(1, 0x80100000);
+  EXPECT_FALSE(Memory::WasWrittenSince(0x00010000, 0x100, stamp));
+
+  Memory::Write_U32(1, 0x80010080);
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00010000, 0x100, stamp));
+
+  const u64 new_stamp = Memory::TrackWrites(0x00010000, 0x100);
+  EXPECT_FALSE(Memory::WasWrittenSince(0x00010000, 0x100, new_stamp));
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00010000, 0x100, stamp));
+
+  const u8 data[4] = {};
+  Memory::CopyToEmu(0x000100fe, data, sizeof(data));
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00010000, 0x100, new_stamp));
+}
+
+TEST_F(WriteTrackingTest, PageTableWrites)
+{
+  // Map the effective page 0x10010000 to the physical page 0x00010000 through a page table at
+  // 0x00100000, using VSID 0x123.
+  PowerPC::ppcState.spr[SPR_SDR] = 0x00100000;
+  PowerPC::SDRUpdated();
+  PowerPC::ppcState.sr[1] = 0x123;
+  const u32 pteg_address = 0x00100000 | (((0x123 ^ 0x0010) & 0x3ff) << 6);
+  Memory::Write_U32(0x80000000 | (0x123 << 7), pteg_address);
+  Memory::Write_U32(0x00010000, pteg_address + 4);
+  PowerPC::InvalidateTLBEntry(0x10010000);
+  MSR.DR = 1;
+
+  // The first store is translated through the page table, the second one hits the software TLB.
+  const u64 stamp = Memory::TrackWrites(0x00010000, 0x100);
+  PowerPC::Write_U32(1, 0x10010080);
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00010000, 0x100, stamp));
+  EXPECT_EQ(1u, Memory::Read_U32(0x00010080));
+
+  const u64 new_stamp = Memory::TrackWrites(0x00010000, 0x100);
+  PowerPC::Write_U32(2, 0x10010084);
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00010000, 0x100, new_stamp));
+  EXPECT_EQ(2u, Memory::Read_U32(0x00010084));
+
+  MSR.DR = 0;
+}
+
+TEST_F(WriteTrackingTest, UntrackedRanges)
+{
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00010000, 0x100, 0));
+
+  // Memory which was never tracked counts as written.
+  const u64 stamp = Memory::TrackWrites(0x00010000, 0x100);
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00020000, 0x100, stamp));
+
+  // Anything could have changed after loading a state.
+  Memory::Clear();
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00010000, 0x100, stamp));
+}
+
+TEST_F(WriteTrackingTest, FastmemWrites)
+{
+  EMM::InstallExceptionHandler();
+  ASSERT_TRUE(Memory::InitFastmemArena());
+
+  const u64 stamp = Memory::TrackWrites(0x00010000, 0x100);
+  EXPECT_FALSE(Memory::WasWrittenSince(0x00010000, 0x100, stamp));
+
+  // The store faults once, and is retried after the page was made writable again.
+  *reinterpret_cast<volatile u32*>(Memory::physical_base + 0x00010010) = 0x12345678;
+  EXPECT_TRUE(Memory::WasWrittenSince(0x00010000, 0x100, stamp));
+  EXPECT_EQ(0x12345678u, *reinterpret_cast<const u32*>(Memory::GetPointer(0x00010010)));
+
+  *reinterpret_cast<volatile u32*>(Memory::physical_base + 0x00010020) = 0x87654321;
+  EXPECT_EQ(0x87654321u, *reinterpret_cast<const u32*>(Memory::GetPointer(0x00010020)));
+
+  Memory::ShutdownFastmemArena();
+  EMM::UninstallExceptionHandler();
+}
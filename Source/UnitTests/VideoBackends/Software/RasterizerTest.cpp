@@ -0,0 +1,174 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/Rasterizer.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BoundingBox.h"
+#include "VideoCommon/Statistics.h"
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+struct RenderResult
+{
+  std::vector<u32> colors;
+  std::vector<u32> depths;
+  int rasterized_pixels;
+  int tev_pixels_out;
+  std::array<u16, 4> bbox;
+  double seconds;
+};
+
+class SWRasterizerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::memset(static_cast<void*>(&bpmem), 0, sizeof(bpmem));
+
+    // Output the interpolated vertex color, alpha blended over the EFB and depth tested, so that
+    // the result depends on the order in which triangles are drawn.
+    bpmem.genMode.numcolchans = 1;
+    bpmem.combiners[0].colorC.d = TevColorArg::RasColor;
+    bpmem.combiners[0].alphaC.d = TevAlphaArg::RasAlpha;
+    bpmem.alpha_test.comp0 = CompareMode::Always;
+    bpmem.alpha_test.comp1 = CompareMode::Always;
+    bpmem.zmode.testenable = true;
+    bpmem.zmode.func = CompareMode::LEqual;
+    bpmem.zmode.updateenable = true;
+    bpmem.blendmode.blendenable = true;
+    bpmem.blendmode.colorupdate = true;
+    bpmem.blendmode.alphaupdate = true;
+    bpmem.blendmode.srcfactor = SrcBlendFactor::SrcAlpha;
+    bpmem.blendmode.dstfactor = DstBlendFactor::InvSrcAlpha;
+    bpmem.zcontrol.pixel_format = PixelFormat::RGBA6_Z24;
+    bpmem.scissorBR.x = EFB_WIDTH - 1;
+    bpmem.scissorBR.y = EFB_HEIGHT - 1;
+  }
+
+  static RenderResult Render(int num_threads, u32 num_triangles, float max_size)
+  {
+    g_ActiveConfig.iSWRasterizerThreads = num_threads;
+    g_ActiveConfig.bZComploc = true;
+    g_ActiveConfig.bZFreeze = true;
+    g_ActiveConfig.bDumpTevStages = false;
+    g_ActiveConfig.bDumpTevTextureFetches = false;
+    Rasterizer::Init();
+
+    u8 clear_color[4] = {};
+    for (u16 y = 0; y < EFB_HEIGHT; y++)
+    {
+      for (u16 x = 0; x < EFB_WIDTH; x++)
+      {
+        EfbInterface::SetColor(x, y, clear_color);
+        EfbInterface::SetDepth(x, y, 0xffffff);
+      }
+    }
+    g_stats.ResetFrame();
+    BoundingBox::SetCoordinate(BoundingBox::Coordinate::Left, EFB_WIDTH);
+    BoundingBox::SetCoordinate(BoundingBox::Coordinate::Right, 0);
+    BoundingBox::SetCoordinate(BoundingBox::Coordinate::Top, EFB_HEIGHT);
+    BoundingBox::SetCoordinate(BoundingBox::Coordinate::Bottom, 0);
+
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> position(-32.0f, EFB_WIDTH + 32.0f);
+    std::uniform_real_distribution<float> offset(-max_size, max_size);
+    std::uniform_real_distribution<float> depth(0.0f, 16777215.0f);
+    std::uniform_int_distribution<int> color(0, 255);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (u32 i = 0; i < num_triangles; i++)
+    {
+      std::array<OutputVertexData, 3> vertices;
+      const float x = position(rng);
+      const float y = position(rng) * EFB_HEIGHT / EFB_WIDTH;
+      for (OutputVertexData& vertex : vertices)
+      {
+        vertex.screenPosition = {x + offset(rng), y + offset(rng), depth(rng)};
+        vertex.projectedPosition.w = 1.0f;
+        for (u8& component : vertex.color[0])
+          component = static_cast<u8>(color(rng));
+      }
+
+      // Only one of the windings is front facing.
+      Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[1], &vertices[2]);
+      Rasterizer::DrawTriangleFrontFace(&vertices[0], &vertices[2], &vertices[1]);
+    }
+    Rasterizer::Flush();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    Rasterizer::Shutdown();
+
+    RenderResult result;
+    for (u16 y = 0; y < EFB_HEIGHT; y++)
+    {
+      for (u16 x = 0; x < EFB_WIDTH; x++)
+      {
+        result.colors.push_back(EfbInterface::GetColor(x, y));
+        result.depths.push_back(EfbInterface::GetDepth(x, y));
+      }
+    }
+    result.rasterized_pixels = g_stats.this_frame.rasterized_pixels;
+    result.tev_pixels_out = g_stats.this_frame.tev_pixels_out;
+    for (u32 i = 0; i < 4; i++)
+      result.bbox[i] = BoundingBox::GetCoordinate(static_cast<BoundingBox::Coordinate>(i));
+    result.seconds = elapsed.count();
+    return result;
+  }
+
+  static void ExpectSameOutput(const RenderResult& expected, const RenderResult& actual)
+  {
+    // Avoid printing hundreds of thousands of mismatches.
+    EXPECT_TRUE(expected.colors == actual.colors);
+    EXPECT_TRUE(expected.depths == actual.depths);
+    EXPECT_EQ(expected.rasterized_pixels, actual.rasterized_pixels);
+    EXPECT_EQ(expected.tev_pixels_out, actual.tev_pixels_out);
+    EXPECT_EQ(expected.bbox, actual.bbox);
+  }
+};
+}  // namespace
+
+TEST_F(SWRasterizerTest, TilesMatchSingleThreaded)
+{
+  const RenderResult expected = Render(0, 2000, 48.0f);
+  EXPECT_LT(0, expected.tev_pixels_out);
+
+  ExpectSameOutput(expected, Render(1, 2000, 48.0f));
+  ExpectSameOutput(expected, Render(3, 2000, 48.0f));
+}
+
+TEST_F(SWRasterizerTest, LargeTrianglesMatchSingleThreaded)
+{
+  const RenderResult expected = Render(0, 100, 300.0f);
+  ExpectSameOutput(expected, Render(3, 100, 300.0f));
+}
+
+TEST_F(SWRasterizerTest, ManyTrianglesMatchSingleThreaded)
+{
+  // More triangles than get binned at once.
+  const RenderResult expected = Render(0, 10000, 8.0f);
+  ExpectSameOutput(expected, Render(3, 10000, 8.0f));
+}
+
+TEST_F(SWRasterizerTest, DISABLED_Speed)
+{
+  for (int num_threads : {0, 1, 3})
+  {
+    const RenderResult result = Render(num_threads, 1000, 160.0f);
+    fmt::print("{} rasterizer threads: {:.1f} million pixels/s\n", num_threads,
+               result.tev_pixels_out / result.seconds / 1e6);
+  }
+}
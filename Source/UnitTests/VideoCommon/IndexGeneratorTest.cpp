@@ -0,0 +1,207 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <initializer_list>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr u16 RESTART = UINT16_MAX;
+
+// One primitive at a time, the way the index generator worked before it wrote whole groups.
+class ReferenceIndices
+{
+public:
+  explicit ReferenceIndices(bool primitive_restart) : m_pr(primitive_restart) {}
+
+  void Add(int primitive, u32 n)
+  {
+    switch (primitive)
+    {
+    case OpcodeDecoder::GX_DRAW_QUADS:
+    case OpcodeDecoder::GX_DRAW_QUADS_2:
+    {
+      u32 i = 0;
+      for (; i + 4 <= n; i += 4)
+      {
+        if (m_pr)
+          Write({i + 1, i + 2, i, i + 3}, true);
+        else
+          Write({i, i + 1, i + 2, i, i + 2, i + 3}, false);
+      }
+      if (n - i == 3)
+        Triangle(i, i + 1, i + 2);
+      break;
+    }
+    case OpcodeDecoder::GX_DRAW_TRIANGLES:
+      for (u32 i = 0; i + 3 <= n; i += 3)
+        Triangle(i, i + 1, i + 2);
+      break;
+    case OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP:
+      if (m_pr)
+      {
+        for (u32 i = 0; i < n; i++)
+          Write({i}, false);
+        m_indices.push_back(RESTART);
+        break;
+      }
+      for (u32 i = 0; i + 3 <= n; i++)
+      {
+        if (i % 2 == 0)
+          Triangle(i, i + 1, i + 2);
+        else
+          Triangle(i, i + 2, i + 1);
+      }
+      break;
+    case OpcodeDecoder::GX_DRAW_TRIANGLE_FAN:
+    {
+      u32 i = 2;
+      if (m_pr)
+      {
+        for (; i + 3 <= n; i += 3)
+          Write({i - 1, i, 0, i + 1, i + 2}, true);
+        for (; i + 2 <= n; i += 2)
+          Write({i - 1, i, 0, i + 1}, true);
+      }
+      for (; i < n; i++)
+        Triangle(0, i - 1, i);
+      break;
+    }
+    case OpcodeDecoder::GX_DRAW_LINES:
+      for (u32 i = 0; i + 2 <= n; i += 2)
+        Write({i, i + 1}, false);
+      break;
+    case OpcodeDecoder::GX_DRAW_LINE_STRIP:
+      for (u32 i = 0; i + 2 <= n; i++)
+        Write({i, i + 1}, false);
+      break;
+    case OpcodeDecoder::GX_DRAW_POINTS:
+      for (u32 i = 0; i < n; i++)
+        Write({i}, false);
+      break;
+    }
+    m_base += n;
+  }
+
+  const std::vector<u16>& GetIndices() const { return m_indices; }
+
+private:
+  void Write(std::initializer_list<u32> vertices, bool restart)
+  {
+    for (u32 vertex : vertices)
+      m_indices.push_back(static_cast<u16>(m_base + vertex));
+    if (restart)
+      m_indices.push_back(RESTART);
+  }
+
+  void Triangle(u32 a, u32 b, u32 c) { Write({a, b, c}, m_pr); }
+
+  bool m_pr;
+  u32 m_base = 0;
+  std::vector<u16> m_indices;
+};
+
+constexpr int PRIMITIVES[] = {
+    OpcodeDecoder::GX_DRAW_QUADS,         OpcodeDecoder::GX_DRAW_QUADS_2,
+    OpcodeDecoder::GX_DRAW_TRIANGLES,     OpcodeDecoder::GX_DRAW_TRIANGLE_STRIP,
+    OpcodeDecoder::GX_DRAW_TRIANGLE_FAN,  OpcodeDecoder::GX_DRAW_LINES,
+    OpcodeDecoder::GX_DRAW_LINE_STRIP,    OpcodeDecoder::GX_DRAW_POINTS,
+};
+
+// Fans and strips take up to three indices per vertex.
+constexpr size_t BUFFER_SIZE = 3 * 65536;
+}  // namespace
+
+class IndexGeneratorTest : public ::testing::TestWithParam<bool>
+{
+protected:
+  void SetUp() override
+  {
+    m_generator.Init(GetParam());
+    m_buffer.assign(BUFFER_SIZE, 0);
+  }
+
+  IndexGenerator m_generator;
+  std::vector<u16> m_buffer;
+};
+
+TEST_P(IndexGeneratorTest, MatchesReference)
+{
+  for (const int primitive : PRIMITIVES)
+  {
+    for (u32 num_vertices = 0; num_vertices <= 100; num_vertices++)
+    {
+      // Follow a short draw, so that the indices don't start at 0.
+      ReferenceIndices reference(GetParam());
+      reference.Add(primitive, 5);
+      reference.Add(primitive, num_vertices);
+
+      m_generator.Start(m_buffer.data());
+      m_generator.AddIndices(primitive, 5);
+      m_generator.AddIndices(primitive, num_vertices);
+
+      const std::vector<u16> indices(m_buffer.begin(),
+                                     m_buffer.begin() + m_generator.GetIndexLen());
+      ASSERT_EQ(reference.GetIndices(), indices)
+          << fmt::format("primitive {} with {} vertices", primitive, num_vertices);
+      EXPECT_EQ(num_vertices + 5, m_generator.GetNumVerts());
+    }
+  }
+}
+
+TEST_P(IndexGeneratorTest, LastIndex)
+{
+  // The highest index that can be used without colliding with the restart index.
+  for (const int primitive : PRIMITIVES)
+  {
+    m_generator.Start(m_buffer.data());
+    m_generator.AddIndices(OpcodeDecoder::GX_DRAW_POINTS, 65535 - 1000);
+    const u32 start = m_generator.GetIndexLen();
+    m_generator.AddIndices(primitive, m_generator.GetRemainingIndices());
+
+    ReferenceIndices reference(GetParam());
+    reference.Add(OpcodeDecoder::GX_DRAW_POINTS, 65535 - 1000);
+    reference.Add(primitive, 999);
+    const std::vector<u16> expected(reference.GetIndices().begin() + start,
+                                    reference.GetIndices().end());
+    const std::vector<u16> indices(m_buffer.begin() + start,
+                                   m_buffer.begin() + m_generator.GetIndexLen());
+    ASSERT_EQ(expected, indices) << fmt::format("primitive {}", primitive);
+  }
+}
+
+TEST_P(IndexGeneratorTest, DISABLED_Speed)
+{
+  for (const int primitive : PRIMITIVES)
+  {
+    // Draws of the size seen in geometry heavy games, which mostly use long strips and lists.
+    constexpr int iterations = 1000;
+    constexpr u32 draw_size = 60;
+    constexpr u32 draws = 1000;
+    static_assert(draw_size * draws <= 65534, "Too many vertices for 16-bit indices");
+
+    u64 total_indices = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      m_generator.Start(m_buffer.data());
+      for (u32 draw = 0; draw < draws; draw++)
+        m_generator.AddIndices(primitive, draw_size);
+      total_indices += m_generator.GetIndexLen();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("primitive {}{}: {:.1f} million indices/s\n", primitive,
+               GetParam() ? " (primitive restart)" : "", total_indices / elapsed.count() / 1e6);
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(PrimitiveRestart, IndexGeneratorTest, ::testing::Bool());
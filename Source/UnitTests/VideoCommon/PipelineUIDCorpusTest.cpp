@@ -0,0 +1,135 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/GXPipelineTypes.h"
+#include "VideoCommon/PipelineUIDCorpus.h"
+
+#include <gtest/gtest.h>
+
+using VideoCommon::GX_PIPELINE_UID_CACHE_MAGIC;
+using VideoCommon::GX_PIPELINE_UID_VERSION;
+using VideoCommon::PipelineUIDCorpus;
+using VideoCommon::SerializedGXPipelineUid;
+
+namespace
+{
+SerializedGXPipelineUid MakeUID(u8 seed)
+{
+  SerializedGXPipelineUid uid;
+  std::memset(static_cast<void*>(&uid), seed, sizeof(uid));
+  return uid;
+}
+
+std::vector<u8> GetSeeds(const PipelineUIDCorpus& corpus)
+{
+  std::vector<u8> seeds;
+  for (const PipelineUIDCorpus::Entry& entry : corpus.GetEntriesInCompileOrder())
+    seeds.push_back(reinterpret_cast<const u8*>(&entry.uid)[0]);
+  return seeds;
+}
+}  // namespace
+
+class PipelineUIDCorpusTest : public testing::Test
+{
+protected:
+  PipelineUIDCorpusTest() : m_directory(File::CreateTempDir()) {}
+
+  ~PipelineUIDCorpusTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_directory;
+};
+
+TEST_F(PipelineUIDCorpusTest, CompileOrder)
+{
+  PipelineUIDCorpus corpus;
+  corpus.AddSession({MakeUID(1), MakeUID(2), MakeUID(3), MakeUID(2)});
+  corpus.AddSession({MakeUID(4), MakeUID(3), MakeUID(1)});
+  EXPECT_EQ(4u, corpus.GetSize());
+
+  // UIDs first seen at the same position are ordered by how many sessions used them.
+  const std::vector<u8> expected = {1, 4, 3, 2};
+  EXPECT_EQ(expected, GetSeeds(corpus));
+
+  const std::vector<PipelineUIDCorpus::Entry> entries = corpus.GetEntriesInCompileOrder();
+  EXPECT_EQ(2u, entries[0].sessions);
+  EXPECT_EQ(1u, entries[1].sessions);
+  EXPECT_EQ(1u, entries[2].first_seen);
+  EXPECT_EQ(2u, entries[2].sessions);
+}
+
+TEST_F(PipelineUIDCorpusTest, Merge)
+{
+  PipelineUIDCorpus first;
+  first.AddSession({MakeUID(1), MakeUID(2)});
+  PipelineUIDCorpus second;
+  second.AddSession({MakeUID(2), MakeUID(3)});
+
+  first.Merge(second);
+  const std::vector<u8> expected = {2, 1, 3};
+  EXPECT_EQ(expected, GetSeeds(first));
+}
+
+TEST_F(PipelineUIDCorpusTest, SaveAndLoad)
+{
+  const std::string filename = m_directory + "/GAME01.uidcorpus";
+  PipelineUIDCorpus corpus;
+  corpus.AddSession({MakeUID(5), MakeUID(6), MakeUID(7)});
+  corpus.AddSession({MakeUID(7)});
+  ASSERT_TRUE(corpus.Save(filename));
+
+  PipelineUIDCorpus loaded;
+  ASSERT_TRUE(loaded.AddFile(filename));
+  EXPECT_EQ(GetSeeds(corpus), GetSeeds(loaded));
+  EXPECT_EQ(2u, loaded.GetEntriesInCompileOrder()[0].sessions);
+
+  // A truncated file is rejected as a whole.
+  ASSERT_TRUE(File::IOFile(filename, "r+b").Resize(File::GetSize(filename) - 1));
+  PipelineUIDCorpus truncated;
+  EXPECT_FALSE(truncated.AddFile(filename));
+  EXPECT_EQ(0u, truncated.GetSize());
+
+  EXPECT_FALSE(truncated.AddFile(m_directory + "/missing.uidcorpus"));
+}
+
+TEST_F(PipelineUIDCorpusTest, UIDCache)
+{
+  const std::string filename = m_directory + "/GAME01.uidcache";
+  {
+    File::IOFile file(filename, "wb");
+    file.WriteArray(&GX_PIPELINE_UID_CACHE_MAGIC, 1);
+    file.WriteArray(&GX_PIPELINE_UID_VERSION, 1);
+    for (u8 seed : {9, 8, 9})
+    {
+      const SerializedGXPipelineUid uid = MakeUID(seed);
+      file.WriteArray(&uid, 1);
+    }
+
+    // An entry that was cut off when the game was closed.
+    const SerializedGXPipelineUid uid = MakeUID(10);
+    file.WriteBytes(&uid, sizeof(uid) / 2);
+  }
+
+  PipelineUIDCorpus corpus;
+  ASSERT_TRUE(corpus.AddFile(filename));
+  const std::vector<u8> expected = {9, 8};
+  EXPECT_EQ(expected, GetSeeds(corpus));
+  EXPECT_EQ(1u, corpus.GetEntriesInCompileOrder()[0].sessions);
+}
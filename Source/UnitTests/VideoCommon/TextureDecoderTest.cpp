@@ -0,0 +1,122 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <chrono>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+std::vector<u8> RandomBytes(size_t size, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<u8> bytes(size);
+  for (u8& b : bytes)
+    b = static_cast<u8>(byte(rng));
+  return bytes;
+}
+
+// Large enough for any format, and for every entry that C14X2 can index.
+constexpr size_t MAX_TEXTURE_SIZE = 256 * 256 * 4;
+constexpr size_t TLUT_SIZE = 0x4000 * sizeof(u16);
+}  // namespace
+
+class TextureDecoderTest
+    : public ::testing::TestWithParam<std::tuple<TextureFormat, TLUTFormat>>
+{
+};
+
+// The full texture decoders are optimized separately for every architecture, while
+// TexDecoder_DecodeTexel is the plain reference used for sampling single texels.
+TEST_P(TextureDecoderTest, MatchesTexelDecoder)
+{
+  const auto [format, tlut_format] = GetParam();
+  const std::vector<u8> src = RandomBytes(MAX_TEXTURE_SIZE, 1);
+  const std::vector<u8> tlut = RandomBytes(TLUT_SIZE, 2);
+
+  for (const auto& [width, height] : {std::pair{8, 8}, {16, 8}, {8, 16}, {40, 24}, {256, 256}})
+  {
+    std::vector<u32> decoded(width * height);
+    TexDecoder_Decode(reinterpret_cast<u8*>(decoded.data()), src.data(), width, height, format,
+                      tlut.data(), tlut_format);
+
+    for (int t = 0; t < height; t++)
+    {
+      for (int s = 0; s < width; s++)
+      {
+        u32 texel;
+        TexDecoder_DecodeTexel(reinterpret_cast<u8*>(&texel), src.data(), s, t, width - 1, format,
+                               tlut.data(), tlut_format);
+        ASSERT_EQ(texel, decoded[t * width + s])
+            << fmt::format("{} {}x{} texel ({}, {})", format, width, height, s, t);
+      }
+    }
+  }
+}
+
+// The texture cache decodes large textures in bands of block rows on several threads.
+TEST_P(TextureDecoderTest, DecodesInBands)
+{
+  const auto [format, tlut_format] = GetParam();
+  const std::vector<u8> src = RandomBytes(MAX_TEXTURE_SIZE, 1);
+  const std::vector<u8> tlut = RandomBytes(TLUT_SIZE, 2);
+  constexpr int width = 64;
+  constexpr int height = 64;
+
+  std::vector<u32> whole(width * height);
+  TexDecoder_Decode(reinterpret_cast<u8*>(whole.data()), src.data(), width, height, format,
+                    tlut.data(), tlut_format);
+
+  const int band_height = TexDecoder_GetBlockHeightInTexels(format);
+  std::vector<u32> bands(width * height);
+  for (int y = 0; y < height; y += band_height)
+  {
+    TexDecoder_Decode(reinterpret_cast<u8*>(bands.data() + y * width),
+                      src.data() + TexDecoder_GetTextureSizeInBytes(width, y, format), width,
+                      band_height, format, tlut.data(), tlut_format);
+  }
+  EXPECT_EQ(whole, bands);
+}
+
+TEST_P(TextureDecoderTest, DISABLED_Speed)
+{
+  const auto [format, tlut_format] = GetParam();
+  const std::vector<u8> src = RandomBytes(MAX_TEXTURE_SIZE, 1);
+  const std::vector<u8> tlut = RandomBytes(TLUT_SIZE, 2);
+  std::vector<u32> decoded(256 * 256);
+
+  constexpr int iterations = 200;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+  {
+    TexDecoder_Decode(reinterpret_cast<u8*>(decoded.data()), src.data(), 256, 256, format,
+                      tlut.data(), tlut_format);
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  fmt::print("{} ({}): {:.1f} million texels/s\n", format, tlut_format,
+             iterations * 256 * 256 / elapsed.count() / 1e6);
+}
+
+INSTANTIATE_TEST_CASE_P(DirectFormats, TextureDecoderTest,
+                        ::testing::Combine(::testing::Values(TextureFormat::I4, TextureFormat::I8,
+                                                             TextureFormat::IA4, TextureFormat::IA8,
+                                                             TextureFormat::RGB565,
+                                                             TextureFormat::RGB5A3,
+                                                             TextureFormat::RGBA8,
+                                                             TextureFormat::CMPR),
+                                           ::testing::Values(TLUTFormat::IA8)));
+
+INSTANTIATE_TEST_CASE_P(PalettedFormats, TextureDecoderTest,
+                        ::testing::Combine(::testing::Values(TextureFormat::C4, TextureFormat::C8,
+                                                             TextureFormat::C14X2),
+                                           ::testing::Values(TLUTFormat::IA8, TLUTFormat::RGB565,
+                                                             TLUTFormat::RGB5A3)));
@@ -0,0 +1,119 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/TextureDiskCache.h"
+
+#include <gtest/gtest.h>
+
+class TextureDiskCacheTest : public testing::TestWithParam<bool>
+{
+protected:
+  TextureDiskCacheTest()
+      : m_directory(File::CreateTempDir()), m_filename(m_directory + "/textures.cache")
+  {
+  }
+
+  ~TextureDiskCacheTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  std::unique_ptr<TextureDiskCache> Open() const
+  {
+    return TextureDiskCache::Create(m_filename, GetParam());
+  }
+
+  static TextureDiskCache::Key MakeKey(u64 texture_hash)
+  {
+    return TextureDiskCache::MakeKey(texture_hash, 0, TextureFormat::CMPR, TLUTFormat::IA8, 64,
+                                     64, 1);
+  }
+
+  static std::vector<u8> MakeLevels(u8 seed)
+  {
+    // Compressible, so that both kinds of entries are tested.
+    std::vector<u8> levels(64 * 64 * 4);
+    for (size_t i = 0; i < levels.size(); i++)
+      levels[i] = static_cast<u8>(seed + i / 64);
+    return levels;
+  }
+
+  const std::string m_directory;
+  const std::string m_filename;
+};
+
+TEST_P(TextureDiskCacheTest, StoresAcrossSessions)
+{
+  const std::vector<u8> levels = MakeLevels(1);
+  const u32 size = static_cast<u32>(levels.size());
+  std::vector<u8> scratch(size);
+
+  auto cache = Open();
+  ASSERT_TRUE(cache);
+  EXPECT_EQ(nullptr, cache->Lookup(MakeKey(1), size, scratch.data()));
+  cache->Store(MakeKey(1), levels.data(), size);
+  // Entries are only read from the file the next time it is opened.
+  EXPECT_EQ(nullptr, cache->Lookup(MakeKey(1), size, scratch.data()));
+  cache.reset();
+
+  cache = Open();
+  ASSERT_TRUE(cache);
+  const u8* data = cache->Lookup(MakeKey(1), size, scratch.data());
+  ASSERT_NE(nullptr, data);
+  EXPECT_EQ(levels, std::vector<u8>(data, data + size));
+  EXPECT_EQ(nullptr, cache->Lookup(MakeKey(2), size, scratch.data()));
+  EXPECT_EQ(nullptr, cache->Lookup(MakeKey(1), size / 2, scratch.data()));
+}
+
+TEST_P(TextureDiskCacheTest, DiscardsIncompleteEntries)
+{
+  const std::vector<u8> first = MakeLevels(1);
+  const std::vector<u8> second = MakeLevels(2);
+  const u32 size = static_cast<u32>(first.size());
+  std::vector<u8> scratch(size);
+
+  auto cache = Open();
+  ASSERT_TRUE(cache);
+  cache->Store(MakeKey(1), first.data(), size);
+  cache.reset();
+
+  // Simulate an entry that was cut off when the emulator was closed.
+  {
+    File::IOFile file(m_filename, "ab");
+    const std::vector<u8> partial(100, 0xff);
+    ASSERT_TRUE(file.WriteBytes(partial.data(), partial.size()));
+  }
+
+  cache = Open();
+  ASSERT_TRUE(cache);
+  ASSERT_NE(nullptr, cache->Lookup(MakeKey(1), size, scratch.data()));
+  cache->Store(MakeKey(2), second.data(), size);
+  cache.reset();
+
+  cache = Open();
+  ASSERT_TRUE(cache);
+  const u8* data = cache->Lookup(MakeKey(1), size, scratch.data());
+  ASSERT_NE(nullptr, data);
+  EXPECT_EQ(first, std::vector<u8>(data, data + size));
+  data = cache->Lookup(MakeKey(2), size, scratch.data());
+  ASSERT_NE(nullptr, data);
+  EXPECT_EQ(second, std::vector<u8>(data, data + size));
+}
+
+INSTANTIATE_TEST_CASE_P(Compression, TextureDiskCacheTest, testing::Bool());
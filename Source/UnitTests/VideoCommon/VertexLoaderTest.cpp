@@ -364,3 +364,49 @@ TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
   for (int i = 0; i < 100; ++i)
     RunVertices(100000);
 }
+
+TEST_F(VertexLoaderTest, ConcurrentRunsLeaveZFreezeCaches)
+{
+  m_vtx_desc.low.PosMatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  CreateAndCheckSizes(1 + 3 * sizeof(float), sizeof(u32) + 3 * sizeof(float));
+  if (!m_loader->SupportsConcurrentRuns())
+    return;
+
+  for (int i = 0; i < 4; ++i)
+  {
+    Input<u8>(i + 1);
+    Input(i * 3.f);
+    Input(i * 3.f + 1);
+    Input(i * 3.f + 2);
+  }
+
+  memset(VertexLoaderManager::position_cache, 0, sizeof(VertexLoaderManager::position_cache));
+  memset(VertexLoaderManager::position_matrix_index, 0,
+         sizeof(VertexLoaderManager::position_matrix_index));
+  ResetPointers();
+  EXPECT_EQ(4, m_loader->RunConcurrentVertices(m_src, m_dst, 4));
+  for (int i = 0; i < 4; ++i)
+  {
+    EXPECT_EQ(static_cast<u32>(i + 1), (m_dst.Read<u32, false>()));
+    ExpectOut(i * 3.f);
+    ExpectOut(i * 3.f + 1);
+    ExpectOut(i * 3.f + 2);
+  }
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(0.f, VertexLoaderManager::position_cache[i][0]);
+    EXPECT_EQ(0u, VertexLoaderManager::position_matrix_index[i + 1]);
+  }
+
+  // A normal run stores the last three vertices, the last one first.
+  RunVertices(4);
+  for (int i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ((3 - i) * 3.f, VertexLoaderManager::position_cache[i][0]);
+    EXPECT_EQ((3 - i) * 3.f + 2, VertexLoaderManager::position_cache[i][2]);
+    EXPECT_EQ(static_cast<u32>(4 - i), VertexLoaderManager::position_matrix_index[i + 1]);
+  }
+}
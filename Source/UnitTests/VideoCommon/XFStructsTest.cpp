@@ -0,0 +1,119 @@
+// Copyright 2021 Dolphin Emulator Project
+// Licensed under GPLv2+
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Core/ConfigManager.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/FramebufferManager.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexManagerBase.h"
+#include "VideoCommon/XFMemory.h"
+
+#include <gtest/gtest.h>
+
+class XFStructsTest : public testing::Test
+{
+protected:
+  XFStructsTest() : m_profile_path(File::CreateTempDir()) {}
+
+  ~XFStructsTest() override
+  {
+    if (!m_profile_path.empty())
+      File::DeleteDirRecursively(m_profile_path);
+  }
+
+  void SetUp() override
+  {
+    ASSERT_FALSE(m_profile_path.empty());
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+
+    std::memset(static_cast<void*>(&xfmem), 0, sizeof(xfmem));
+    std::memset(static_cast<void*>(&bpmem), 0, sizeof(bpmem));
+    // Skips the z slope calculation on flushes, which needs a vertex format.
+    bpmem.genMode.zfreeze = 1;
+
+    g_framebuffer_manager = std::make_unique<FramebufferManager>();
+    g_vertex_manager = std::make_unique<VertexManagerBase>();
+    ASSERT_TRUE(g_vertex_manager->Initialize());
+  }
+
+  void TearDown() override
+  {
+    g_vertex_manager.reset();
+    g_framebuffer_manager.reset();
+    SConfig::Shutdown();
+    Config::Shutdown();
+  }
+
+  // Starts a batch of culled vertices, so that flushing it doesn't need a backend.
+  static void StartBatch()
+  {
+    g_vertex_manager->PrepareForAdditionalData(OpcodeDecoder::GX_DRAW_TRIANGLES, 3, 12, true);
+  }
+
+  static size_t GetFlushCount()
+  {
+    const auto statistics = g_vertex_manager->ResetFlushAspectRatioCount();
+    return statistics.perspective.GetTotalFlushCount() +
+           statistics.orthographic.GetTotalFlushCount();
+  }
+
+  static void LoadXF(u32 address, const std::vector<u32>& values)
+  {
+    std::vector<u8> data(values.size() * sizeof(u32));
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      const u32 value = Common::swap32(values[i]);
+      std::memcpy(&data[i * sizeof(u32)], &value, sizeof(u32));
+    }
+    LoadXFReg(static_cast<u32>(values.size()), address,
+              DataReader(data.data(), data.data() + data.size()));
+  }
+
+  const std::string m_profile_path;
+};
+
+TEST_F(XFStructsTest, MatrixLoads)
+{
+  StartBatch();
+  LoadXF(0, {1, 2, 3, 4});
+  EXPECT_EQ(1u, GetFlushCount());
+
+  // Loading the same values again doesn't split the batch.
+  StartBatch();
+  LoadXF(0, {1, 2, 3, 4});
+  EXPECT_EQ(0u, GetFlushCount());
+
+  LoadXF(2, {3, 5});
+  EXPECT_EQ(1u, GetFlushCount());
+}
+
+TEST_F(XFStructsTest, ProjectionWrites)
+{
+  const std::vector<u32> projection = {0x3f800000, 0, 0x3f800000, 0, 0xbf800000, 0xbf000000, 0};
+
+  StartBatch();
+  LoadXF(XFMEM_SETPROJECTION, projection);
+  EXPECT_EQ(1u, GetFlushCount());
+
+  StartBatch();
+  LoadXF(XFMEM_SETPROJECTION, projection);
+  EXPECT_EQ(0u, GetFlushCount());
+
+  // The projection type is part of the group.
+  LoadXF(XFMEM_SETPROJECTION + 6, {1});
+  EXPECT_EQ(1u, GetFlushCount());
+}